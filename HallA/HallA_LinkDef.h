@@ -17,6 +17,8 @@
 #pragma link C++ class THaVDCWire+;
 #pragma link C++ class VDC::TimeToDistConv+;
 #pragma link C++ class VDC::AnalyticTTDConv+;
+#pragma link C++ class VDC::TableTTDConv+;
+#pragma link C++ class VDC::OpticsMatrix+;
 #pragma link C++ class THaVDCPoint+;
 #pragma link C++ class THaVDCPointPair+;
 #pragma link C++ class THaVDCTrackID+;
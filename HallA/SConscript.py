@@ -14,10 +14,10 @@ THaADCHelicity.cxx         THaDecData.cxx              THaG0Helicity.cxx
 THaG0HelicityReader.cxx    THaHelicity.cxx             THaHRS.cxx
 THaQWEAKHelicity.cxx       THaQWEAKHelicityReader.cxx  THaS2CoincTime.cxx
 THaVDCAnalyticTTDConv.cxx  THaVDCChamber.cxx           THaVDCCluster.cxx
-THaVDC.cxx                 THaVDCHit.cxx               THaVDCPlane.cxx
-THaVDCPoint.cxx            THaVDCPointPair.cxx         THaVDCTimeToDistConv.cxx
-THaVDCTrackID.cxx          THaVDCWire.cxx              TrigBitLoc.cxx
-VDCeff.cxx
+THaVDC.cxx                 THaVDCHit.cxx               THaVDCOpticsMatrix.cxx
+THaVDCPlane.cxx            THaVDCPoint.cxx             THaVDCPointPair.cxx
+THaVDCTableTTDConv.cxx     THaVDCTimeToDistConv.cxx    THaVDCTrackID.cxx
+THaVDCWire.cxx             TrigBitLoc.cxx              VDCeff.cxx
 """
 
 build_library(baseenv, libname, src, useenv = False, versioned = True)
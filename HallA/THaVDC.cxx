@@ -31,7 +31,7 @@
 #include "TROOT.h"
 #include "THaString.h"
 
-//#include <algorithm>
+#include <algorithm>
 #include <map>
 #include <cstdio>
 #include <cstdlib>
@@ -79,8 +79,6 @@ THaVDC::THaVDC( const char* name, const char* description,
     MakeZombie();
   }
 
-  fLUpairs = new TClonesArray( "THaVDCPointPair", 20 );
-
   // Default behavior for now
   SetBit( kOnlyFastest | kHardTDCcut );
 }
@@ -430,6 +428,9 @@ Int_t THaVDC::ReadDatabase( const TDatime& date )
 
   CalcMatrix(1.,fLMatrixElems); // tensor without explicit polynomial in x_fp
 
+  if( (err = CompileMatrices()) != kOK )
+    return err;
+
   fIsInit = true;
   return kOK;
 }
@@ -441,7 +442,14 @@ THaVDC::~THaVDC()
 
   delete fLower;
   delete fUpper;
-  delete fLUpairs;
+}
+
+//_____________________________________________________________________________
+static Bool_t PairLess( const THaVDCPointPair* a, const THaVDCPointPair* b )
+{
+  // Order point pairs by ascending matching error
+
+  return a->GetError() < b->GetError();
 }
 
 //_____________________________________________________________________________
@@ -469,7 +477,8 @@ Int_t THaVDC::ConstructTracks( TClonesArray* tracks, Int_t mode )
 #endif
   UInt_t theStage = ( mode == 1 ) ? kCoarse : kFine;
 
-  fLUpairs->Clear();
+  fLUpairs.clear();
+  fArena.Reset();
 
   Int_t nUpper = fUpper->GetNPoints();
   Int_t nLower = fLower->GetNPoints();
@@ -512,8 +521,10 @@ Int_t THaVDC::ConstructTracks( TClonesArray* tracks, Int_t mode )
 	continue;
 
       // Create new point pair
-      THaVDCPointPair* thePair = new( (*fLUpairs)[nPairs++] )
+      THaVDCPointPair* thePair = new(fArena)
 	THaVDCPointPair( lowerPoint, upperPoint, fSpacing );
+      fLUpairs.push_back( thePair );
+      nPairs++;
 
       // Explicitly mark these points as unpartnered
       lowerPoint->SetPartner( 0 );
@@ -542,12 +553,13 @@ Int_t THaVDC::ConstructTracks( TClonesArray* tracks, Int_t mode )
 
   // Sort pairs in order of ascending matching error
   if( nPairs > 1 )
-    fLUpairs->Sort();
+    sort( fLUpairs.begin(), fLUpairs.end(), PairLess );
 
 #ifdef WITH_DEBUG
   if( fDebug>1 ) {
     cout << nPairs << " pairs.\n";
-    fLUpairs->Print();
+    for( int i = 0; i < nPairs; i++ )
+      fLUpairs[i]->Print();
   }
 #endif
 
@@ -556,7 +568,7 @@ Int_t THaVDC::ConstructTracks( TClonesArray* tracks, Int_t mode )
   // Mark pairs as partners, starting with the best matches,
   // until all tracks are marked.
   for( int i = 0; i < nPairs; i++ ) {
-    THaVDCPointPair* thePair = static_cast<THaVDCPointPair*>( fLUpairs->At(i) );
+    THaVDCPointPair* thePair = fLUpairs[i];
     assert( thePair );
     assert( thePair->GetError() < fErrorCutoff );
 
@@ -693,8 +705,7 @@ Int_t THaVDC::ConstructTracks( TClonesArray* tracks, Int_t mode )
 	  ((theTrack->GetFlag() & kStageMask) != theStage ) ) {
 	// First, release clusters pointing to this track
 	for( int j = 0; j < nPairs; j++ ) {
-	  THaVDCPointPair* thePair
-	    = static_cast<THaVDCPointPair*>( fLUpairs->At(i) );
+	  THaVDCPointPair* thePair = fLUpairs[j];
 	  assert(thePair);
 	  if( thePair->GetTrack() == theTrack ) {
 	    thePair->Associate(0);
@@ -741,6 +752,8 @@ void THaVDC::Clear( Option_t* opt )
   THaTrackingDetector::Clear(opt);
   fLower->Clear(opt);
   fUpper->Clear(opt);
+  fLUpairs.clear();
+  fArena.Reset();
 }
 
 //_____________________________________________________________________________
@@ -812,11 +825,7 @@ Int_t THaVDC::FindVertices( TClonesArray& tracks )
   // Calculate the target location and momentum at the target.
   // Assumes that CoarseTrack() and FineTrack() have both been called.
 
-  Int_t n_exist = tracks.GetLast()+1;
-  for( Int_t t = 0; t < n_exist; t++ ) {
-    THaTrack* theTrack = static_cast<THaTrack*>( tracks.At(t) );
-    CalcTargetCoords(theTrack);
-  }
+  CalcTargetCoords(tracks);
 
   return 0;
 }
@@ -891,17 +900,94 @@ void THaVDC::CalcFocalPlaneCoords( THaTrack* track )
 }
 
 //_____________________________________________________________________________
-void THaVDC::CalcTargetCoords( THaTrack* track )
+static const THaVDC::THaMatrixElement*
+CompileElements( const MEvec_t& elems, OpticsMatrix& mat, Bool_t with_x )
 {
-  // calculates target coordinates from focal plane coordinates
+  // Append the given matrix elements to the compiled matrix mat.
+  // If with_x is false, the element exponents refer to (th, y, ph, |th|)
+  // and the coefficients form a polynomial in x_fp. If with_x is true,
+  // the exponents refer to (x, th, y, ph), and the coefficients are summed
+  // (the polynomial is evaluated at x = 1, as for the path length tensor).
+  // Returns the first element that cannot be compiled (exponent out of
+  // range), or NULL if all elements were added.
+
+  for( MEvec_t::const_iterator it = elems.begin(); it != elems.end(); ++it ) {
+    if( it->iszero || it->order == 0 )
+      continue;
+    Int_t pw[OpticsMatrix::kNvar] = { 0, 0, 0, 0, 0 };
+    Int_t first = with_x ? OpticsMatrix::kX : OpticsMatrix::kTh;
+    for( vector<int>::size_type i = 0;
+	 i < it->pw.size() && first+i < OpticsMatrix::kNvar; ++i )
+      pw[first+i] = it->pw[i];
+    if( with_x ) {
+      Double_t c = 0.0;
+      for( Int_t i = 0; i < it->order; ++i )
+	c += it->poly[i];
+      if( mat.AddTerm( 1, &c, pw ) < 0 )
+	return &*it;
+    } else if( mat.AddTerm( it->order, &it->poly[0], pw ) < 0 )
+      return &*it;
+  }
+  return NULL;
+}
 
-  const Int_t kNUM_PRECOMP_POW = 10;
+//_____________________________________________________________________________
+Int_t THaVDC::CompileMatrices()
+{
+  // Compile the focal-plane to target matrix elements read from the database
+  // into flat tables for fast evaluation. The abs(theta) elements are merged
+  // into the corresponding y and phi matrices.
+  // Returns kInitError if any element cannot be compiled.
+
+  const char* const here = "CompileMatrices";
+
+  struct {
+    const char*    name;
+    const MEvec_t* elems;
+    Int_t          tgvar;
+    Bool_t         with_x;
+  } const compile_list[] = {
+    { "D",   &fDMatrixElems,   kTgDelta,   false },
+    { "T",   &fTMatrixElems,   kTgTheta,   false },
+    { "Y",   &fYMatrixElems,   kTgY,       false },
+    { "YTA", &fYTAMatrixElems, kTgY,       false },
+    { "P",   &fPMatrixElems,   kTgPhi,     false },
+    { "PTA", &fPTAMatrixElems, kTgPhi,     false },
+    { "L",   &fLMatrixElems,   kTgPathLen, true  },
+    { 0 }
+  };
 
-  Double_t x_fp, y_fp, th_fp, ph_fp;
-  Double_t powers[kNUM_PRECOMP_POW][5];  // {(x), th, y, ph, abs(th) }
-  Double_t x, y, theta, phi, dp, p, pathl;
+  for( Int_t i = 0; i < kNTgVar; ++i )
+    fTgMatrix[i].Clear();
+
+  Int_t err = kOK;
+  for( Int_t i = 0; compile_list[i].name; ++i ) {
+    const THaMatrixElement* bad =
+      CompileElements( *compile_list[i].elems,
+		       fTgMatrix[compile_list[i].tgvar],
+		       compile_list[i].with_x );
+    if( bad ) {
+      TString exps;
+      for( vector<int>::size_type k = 0; k < bad->pw.size(); ++k ) {
+	exps += " ";
+	exps += bad->pw[k];
+      }
+      Error( Here(here), "Matrix element %s%s: exponents must be between "
+	     "0 and %d. Fix database.", compile_list[i].name, exps.Data(),
+	     static_cast<Int_t>(OpticsMatrix::kMaxPow) );
+      err = kInitError;
+    }
+  }
+  return err;
+}
+
+//_____________________________________________________________________________
+void THaVDC::GetTargetInput( const THaTrack* track, Double_t& x_fp,
+			     Double_t& th_fp, Double_t& y_fp,
+			     Double_t& ph_fp ) const
+{
+  // Get the focal-plane coordinates used as input for the target matrices
 
-  // first select the coords to use
   if( fCoordType == kTransport ) {
     x_fp = track->GetX();
     y_fp = track->GetY();
@@ -913,50 +999,86 @@ void THaVDC::CalcTargetCoords( THaTrack* track )
     th_fp = track->GetRTheta();
     ph_fp = track->GetRPhi();
   }
+}
 
-  // calculate the powers we need
-  for(int i=0; i<kNUM_PRECOMP_POW; i++) {
-    powers[i][0] = pow(x_fp, i);
-    powers[i][1] = pow(th_fp, i);
-    powers[i][2] = pow(y_fp, i);
-    powers[i][3] = pow(ph_fp, i);
-    powers[i][4] = pow(TMath::Abs(th_fp),i);
-  }
-
-  // calculate the matrices we need
-  CalcMatrix(x_fp, fDMatrixElems);
-  CalcMatrix(x_fp, fTMatrixElems);
-  CalcMatrix(x_fp, fYMatrixElems);
-  CalcMatrix(x_fp, fYTAMatrixElems);
-  CalcMatrix(x_fp, fPMatrixElems);
-  CalcMatrix(x_fp, fPTAMatrixElems);
-
-  // calculate the coordinates at the target
-  theta = CalcTargetVar(fTMatrixElems, powers);
-  phi = CalcTargetVar(fPMatrixElems, powers)+CalcTargetVar(fPTAMatrixElems,powers);
-  y = CalcTargetVar(fYMatrixElems, powers)+CalcTargetVar(fYTAMatrixElems,powers);
+//_____________________________________________________________________________
+void THaVDC::SetTargetCoords( THaTrack* track, const Double_t* tgvar )
+{
+  // Save the target quantities tgvar[kNTgVar] with the track
 
   THaSpectrometer *app = static_cast<THaSpectrometer*>(GetApparatus());
-  // calculate momentum
-  dp = CalcTargetVar(fDMatrixElems, powers);
-  p  = app->GetPcentral() * (1.0+dp);
 
-  // pathlength matrix is for the Transport coord plane
-  pathl = CalcTarget2FPLen(fLMatrixElems, powers);
+  Double_t dp = tgvar[kTgDelta];
+  // calculate momentum
+  Double_t p  = app->GetPcentral() * (1.0+dp);
+  Double_t theta = tgvar[kTgTheta], phi = tgvar[kTgPhi];
 
   //FIXME: estimate x ??
-  x = 0.0;
+  Double_t x = 0.0;
 
   // Save the target quantities with the tracks
-  track->SetTarget(x, y, theta, phi);
+  track->SetTarget(x, tgvar[kTgY], theta, phi);
   track->SetDp(dp);
   track->SetMomentum(p);
-  track->SetPathLen(pathl);
+  // pathlength matrix is for the Transport coord plane
+  track->SetPathLen(tgvar[kTgPathLen]);
 
   app->TransportToLab( p, theta, phi, track->GetPvect() );
+}
 
+//_____________________________________________________________________________
+void THaVDC::CalcTargetCoords( THaTrack* track )
+{
+  // calculates target coordinates from focal plane coordinates
+
+  Double_t x_fp, y_fp, th_fp, ph_fp;
+  GetTargetInput( track, x_fp, th_fp, y_fp, ph_fp );
+
+  Double_t tgvar[kNTgVar];
+  for( Int_t i = 0; i < kNTgVar; ++i )
+    tgvar[i] = fTgMatrix[i].Eval( x_fp, th_fp, y_fp, ph_fp );
+
+  SetTargetCoords( track, tgvar );
 }
 
+//_____________________________________________________________________________
+void THaVDC::CalcTargetCoords( TClonesArray& tracks )
+{
+  // Calculate target coordinates for all tracks at once. Each compiled
+  // matrix is evaluated for all tracks in one call.
+
+  Int_t n = tracks.GetLast()+1;
+  if( n <= 0 )
+    return;
+  if( n == 1 ) {
+    CalcTargetCoords( static_cast<THaTrack*>(tracks.At(0)) );
+    return;
+  }
+
+  // Workspace layout: x, th, y, ph, then the kNTgVar results, n each
+  const Int_t nwork = 4+kNTgVar;
+  if( fTgWork.size() < static_cast<UInt_t>(nwork*n) )
+    fTgWork.resize(nwork*n);
+  Double_t* x  = &fTgWork[0];
+  Double_t* th = x+n;
+  Double_t* y  = th+n;
+  Double_t* ph = y+n;
+  Double_t* res = ph+n;
+
+  for( Int_t t = 0; t < n; ++t ) {
+    THaTrack* theTrack = static_cast<THaTrack*>( tracks.At(t) );
+    GetTargetInput( theTrack, x[t], th[t], y[t], ph[t] );
+  }
+  for( Int_t i = 0; i < kNTgVar; ++i )
+    fTgMatrix[i].Eval( n, x, th, y, ph, res+i*n );
+
+  for( Int_t t = 0; t < n; ++t ) {
+    Double_t tgvar[kNTgVar];
+    for( Int_t i = 0; i < kNTgVar; ++i )
+      tgvar[i] = res[i*n+t];
+    SetTargetCoords( static_cast<THaTrack*>(tracks.At(t)), tgvar );
+  }
+}
 
 //_____________________________________________________________________________
 void THaVDC::CalcMatrix( const Double_t x, vector<THaMatrixElement>& matrix )
@@ -977,49 +1099,6 @@ void THaVDC::CalcMatrix( const Double_t x, vector<THaMatrixElement>& matrix )
   }
 }
 
-//_____________________________________________________________________________
-Double_t THaVDC::CalcTargetVar(const vector<THaMatrixElement>& matrix,
-			       const Double_t powers[][5])
-{
-  // calculates the value of a variable at the target
-  // the x-dependence is already in the matrix, so only 1-3 (or np) used
-  Double_t retval=0.0;
-  Double_t v=0;
-  for( vector<THaMatrixElement>::const_iterator it=matrix.begin();
-       it!=matrix.end(); ++it )
-    if(it->v != 0.0) {
-      v = it->v;
-      unsigned int np = it->pw.size(); // generalize for extra matrix elems.
-      for (unsigned int i=0; i<np; ++i)
-	v *= powers[it->pw[i]][i+1];
-      retval += v;
-  //      retval += it->v * powers[it->pw[0]][1]
-  //		      * powers[it->pw[1]][2]
-  //		      * powers[it->pw[2]][3];
-    }
-
-  return retval;
-}
-
-//_____________________________________________________________________________
-Double_t THaVDC::CalcTarget2FPLen(const vector<THaMatrixElement>& matrix,
-				  const Double_t powers[][5])
-{
-  // calculates distance from the nominal target position (z=0)
-  // to the transport plane
-
-  Double_t retval=0.0;
-  for( vector<THaMatrixElement>::const_iterator it=matrix.begin();
-       it!=matrix.end(); ++it )
-    if(it->v != 0.0)
-      retval += it->v * powers[it->pw[0]][0]
-		      * powers[it->pw[1]][1]
-		      * powers[it->pw[2]][2]
-		      * powers[it->pw[3]][3];
-
-  return retval;
-}
-
 //_____________________________________________________________________________
 void THaVDC::CorrectTimeOfFlight(TClonesArray& tracks)
 {
@@ -8,12 +8,16 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "THaTrackingDetector.h"
+#include "THaVDCOpticsMatrix.h"
+#include "EventArena.h"
 #include <cassert>
+#include <vector>
 
 class THaVDCChamber;
 class THaTrack;
 class TClonesArray;
 class THaVDCPoint;
+class THaVDCPointPair;
 
 class THaVDC : public THaTrackingDetector {
 
@@ -67,6 +71,14 @@ public:
 
   enum { kPORDER = 7 };
 
+  // Target variables calculated from compiled optics matrices
+  enum ETgVar { kTgDelta = 0, kTgTheta, kTgY, kTgPhi, kTgPathLen, kNTgVar };
+
+  // Compiled optics matrix for the given target variable. May be modified,
+  // e.g. by optics optimization code, via SetCoefficients
+  VDC::OpticsMatrix* GetTargetMatrix( ETgVar i )
+  { assert( i>=0 && i<kNTgVar ); return &fTgMatrix[i]; }
+
   // Class for storing matrix element data
   class THaMatrixElement {
   public:
@@ -95,7 +107,8 @@ protected:
   THaVDCChamber* fUpper;    // Upper chamber
 
   // Event data
-  TClonesArray*  fLUpairs;  // Candidate pairs of lower/upper points
+  std::vector<THaVDCPointPair*> fLUpairs; //! Candidate pairs of lower/upper points
+  Podd::EventArena fArena;  //! Storage for fLUpairs
   Int_t    fNtracks;        // Number of tracks found in ConstructTracks
   UInt_t   fEvNum;          // Event number from decoder (for diagnostics)
 
@@ -128,17 +141,22 @@ protected:
 
   std::vector<THaMatrixElement> fLMatrixElems;   // Path-length corrections (meters)
 
+  // Focal-plane to target matrices compiled from the above at initialization
+  VDC::OpticsMatrix fTgMatrix[kNTgVar];
+  std::vector<Double_t> fTgWork;  //! Workspace for batch target calculation
+
   void CalcFocalPlaneCoords( THaTrack* track );
   void CalcTargetCoords(THaTrack *the_track );
+  void CalcTargetCoords( TClonesArray& tracks );
   void CalcMatrix(const double x, std::vector<THaMatrixElement> &matrix);
+  Int_t CompileMatrices();
+  void GetTargetInput( const THaTrack* track, Double_t& x, Double_t& th,
+		       Double_t& y, Double_t& ph ) const;
+  void SetTargetCoords( THaTrack* track, const Double_t* tgvar );
   Double_t DoPoly(const int n, const std::vector<double> &a, const double x);
   Double_t PolyInv(const double x1, const double x2, const double xacc,
 		 const double y, const int norder,
 		 const std::vector<double> &a);
-  Double_t CalcTargetVar(const std::vector<THaMatrixElement> &matrix,
-			 const double powers[][5]);
-  Double_t CalcTarget2FPLen(const std::vector<THaMatrixElement>& matrix,
-			    const Double_t powers[][5]);
   Int_t ReadDatabase( const TDatime& date );
 
   virtual Int_t ConstructTracks( TClonesArray* tracks = NULL, Int_t flag = 0 );
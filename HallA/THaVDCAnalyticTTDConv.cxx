@@ -24,6 +24,35 @@ AnalyticTTDConv::AnalyticTTDConv() : TimeToDistConv(9), fdtime(0)
   }
 }
 
+//_____________________________________________________________________________
+void AnalyticTTDConv::CalcCorrections( Double_t tanTheta,
+				       Double_t& a1, Double_t& a2 ) const
+{
+  // Find the values of a1 and a2 by evaluating the proper polynomials
+  // a = A_3 * x^3 + A_2 * x^2 + A_1 * x + A_0
+
+  a1 = a2 = 0.0;
+
+  tanTheta = 1.0 / tanTheta;
+
+  for (Int_t i = 3; i >= 1; i--) {
+    a1 = tanTheta * (a1 + fA1tdcCor[i]);
+    a2 = tanTheta * (a2 + fA2tdcCor[i]);
+  }
+  a1 += fA1tdcCor[0];
+  a2 += fA2tdcCor[0];
+}
+
+//_____________________________________________________________________________
+void AnalyticTTDConv::GetCorrections( Double_t tanTheta,
+				      Double_t& a1, Double_t& a2 ) const
+{
+  // Get the correction parameters a1 and a2 for the given track slope.
+  // Derived classes may override this to use a faster approximation.
+
+  CalcCorrections( tanTheta, a1, a2 );
+}
+
 //_____________________________________________________________________________
 Double_t AnalyticTTDConv::ConvertTimeToDist( Double_t time, Double_t tanTheta,
 					     Double_t* ddist) const
@@ -35,23 +64,14 @@ Double_t AnalyticTTDConv::ConvertTimeToDist( Double_t time, Double_t tanTheta,
   if( !fIsSet ) {
     Error( "VDC::AnalyticTTDConv::ConvertTimeToDist", "Parameters not set. "
 	   "Fix database." );
+    if( ddist ) *ddist = kBig;
     return kBig;
   }
 
 //    printf("Converting Drift Time to Drift Distance!\n");
 
-  // Find the values of a1 and a2 by evaluating the proper polynomials
-  // a = A_3 * x^3 + A_2 * x^2 + A_1 * x + A_0
-  Double_t a1 = 0.0, a2 = 0.0;
-
-  tanTheta = 1.0 / tanTheta;
-
-  for (Int_t i = 3; i >= 1; i--) {
-    a1 = tanTheta * (a1 + fA1tdcCor[i]);
-    a2 = tanTheta * (a2 + fA2tdcCor[i]);
-  }
-  a1 += fA1tdcCor[0];
-  a2 += fA2tdcCor[0];
+  Double_t a1, a2;
+  GetCorrections( tanTheta, a1, a2 );
 
   Double_t dist = fDriftVel * time;
   Double_t unc  = fDriftVel * fdtime;  // watch uncertainty in the timing
@@ -70,6 +90,45 @@ Double_t AnalyticTTDConv::ConvertTimeToDist( Double_t time, Double_t tanTheta,
   return dist;
 }
 
+//_____________________________________________________________________________
+void AnalyticTTDConv::ConvertTimesToDist( UInt_t n, const Double_t* time,
+					  Double_t tanTheta, Double_t* dist,
+					  Double_t* ddist ) const
+{
+  // Convert n drift times that share the same track slope, tanTheta.
+  // The slope-dependent corrections are evaluated only once, and the
+  // per-time loop is free of function calls, so the compiler can
+  // vectorize it. Results are identical to ConvertTimeToDist.
+
+  if( !fIsSet ) {
+    Error( "VDC::AnalyticTTDConv::ConvertTimesToDist", "Parameters not set. "
+	   "Fix database." );
+    for( UInt_t i = 0; i < n; ++i )
+      dist[i] = kBig;
+    if( ddist ) {
+      for( UInt_t i = 0; i < n; ++i )
+	ddist[i] = kBig;
+    }
+    return;
+  }
+
+  Double_t a1, a2;
+  GetCorrections( tanTheta, a1, a2 );
+
+  const Double_t fac = 1.0 + a2 / a1;
+  const Double_t unc = fDriftVel * fdtime;
+  for( UInt_t i = 0; i < n; ++i ) {
+    Double_t d = fDriftVel * time[i];
+    dist[i] = ( d < 0 ) ? d : ( (d < a1) ? d * fac : d + a2 );
+  }
+  if( ddist ) {
+    for( UInt_t i = 0; i < n; ++i ) {
+      Double_t d = fDriftVel * time[i];
+      ddist[i] = ( d >= 0 && d < a1 ) ? unc * fac : unc;
+    }
+  }
+}
+
 //_____________________________________________________________________________
 Double_t AnalyticTTDConv::GetParameter( UInt_t i ) const
 {
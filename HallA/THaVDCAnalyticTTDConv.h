@@ -21,11 +21,20 @@ namespace VDC {
 
     virtual Double_t ConvertTimeToDist( Double_t time, Double_t tanTheta,
 				        Double_t* ddist=0 ) const;
+    virtual void     ConvertTimesToDist( UInt_t n, const Double_t* time,
+					 Double_t tanTheta, Double_t* dist,
+					 Double_t* ddist=0 ) const;
     virtual Double_t GetParameter( UInt_t i ) const;
     virtual Int_t    SetParameters( const std::vector<double>& param );
 
 protected:
 
+    // Slope-dependent correction parameters a1 and a2
+    virtual void     GetCorrections( Double_t tanTheta,
+				     Double_t& a1, Double_t& a2 ) const;
+    void             CalcCorrections( Double_t tanTheta,
+				      Double_t& a1, Double_t& a2 ) const;
+
     // Coefficients for a polynomial yielding correction parameters
     Double_t fA1tdcCor[4];
     Double_t fA2tdcCor[4];
@@ -11,8 +11,10 @@
 #include "THaVDCHit.h"
 #include "THaVDCPlane.h"
 #include "THaTrack.h"
+#include "THaVDCTimeToDistConv.h"
 #include "TMath.h"
 #include "TClass.h"
+#include "MethodVar.h"
 
 #include <iostream>
 
@@ -22,6 +24,15 @@ using namespace std;
 const Double_t VDC::kBig = 1e38;  // Arbitrary large value
 static const Int_t kDefaultNHit = 16;
 
+//_____________________________________________________________________________
+static const Podd::MethodAccessorDef accessors[] = {
+  PODD_METHOD_ACCESSOR( THaVDCCluster, Int_t, GetSize         ),
+  PODD_METHOD_ACCESSOR( THaVDCCluster, Int_t, GetPivotWireNum ),
+  PODD_METHOD_ACCESSOR( THaVDCCluster, Int_t, GetTrackIndex   ),
+  { 0 }
+};
+PODD_REGISTER_ACCESSORS( accessors );
+
 //_____________________________________________________________________________
 THaVDCCluster::THaVDCCluster( THaVDCPlane* owner )
   : fPlane(owner), fPointPair(0), fTrack(0), fTrkNum(0),
@@ -33,7 +44,6 @@ THaVDCCluster::THaVDCCluster( THaVDCPlane* owner )
   // Constructor
 
   fHits.reserve(kDefaultNHit);
-  fCoord.reserve(kDefaultNHit);
 }
 
 //_____________________________________________________________________________
@@ -58,6 +68,7 @@ void THaVDCCluster::Clear( Option_t* )
   ClearFit();
   fHits.clear();
   fPivot   = 0;
+  fTimeCorrection = 0;
   fPlane   = 0;
   fPointPair = 0;
   fTrack   = 0;
@@ -146,9 +157,36 @@ void THaVDCCluster::ConvertTimeToDist()
 {
   // Convert TDC Times in wires to drift distances
 
-  //Do conversion for each hit in cluster
-  for (int i = 0; i < GetSize(); i++)
-    fHits[i]->ConvertTimeToDist(fSlope);
+  // All wires of a plane share the plane's converter. Convert all hits
+  // of the cluster in one call so that the slope-dependent part of the
+  // conversion is evaluated only once.
+  const TimeToDistConv* ttdConv = fPlane ? fPlane->GetTTDConv() : 0;
+  if( !ttdConv ) {
+    //Do conversion for each hit in cluster
+    for (int i = 0; i < GetSize(); i++)
+      fHits[i]->ConvertTimeToDist(fSlope);
+    return;
+  }
+
+  const Int_t n = GetSize();
+  Double_t buf[3*kDefaultNHit];
+  vector<Double_t> vbuf;
+  Double_t* time = buf;
+  if( n > kDefaultNHit ) {
+    vbuf.resize(3*n);
+    time = &vbuf[0];
+  }
+  Double_t* dist  = time + n;
+  Double_t* ddist = dist + n;
+  for( Int_t i = 0; i < n; ++i )
+    time[i] = fHits[i]->GetTime();
+
+  ttdConv->ConvertTimesToDist( n, time, fSlope, dist, ddist );
+
+  for( Int_t i = 0; i < n; ++i ) {
+    fHits[i]->SetDist( dist[i] );
+    fHits[i]->SetdDist( ddist[i] );
+  }
 }
 
 //_____________________________________________________________________________
@@ -220,22 +258,70 @@ void THaVDCCluster::FitTrack( EMode mode )
   // kWeighted:  Linear fit with weights, ignore t0
   // kT0:        Fit t0, but ignore mulithits
 
+  if( fCoord.size() < static_cast<UInt_t>(GetSize()) )
+    fCoord.resize( TMath::Max(GetSize(),kDefaultNHit), FitCoord_t(0,0) );
+  // Without hits, nothing is read from or written to coord
+  FitCoord_t* coord = fCoord.empty() ? 0 : &fCoord[0];
+  FillFitCoord( coord, mode );
+  FitTrack( coord, mode );
+}
+
+//_____________________________________________________________________________
+Int_t THaVDCCluster::FillFitCoord( FitCoord_t* coord, EMode mode ) const
+{
+  // Copy the hit data needed by the fit of the given mode into coord.
+  // Returns the number of elements written, i.e. GetSize().
+  //
+  // For kSimple and kWeighted, the coordinates are stored in hit order.
+  // For kT0, the first element always corresponds to the wire with the
+  // smallest position.
+  //
+  // X = wire position, Y = drift distance (corrected by fTimeCorrection),
+  // W = weight (1 for kSimple, sigma^-2 otherwise; -1 = ignore hit)
+
+  const Int_t n = GetSize();
+  const bool weighted = ( mode != kSimple );
+  const bool reversed = ( mode == kT0 && fPlane && fPlane->GetWSpac() < 0 );
+  for( Int_t i = 0; i < n; ++i ) {
+    const THaVDCHit* hit = fHits[ reversed ? n-1-i : i ];
+    Double_t w = 1.0;
+    if( weighted ) {
+      w = hit->GetdDist();
+      // the hit will be ignored if the uncertainty is <= 0
+      if( w>0 )
+	w = 1./(w*w); // sigma^-2 is the weight
+      else
+	w = -1.;
+    }
+    FitCoord_t& c = coord[i];
+    c.x = hit->GetPos();
+    c.y = hit->GetDist() + fTimeCorrection;
+    c.w = w;
+    c.s = 1;
+  }
+  return n;
+}
+
+//_____________________________________________________________________________
+void THaVDCCluster::FitTrack( FitCoord_t* coord, EMode mode )
+{
+  // Fit track using coordinates previously filled by FillFitCoord with
+  // the same mode. The contents of coord are modified.
+
   switch( mode ) {
   case kSimple:
-    FitSimpleTrack(false);
-    break;
   case kWeighted:
-    FitSimpleTrack(true);
+    FitSimpleTrack( coord );
     break;
   case kT0:
-    LinearClusterFitWithT0();
+    LinearClusterFitWithT0( coord );
     break;
   }
   CalcLocalDist();
 }
 
 //_____________________________________________________________________________
-void THaVDCCluster::FitSimpleTrack( Bool_t weighted )
+void THaVDCCluster::FitSimpleTrack( FitCoord_t* coord )
 {
   // Perform linear fit on drift times. Calculates slope, intercept, and errors.
   // Does not assume the uncertainty is the same for all hits.
@@ -247,7 +333,8 @@ void THaVDCCluster::FitSimpleTrack( Bool_t weighted )
   //   Y = Position of Wires
 
   fFitOK = false;
-  if( GetSize() < 3 ) {
+  const Int_t n = GetSize();
+  if( n < 3 ) {
     return;  // Too few hits to get meaningful results
 	     // Do keep current values of slope and intercept
   }
@@ -255,92 +342,67 @@ void THaVDCCluster::FitSimpleTrack( Bool_t weighted )
   Double_t m, sigmaM;  // Slope, St. Dev. in slope
   Double_t b, sigmaB;  // Intercept, St. Dev in Intercept
 
-  fCoord.clear();
-
   Double_t bestFit = 0.0;
 
-  // Find the index of the pivot wire and copy distances into local arrays
+  // Find the index of the pivot wire.
   // Note that as the index of the hits is increasing, the position of the
-  // wires is decreasing
-
+  // wires is decreasing.
+  //
+  // In order to take into account the varying uncertainty in the
+  // drift distance, we will be working with the X' and Y', and
+  //       Y' = F + G X'
+  //  where Y' = X, and X' = Y  (swapping it around)
   Int_t pivotNum = 0;
-  for (int i = 0; i < GetSize(); i++) {
-
-    // In order to take into account the varying uncertainty in the
-    // drift distance, we will be working with the X' and Y', and
-    //       Y' = F + G X'
-    //  where Y' = X, and X' = Y  (swapping it around)
-    if (fHits[i] == fPivot) {
+  for( Int_t i = 0; i < n; ++i ) {
+    if( fHits[i] == fPivot ) {
       pivotNum = i;
+      break;
     }
+  }
 
-    Double_t x = fHits[i]->GetPos();
-    Double_t y = fHits[i]->GetDist() + fTimeCorrection;
-    Double_t w;
-    if( weighted ) {
-      w = fHits[i]->GetdDist();
-      // the hit will be ignored if the uncertainty is < 0
-      if (w>0)
-	w = 1./(w*w); // sigma^-2 is the weight
-      else
-	w = -1.;
-    } else {
-      w = 1.0;
-    }
-    fCoord.push_back( FitCoord_t(x,y,w) );
+  // First sign combination: negative drift distances past the pivot
+  for( Int_t j = pivotNum+1; j < n; ++j )
+    coord[j].y *= -1;
+
+  // Accumulate the sums once. Only the pivot's sign differs between the two
+  // sign combinations, so the second set of sums follows by correcting
+  // for the pivot alone.
+  FitSums_t sum;
+  for( Int_t j = 0; j < n; ++j ) {
+    const Double_t x = coord[j].x;   // Position of wire
+    const Double_t y = coord[j].y;   // Distance to wire
+    const Double_t w = coord[j].w;
+
+    if (w <= 0) continue;
+    sum.W  += w;
+    sum.X  += x * w;
+    sum.XX += x * x * w;
+    sum.D  += y * w;
+    sum.XD += x * y * w;
   }
 
+  // Standard formulae for linear regression (see Bevington)
+  const Double_t Delta = sum.W * sum.XX - sum.X * sum.X;
+  const Double_t sigmaF2 = ( sum.XX / Delta );
+  const Double_t sigmaG2 = ( sum.W / Delta );
+  const Double_t sigmaFG = ( -sum.X / Delta );
+
   const Int_t nSignCombos = 2; //Number of different sign combinations
   for (int i = 0; i < nSignCombos; i++) {
-    Double_t F, sigmaF2;  // intermediate slope and St. Dev.**2
-    Double_t G, sigmaG2;  // intermediate intercept and St. Dev.**2
-    Double_t sigmaFG;     // correlated uncertainty
-
-    Double_t sumX  = 0.0;   //Positions
-    Double_t sumXW = 0.0;
-    Double_t sumXX = 0.0;
-    Double_t sumY  = 0.0;   //Drift distances
-    Double_t sumXY = 0.0;
-    Double_t sumYY = 0.0;
-    Double_t sumXXW= 0.0;
-
-    Double_t W = 0.0;
-    Double_t WW= 0.0;
-
-    if (i == 0)
-      for (int j = pivotNum+1; j < GetSize(); j++)
-	fCoord[j].y *= -1;
-    else if (i == 1)
-      fCoord[pivotNum].y *= -1;
-
-    for (int j = 0; j < GetSize(); j++) {
-      Double_t x = fCoord[j].x;   // Position of wire
-      Double_t y = fCoord[j].y;   // Distance to wire
-      Double_t w = fCoord[j].w;
-
-      if (w <= 0) continue;
-      W     += w;
-      WW    += w*w;
-      sumX  += x * w;
-      sumXW += x * w * w;
-      sumXX += x * x * w;
-      sumXXW+= x * x * w * w;
-      sumY  += y * w;
-      sumXY += x * y * w;
-      sumYY += y * y * w;
+    if( i == 1 ) {
+      FitCoord_t& p = coord[pivotNum];
+      if( p.w > 0 ) {
+	sum.D  -= 2 * p.y * p.w;
+	sum.XD -= 2 * p.x * p.y * p.w;
+      }
+      p.y *= -1;
     }
 
-    // Standard formulae for linear regression (see Bevington)
-    Double_t Delta = W * sumXX - sumX * sumX;
-
-    F  = (sumXX * sumY - sumX * sumXY) / Delta;
-    G  = (W * sumXY - sumX * sumY) / Delta;
-    sigmaF2 = ( sumXX / Delta );
-    sigmaG2 = ( W / Delta );
-    sigmaFG = ( -sumX / Delta );
+    Double_t F  = (sum.XX * sum.D - sum.X * sum.XD) / Delta; // intermediate slope
+    Double_t G  = (sum.W * sum.XD - sum.X * sum.D) / Delta;  // intermediate intercept
 
     // calculate chi2 for the track given this slope and intercept
-    chi2_t chi2 = CalcChisquare( G, F, 0 );
+    chi2_t chi2 = CalcChisquare( coord, G, F, 0 );
 
     m  =   1/G;
     b  = - F/G;
@@ -371,7 +433,7 @@ void THaVDCCluster::FitSimpleTrack( Bool_t weighted )
 }
 
 //_____________________________________________________________________________
-Int_t THaVDCCluster::LinearClusterFitWithT0()
+Int_t THaVDCCluster::LinearClusterFitWithT0( FitCoord_t* coord )
 {
   // Perform linear fit on drift times. Calculates slope, intercept, time
   // offset t0, and errors.
@@ -395,10 +457,13 @@ Int_t THaVDCCluster::LinearClusterFitWithT0()
   // of the cluster geometery, where slope = 1/m and intercept = -b/m.
   // d0 is simply converted to time units to give t0, using the asymptotic
   // drift velocity.
+  //
+  // The coordinates must be sorted by increasing x (see FillFitCoord).
 
 
   fFitOK = false;
-  if( GetSize() < 4 || !fPlane ) {
+  const Int_t n = GetSize();
+  if( n < 4 || !fPlane ) {
     return -1;  // Too few hits to get meaningful results
 		// Do keep current values of slope and intercept
   }
@@ -409,36 +474,6 @@ Int_t THaVDCCluster::LinearClusterFitWithT0()
 
   sigmaM = sigmaB = sigmaD0 = 0;
 
-  fCoord.clear();
-
-  //--- Copy hit data into local arrays
-  Int_t ihit, incr, ilast = GetSize()-1;
-  // Ensure that the first element of the local arrays always corresponds
-  // to the wire with the smallest x position
-  bool reversed = ( fPlane->GetWSpac() < 0 );
-  if( reversed ) {
-    ihit = ilast;
-    incr = -1;
-  } else {
-    ihit = 0;
-    incr = 1;
-  }
-  for( Int_t i = 0; i < GetSize(); ihit += incr, ++i ) {
-    assert( ihit >= 0 && ihit < GetSize() );
-    Double_t x = fHits[ihit]->GetPos();
-    Double_t y = fHits[ihit]->GetDist() + fTimeCorrection;
-
-    Double_t wt = fHits[ihit]->GetdDist();
-    if( wt>0 )   // the hit will be ignored if the uncertainty is <= 0
-      wt = 1./(wt*wt);
-    else
-      wt = -1.;
-
-    fCoord.push_back( FitCoord_t(x,y,wt) );
-
-    assert( i == 0 || fCoord[i-1].x < fCoord[i].x );
-  }
-
   Double_t bestFit = 0.0;
 
   //--- Perform 3-parameter for different sign coefficients
@@ -447,20 +482,54 @@ Int_t THaVDCCluster::LinearClusterFitWithT0()
   // - The first wire of the cluster always has negative drift distance.
   // - The last wire always has positive drift.
   // - The sign flips exactly once from - to + somewhere in between
-  fCoord[0].s = -1;
-  for( Int_t i = 1; i < GetSize(); ++i )
-    fCoord[i].s = 1;
+  coord[0].s = -1;
+  for( Int_t i = 1; i < n; ++i )
+    coord[i].s = 1;
+
+  // Accumulate the sums for the first sign combination. Each following
+  // combination flips exactly one sign, so the sign-dependent sums can be
+  // updated from that single element instead of being recomputed.
+  FitSums_t sum;
+  for( Int_t j = 0; j < n; ++j ) {
+    assert( j == 0 || coord[j-1].x < coord[j].x );
+    const Double_t x = coord[j].x;   // Position of wire
+    const Double_t d = coord[j].y;   // Distance to wire
+    const Double_t w = coord[j].w;   // Weight/error of distance measurement
+    const Int_t    s = coord[j].s;   // Sign of distance
+
+    if (w <= 0) continue;
 
+    sum.X   += x * w;
+    sum.XX  += x * x * w;
+    sum.D   += d * w;
+    sum.XD  += x * d * w;
+    sum.S   += s * w;
+    sum.SX  += s * x * w;
+    sum.SD  += s * d * w;
+    sum.SDX += s * d * x * w;
+    sum.W   += w;
+  }
+
+  const Int_t ilast = n-1;
   for( Int_t ipivot = 0; ipivot < ilast; ++ipivot ) {
-    if( ipivot != 0 )
-      fCoord[ipivot].s *= -1;
+    if( ipivot != 0 ) {
+      FitCoord_t& c = coord[ipivot];
+      c.s *= -1;
+      if( c.w > 0 ) {
+	// Sign changed from +1 to -1
+	sum.S   -= 2 * c.w;
+	sum.SX  -= 2 * c.x * c.w;
+	sum.SD  -= 2 * c.y * c.w;
+	sum.SDX -= 2 * c.y * c.x * c.w;
+      }
+    }
 
     // Do the fit
-    Linear3DFit( m, b, d0 );
+    Linear3DFit( sum, m, b, d0 );
 
     // calculate chi2 for the track given this slope,
     // intercept, and distance offset
-    chi2_t chi2 = CalcChisquare( m, b, d0 );
+    chi2_t chi2 = CalcChisquare( coord, m, b, d0 );
 
     // scale the uncertainty of the fit parameters based upon the
     // quality of the fit. This really should not be necessary if
@@ -493,88 +562,31 @@ Int_t THaVDCCluster::LinearClusterFitWithT0()
 }
 
 //_____________________________________________________________________________
-void THaVDCCluster::Linear3DFit( Double_t& m, Double_t& b, Double_t& d0 ) const
+void THaVDCCluster::Linear3DFit( const FitSums_t& sum,
+				 Double_t& m, Double_t& b, Double_t& d0 ) const
 {
-  // 3-parameter fit
-//     Double_t F, sigmaF2;  // intermediate slope and St. Dev.**2
-//     Double_t G, sigmaG2;  // intermediate intercept and St. Dev.**2
-//     Double_t sigmaFG;     // correlated uncertainty
-
-  Double_t sumX   = 0.0;   //Positions
-  Double_t sumXX  = 0.0;
-  Double_t sumD   = 0.0;   //Drift distances
-  Double_t sumXD  = 0.0;
-  Double_t sumS   = 0.0;   //sign vector
-  Double_t sumSX  = 0.0;
-  Double_t sumSD  = 0.0;
-  Double_t sumSDX = 0.0;
-
-  //     Double_t sumXW = 0.0;
-  //     Double_t sumXXW= 0.0;
-
-  Double_t sumW  = 0.0;
-  //     Double_t sumWW = 0.0;
-  //     Double_t sumDD = 0.0;
-
-
-  for (int j = 0; j < GetSize(); j++) {
-    Double_t x = fCoord[j].x;   // Position of wire
-    Double_t d = fCoord[j].y;   // Distance to wire
-    Double_t w = fCoord[j].w;   // Weight/error of distance measurement
-    Int_t    s = fCoord[j].s;   // Sign of distance
-
-    if (w <= 0) continue;
-
-    sumX   += x * w;
-    sumXX  += x * x * w;
-    sumD   += d * w;
-    sumXD  += x * d * w;
-    sumS   += s * w;
-    sumSX  += s * x * w;
-    sumSD  += s * d * w;
-    sumSDX += s * d * x * w;
-    sumW   += w;
-    //       sumWW  += w*w;
-    //       sumXW  += x * w * w;
-    //       sumXXW += x * x * w * w;
-    //       sumDD  += d * d * w;
-  }
+  // 3-parameter fit, given the precomputed weighted sums
 
   // Standard formulae for linear regression (see Bevington)
   Double_t Delta =
-    sumXX   * ( sumW  * sumW - sumW * sumS  ) -
-    sumX    * ( sumX  * sumW - sumX * sumS  );
+    sum.XX  * ( sum.W  * sum.W - sum.W * sum.S  ) -
+    sum.X   * ( sum.X  * sum.W - sum.X * sum.S  );
 
   m =
-    sumSDX  * ( sumW  * sumW - sumW * sumS  ) -
-    sumSD   * ( sumX  * sumW - sumW * sumSX ) +
-    sumD    * ( sumX  * sumS - sumW * sumSX );
+    sum.SDX * ( sum.W  * sum.W - sum.W * sum.S  ) -
+    sum.SD  * ( sum.X  * sum.W - sum.W * sum.SX ) +
+    sum.D   * ( sum.X  * sum.S - sum.W * sum.SX );
 
   b =
-    -sumSDX * ( sumX  * sumW - sumX * sumS  ) +
-    sumSD   * ( sumXX * sumW - sumX * sumSX ) -
-    sumD    * ( sumXX * sumS - sumX - sumSX );
+    -sum.SDX * ( sum.X  * sum.W - sum.X * sum.S  ) +
+    sum.SD   * ( sum.XX * sum.W - sum.X * sum.SX ) -
+    sum.D    * ( sum.XX * sum.S - sum.X - sum.SX );
 
-  d0 = ( sumD - sumSD ) * ( sumXX * sumW - sumX * sumX );
+  d0 = ( sum.D - sum.SD ) * ( sum.XX * sum.W - sum.X * sum.X );
 
   m  /= Delta;
   b  /= Delta;
   d0 /= Delta;
-
-
-  //     F  = (sumXX * sumD - sumX * sumXD) / Delta;
-  //     G  = (sumW * sumXD - sumX * sumD) / Delta;
-  //     sigmaF2 = ( sumXX / Delta );
-  //     sigmaG2 = ( sumW / Delta );
-  //     sigmaFG = ( sumXW * sumW * sumXX - sumXXW * sumW * sumX
-  //		- sumWW * sumX * sumXX + sumXW * sumX * sumX ) / (Delta*Delta);
-
-  //     m  =   1/G;
-  //     b  = - F/G;
-
-  //     sigmaM = m * m * TMath::Sqrt( sigmaG2 );
-  //     sigmaB = TMath::Sqrt( sigmaF2/(G*G) + F*F/(G*G*G*G)*sigmaG2 - 2*F/(G*G*G)*sigmaFG);
-
 }
 
 //_____________________________________________________________________________
@@ -608,16 +620,16 @@ void THaVDCCluster::SetTrack( THaTrack* track )
 }
 
 //_____________________________________________________________________________
-chi2_t THaVDCCluster::CalcChisquare( Double_t slope, Double_t icpt,
-				     Double_t d0 ) const
+chi2_t THaVDCCluster::CalcChisquare( const FitCoord_t* coord, Double_t slope,
+				     Double_t icpt, Double_t d0 ) const
 {
   Int_t npt = 0;
   Double_t chi2 = 0;
   for( int j = 0; j < GetSize(); ++j ) {
-    Double_t x  = fCoord[j].x;
-    Double_t y  = fCoord[j].s * fCoord[j].y;
-    Double_t w  = fCoord[j].w;
-    Double_t yp = x*slope + icpt + d0*fCoord[j].s;
+    Double_t x  = coord[j].x;
+    Double_t y  = coord[j].s * coord[j].y;
+    Double_t w  = coord[j].w;
+    Double_t yp = x*slope + icpt + d0*coord[j].s;
     if( w < 0 ) continue;
     Double_t d  = y-yp;
     chi2       += d*d*w;
@@ -23,6 +23,13 @@ namespace VDC {
     Double_t x, y, w;
     Int_t s;
   };
+  // Weighted sums for the linear fits. The first group does not depend on
+  // the drift distance signs, the second (S*) does
+  struct FitSums_t {
+    FitSums_t() : W(0), X(0), XX(0), D(0), XD(0), S(0), SX(0), SD(0), SDX(0) {}
+    Double_t W, X, XX, D, XD;
+    Double_t S, SX, SD, SDX;
+  };
   typedef std::pair<Double_t,Int_t>  chi2_t;
   typedef THaVDCPointPair VDCpp_t;
   typedef std::vector<THaVDCHit*> Vhit_t;
@@ -50,6 +57,10 @@ public:
   virtual void   EstTrackParameters();
   virtual void   ConvertTimeToDist();
   virtual void   FitTrack( EMode mode = kSimple );
+  // Batched fitting from externally provided workspace (see
+  // THaVDCPlane::FitTracks). coord must hold at least GetSize() elements.
+  Int_t          FillFitCoord( VDC::FitCoord_t* coord, EMode mode ) const;
+  void           FitTrack( VDC::FitCoord_t* coord, EMode mode );
   virtual void   ClearFit();
   virtual void   CalcChisquare(Double_t& chi2, Int_t& nhits) const;
   VDC::chi2_t    CalcDist();    // calculate global track to wire distances
@@ -114,19 +125,21 @@ protected:
   Int_t          fClsBeg;	     // Starting wire number
   Int_t          fClsEnd;            // Ending wire number
 
-  // Workspace for fitting routines
+  // Workspace for fitting routines, used when fitting standalone clusters
   VDC::Vcoord_t  fCoord;             // coordinates to be fit
 
   void   CalcLocalDist();     // calculate the local track to wire distances
 
-  void   FitSimpleTrack( Bool_t weighted = false );
+  void   FitSimpleTrack( VDC::FitCoord_t* coord );
   void   FitNLTrack();        // Non-linear 3-parameter fit
 
-  VDC::chi2_t CalcChisquare( Double_t slope, Double_t icpt, Double_t d0 ) const;
+  VDC::chi2_t CalcChisquare( const VDC::FitCoord_t* coord, Double_t slope,
+			     Double_t icpt, Double_t d0 ) const;
   void   DoCalcChisquare( Double_t& chi2, Int_t& nhits,
 			  Double_t slope, bool do_print = false ) const;
-  void   Linear3DFit( Double_t& slope, Double_t& icpt, Double_t& d0 ) const;
-  Int_t  LinearClusterFitWithT0();
+  void   Linear3DFit( const VDC::FitSums_t& sums, Double_t& slope,
+		      Double_t& icpt, Double_t& d0 ) const;
+  Int_t  LinearClusterFitWithT0( VDC::FitCoord_t* coord );
 
   ClassDef(THaVDCCluster,0)          // A group of VDC hits
 };
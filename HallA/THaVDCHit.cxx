@@ -8,12 +8,20 @@
 
 #include "THaVDCHit.h"
 #include "THaVDCTimeToDistConv.h"
+#include "MethodVar.h"
 #include "TError.h"
 
 const Double_t THaVDCHit::kBig = 1.e38; // Arbitrary large value
 
 using namespace VDC;
 
+//_____________________________________________________________________________
+static const Podd::MethodAccessorDef accessors[] = {
+  PODD_METHOD_ACCESSOR( THaVDCHit, Int_t, GetWireNum ),
+  { 0 }
+};
+PODD_REGISTER_ACCESSORS( accessors );
+
 //_____________________________________________________________________________
 Double_t THaVDCHit::ConvertTimeToDist(Double_t slope)
 {
@@ -0,0 +1,226 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THaVDCOpticsMatrix                                                        //
+//                                                                           //
+// Flat, precompiled representation of optics matrix elements, e.g. one      //
+// target variable's focal-plane-to-target tensor. Each term is a            //
+// polynomial in x_fp of up to kMaxOrder coefficients times a monomial       //
+// th^i * y^j * ph^k * |th|^l (and optionally x^m).                          //
+//                                                                           //
+// The coefficients of all terms are stored in one contiguous table with a   //
+// fixed stride, the exponents in a parallel table. Evaluation precomputes   //
+// the powers of each variable once per track instead of once per term.      //
+// The batch version of Eval processes tracks in chunks with the track loop  //
+// innermost, so that the compiler can vectorize it.                         //
+//                                                                           //
+// For optics optimization, SetCoefficients replaces the coefficients        //
+// without recompiling, and EvalBasis returns the (linear) dependence of     //
+// the result on each coefficient.                                           //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "THaVDCOpticsMatrix.h"
+#include "TMath.h"
+#include <cassert>
+
+using namespace std;
+
+ClassImp(VDC::OpticsMatrix)
+
+namespace VDC {
+
+static const UInt_t kChunk = 64;  // Tracks per batch in Eval
+
+//_____________________________________________________________________________
+OpticsMatrix::OpticsMatrix() : fNterms(0), fMaxOrder(0)
+{
+  // Constructor
+
+  for( Int_t i = 0; i < kNvar; ++i )
+    fMaxExp[i] = 0;
+}
+
+//_____________________________________________________________________________
+void OpticsMatrix::Clear()
+{
+  // Remove all terms
+
+  fNterms = fMaxOrder = 0;
+  for( Int_t i = 0; i < kNvar; ++i )
+    fMaxExp[i] = 0;
+  fCoeff.clear();
+  fPow.clear();
+}
+
+//_____________________________________________________________________________
+Int_t OpticsMatrix::AddTerm( UInt_t order, const Double_t* poly,
+			     const Int_t* pw )
+{
+  // Add a term with polynomial coefficients poly[0..order-1] in x and
+  // exponents pw[kNvar] of the variables x, th, y, ph, |th|.
+  // Returns the index of the new term, or -1 if the input is invalid.
+
+  if( order > kMaxOrder || (order > 0 && !poly) || !pw )
+    return -1;
+  for( Int_t i = 0; i < kNvar; ++i )
+    if( pw[i] < 0 || pw[i] > kMaxPow )
+      return -1;
+
+  fCoeff.resize( fCoeff.size()+kMaxOrder, 0.0 );
+  Double_t* c = &fCoeff[fNterms*kMaxOrder];
+  for( UInt_t i = 0; i < order; ++i )
+    c[i] = poly[i];
+  for( Int_t i = 0; i < kNvar; ++i ) {
+    fPow.push_back( pw[i] );
+    if( pw[i] > fMaxExp[i] )
+      fMaxExp[i] = pw[i];
+  }
+  if( order > fMaxOrder )
+    fMaxOrder = order;
+
+  return fNterms++;
+}
+
+//_____________________________________________________________________________
+Int_t OpticsMatrix::SetCoefficients( const vector<Double_t>& coeff )
+{
+  // Replace all coefficients. coeff must have GetNcoeff() elements, laid out
+  // as returned by GetCoefficients(). Returns 0 on success.
+
+  if( coeff.size() != fCoeff.size() )
+    return -1;
+  fCoeff = coeff;
+  fMaxOrder = 0;
+  for( UInt_t t = 0; t < fNterms; ++t ) {
+    for( UInt_t i = kMaxOrder; i > fMaxOrder; --i ) {
+      if( fCoeff[t*kMaxOrder+i-1] != 0.0 ) {
+	fMaxOrder = i;
+	break;
+      }
+    }
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+inline
+void OpticsMatrix::MakePowers( const Double_t* var,
+			       Double_t pw[][kMaxPow+1] ) const
+{
+  // Compute the powers of each variable up to the highest exponent used
+
+  for( Int_t v = 0; v < kNvar; ++v ) {
+    pw[v][0] = 1.0;
+    for( Int_t e = 1; e <= fMaxExp[v]; ++e )
+      pw[v][e] = pw[v][e-1] * var[v];
+  }
+}
+
+//_____________________________________________________________________________
+Double_t OpticsMatrix::Eval( Double_t x, Double_t th, Double_t y,
+			     Double_t ph ) const
+{
+  // Evaluate the matrix for a single track with the given focal-plane
+  // coordinates
+
+  Double_t var[kNvar] = { x, th, y, ph, TMath::Abs(th) };
+  Double_t pw[kNvar][kMaxPow+1];
+  MakePowers( var, pw );
+
+  Double_t sum = 0.0;
+  const Double_t* c = fCoeff.empty() ? 0 : &fCoeff[0];
+  const Int_t*    e = fPow.empty()   ? 0 : &fPow[0];
+  for( UInt_t t = 0; t < fNterms; ++t, c += kMaxOrder, e += kNvar ) {
+    // Horner's scheme for the polynomial in x
+    Double_t v = 0.0;
+    for( Int_t i = fMaxOrder-1; i >= 1; --i )
+      v = x * (v + c[i]);
+    v += c[0];
+    sum += v * pw[kX][e[kX]] * pw[kTh][e[kTh]] * pw[kY][e[kY]]
+      * pw[kPh][e[kPh]] * pw[kAbsTh][e[kAbsTh]];
+  }
+  return sum;
+}
+
+//_____________________________________________________________________________
+void OpticsMatrix::Eval( UInt_t n, const Double_t* x, const Double_t* th,
+			 const Double_t* y, const Double_t* ph,
+			 Double_t* result ) const
+{
+  // Evaluate the matrix for n tracks. The focal-plane coordinates of track i
+  // are x[i], th[i], y[i], ph[i]. Results are written to result[i].
+
+  Double_t pw[kNvar][kMaxPow+1][kChunk];
+  Double_t v[kChunk];
+
+  for( UInt_t beg = 0; beg < n; beg += kChunk ) {
+    const UInt_t m = TMath::Min( n-beg, kChunk );
+    const Double_t* xc = x+beg;
+    Double_t* res = result+beg;
+
+    // Powers of the variables for this chunk of tracks
+    for( UInt_t k = 0; k < m; ++k ) {
+      pw[kX][0][k] = pw[kTh][0][k] = pw[kY][0][k] = pw[kPh][0][k]
+	= pw[kAbsTh][0][k] = 1.0;
+      pw[kX][1][k]     = xc[k];
+      pw[kTh][1][k]    = th[beg+k];
+      pw[kY][1][k]     = y[beg+k];
+      pw[kPh][1][k]    = ph[beg+k];
+      pw[kAbsTh][1][k] = TMath::Abs(th[beg+k]);
+      res[k] = 0.0;
+    }
+    for( Int_t iv = 0; iv < kNvar; ++iv )
+      for( Int_t e = 2; e <= fMaxExp[iv]; ++e )
+	for( UInt_t k = 0; k < m; ++k )
+	  pw[iv][e][k] = pw[iv][e-1][k] * pw[iv][1][k];
+
+    const Double_t* c = fCoeff.empty() ? 0 : &fCoeff[0];
+    const Int_t*    e = fPow.empty()   ? 0 : &fPow[0];
+    for( UInt_t t = 0; t < fNterms; ++t, c += kMaxOrder, e += kNvar ) {
+      for( UInt_t k = 0; k < m; ++k )
+	v[k] = 0.0;
+      for( Int_t i = fMaxOrder-1; i >= 1; --i ) {
+	const Double_t ci = c[i];
+	for( UInt_t k = 0; k < m; ++k )
+	  v[k] = xc[k] * (v[k] + ci);
+      }
+      const Double_t* px  = pw[kX][e[kX]];
+      const Double_t* pth = pw[kTh][e[kTh]];
+      const Double_t* py  = pw[kY][e[kY]];
+      const Double_t* pph = pw[kPh][e[kPh]];
+      const Double_t* pat = pw[kAbsTh][e[kAbsTh]];
+      const Double_t  c0  = c[0];
+      for( UInt_t k = 0; k < m; ++k )
+	res[k] += (v[k] + c0) * px[k] * pth[k] * py[k] * pph[k] * pat[k];
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void OpticsMatrix::EvalBasis( Double_t x, Double_t th, Double_t y,
+			      Double_t ph, Double_t* basis ) const
+{
+  // Fill basis[GetNcoeff()] with the derivative of Eval(x,th,y,ph) with
+  // respect to each coefficient. Since the result is linear in the
+  // coefficients, Eval = sum_i basis[i]*GetCoefficients()[i].
+  // This is the design matrix row needed for linear optics fits.
+
+  Double_t var[kNvar] = { x, th, y, ph, TMath::Abs(th) };
+  Double_t pw[kNvar][kMaxPow+1];
+  MakePowers( var, pw );
+
+  const Int_t* e = fPow.empty() ? 0 : &fPow[0];
+  for( UInt_t t = 0; t < fNterms; ++t, e += kNvar ) {
+    Double_t mono = pw[kX][e[kX]] * pw[kTh][e[kTh]] * pw[kY][e[kY]]
+      * pw[kPh][e[kPh]] * pw[kAbsTh][e[kAbsTh]];
+    Double_t* b = basis + t*kMaxOrder;
+    for( Int_t i = 0; i < kMaxOrder; ++i ) {
+      b[i] = mono;
+      mono *= x;
+    }
+  }
+}
+
+} // namespace VDC
+
+///////////////////////////////////////////////////////////////////////////////
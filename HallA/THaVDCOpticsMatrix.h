@@ -0,0 +1,63 @@
+#ifndef Podd_VDC_OpticsMatrix_h_
+#define Podd_VDC_OpticsMatrix_h_
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THaVDCOpticsMatrix                                                        //
+//                                                                           //
+// Compiled form of a set of optics matrix elements for fast evaluation      //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+
+namespace VDC {
+
+  class OpticsMatrix {
+
+  public:
+    // Focal-plane variables a matrix element may depend on
+    enum EVar { kX = 0, kTh, kY, kPh, kAbsTh, kNvar };
+    enum { kMaxPow = 9, kMaxOrder = 7 };
+
+    OpticsMatrix();
+    virtual ~OpticsMatrix() {}
+
+    void     Clear();
+    Int_t    AddTerm( UInt_t order, const Double_t* poly, const Int_t* pw );
+
+    // Evaluate for one track
+    Double_t Eval( Double_t x, Double_t th, Double_t y, Double_t ph ) const;
+    // Evaluate for n tracks at once
+    void     Eval( UInt_t n, const Double_t* x, const Double_t* th,
+		   const Double_t* y, const Double_t* ph,
+		   Double_t* result ) const;
+    // Derivatives of the result with respect to each coefficient
+    void     EvalBasis( Double_t x, Double_t th, Double_t y, Double_t ph,
+			Double_t* basis ) const;
+
+    // Flat coefficient table, kMaxOrder entries per term, for optimization
+    UInt_t   GetNterms()  const { return fNterms; }
+    UInt_t   GetNcoeff()  const { return fNterms*kMaxOrder; }
+    const std::vector<Double_t>& GetCoefficients() const { return fCoeff; }
+    Int_t    SetCoefficients( const std::vector<Double_t>& coeff );
+    const Int_t* GetPowers( UInt_t i ) const { return &fPow[i*kNvar]; }
+    Bool_t   IsEmpty()    const { return fNterms == 0; }
+
+  protected:
+    UInt_t   fNterms;                 // Number of terms
+    UInt_t   fMaxOrder;               // Highest polynomial order in x
+    Int_t    fMaxExp[kNvar];          // Highest exponent of each variable
+    std::vector<Double_t> fCoeff;     // [fNterms][kMaxOrder] coefficients
+    std::vector<Int_t>    fPow;       // [fNterms][kNvar] exponents
+
+    void     MakePowers( const Double_t* var, Double_t pw[][kMaxPow+1] ) const;
+
+    ClassDef(OpticsMatrix,0)  // Compiled optics matrix
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
@@ -218,7 +218,8 @@ Int_t THaVDCPlane::ReadDatabase( const TDatime& date )
   set<Int_t> bad_wires( ALL(bad_wirelist) );
   bad_wirelist.clear();
 
-  // Create time-to-distance converter
+  // Create time-to-distance converter. "AnalyticTTDConv" (default) and
+  // "TableTTDConv" are built in; the latter tabulates the slope corrections
   if( !ttd_conv.Contains("::") )
     ttd_conv.Prepend("VDC::");
   const char* s = ttd_conv.Data();
@@ -446,7 +447,12 @@ void THaVDCPlane::Clear( Option_t* opt )
   THaSubDetector::Clear(opt);
   fNHits = fNWiresHit = 0;
   fHits->Clear();
+#if ROOT_VERSION_CODE >= ROOT_VERSION(5,32,0)
+  // Keep the cluster objects, with their hit lists, for reuse by FindClusters
+  fClusters->Clear("C");
+#else
   fClusters->Delete();
+#endif
 }
 
 //_____________________________________________________________________________
@@ -754,8 +760,14 @@ Int_t THaVDCPlane::FindClusters()
        // Also, make sure that we did indeed see the time
        // spectrum turn around at some point
        if( nwires >= fMinClustSize && !falling ) {
+#if ROOT_VERSION_CODE >= ROOT_VERSION(5,32,0)
+	  THaVDCCluster* clust =
+	     static_cast<THaVDCCluster*>( fClusters->ConstructedAt(nextClust++) );
+	  clust->SetPlane(this);
+#else
 	  THaVDCCluster* clust =
 	     new ( (*fClusters)[nextClust++] ) THaVDCCluster(this);
+#endif
 
 	  for( j = 0; j < clushits.size(); j++ ){
 	     clushits[j]->SetClsNum(nextClust-1);
@@ -780,11 +792,19 @@ Int_t THaVDCPlane::FindClusters()
 Int_t THaVDCPlane::FitTracks()
 {
   // Fit tracks to cluster positions and drift distances.
+  //
+  // All clusters are processed together: first, drift times are converted
+  // and the fit coordinates of every cluster are gathered into one
+  // contiguous workspace owned by this plane; then each cluster is fit
+  // from its section of that workspace. The workspace keeps its capacity
+  // across events, so no memory is allocated here in the steady state.
+
+  const THaVDCCluster::EMode mode = THaVDCCluster::kSimple;
 
   Int_t nClust = GetNClusters();
+  UInt_t ncoord = 0;
   for (int i = 0; i < nClust; i++) {
-    THaVDCCluster* clust = static_cast<THaVDCCluster*>( (*fClusters)[i] );
-    if( !clust ) continue;
+    THaVDCCluster* clust = GetCluster(i);
 
     // Convert drift times to distances.
     // The conversion algorithm is determined at wire initialization time,
@@ -794,9 +814,25 @@ Int_t THaVDCPlane::FitTracks()
     // THaVDCCluster::EstTrackParameters or the global slope from
     // THaVDC::ConstructTracks
     clust->ConvertTimeToDist();
+    ncoord += clust->GetSize();
+  }
+  if( fFitCoord.size() < ncoord )
+    fFitCoord.resize( ncoord, VDC::FitCoord_t(0,0) );
+
+  // Clusters without hits get a null workspace pointer, which they never
+  // dereference. This avoids indexing past the end of fFitCoord.
+  UInt_t off = 0;
+  for (int i = 0; i < nClust; i++)
+    off += GetCluster(i)->FillFitCoord( FitCoordAt(off), mode );
+  assert( off == ncoord );
+
+  off = 0;
+  for (int i = 0; i < nClust; i++) {
+    THaVDCCluster* clust = GetCluster(i);
 
     // Fit drift distances to get intercept, slope.
-    clust->FitTrack();
+    clust->FitTrack( FitCoordAt(off), mode );
+    off += clust->GetSize();
 
 #ifdef CLUST_RAWDATA_HACK
     // HACK: write out cluster info for small-t0 clusters in u1
@@ -69,6 +69,7 @@ public:
   Double_t        GetMaxTime()        const { return fMaxTime; }
   Double_t        GetMaxTdiff()       const { return fMaxTdiff; }
   Double_t        GetT0Resolution()   const { return fT0Resolution; }
+  VDC::TimeToDistConv* GetTTDConv()   const { return fTTDConv; }
 
 //   Double_t GetT0() const { return fT0; }
 //   Int_t GetNumBins() const { return fNumBins; }
@@ -121,6 +122,12 @@ protected:
 
   VDC::TimeToDistConv* fTTDConv;  // Time-to-distance converter for this plane's wires
 
+  VDC::Vcoord_t fFitCoord; //! Workspace for fitting all clusters (see FitTracks)
+
+  // Pointer to fFitCoord[i], or null if i is past the end
+  VDC::FitCoord_t* FitCoordAt( UInt_t i )
+  { return ( i < fFitCoord.size() ) ? &fFitCoord[i] : 0; }
+
   THaVDC* fVDC;           // VDC detector to which this plane belongs
 
   THaTriggerTime* fglTrg; //! time-offset global variable. Needed at the decode stage
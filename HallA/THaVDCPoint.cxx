@@ -9,8 +9,16 @@
 #include "THaVDCPoint.h"
 #include "THaVDCChamber.h"
 #include "THaTrack.h"
+#include "MethodVar.h"
 #include <cassert>
 
+//_____________________________________________________________________________
+static const Podd::MethodAccessorDef accessors[] = {
+  PODD_METHOD_ACCESSOR( THaVDCPoint, Bool_t, HasPartner ),
+  { 0 }
+};
+PODD_REGISTER_ACCESSORS( accessors );
+
 //_____________________________________________________________________________
 THaVDCPoint::THaVDCPoint( THaVDCCluster* u_cl, THaVDCCluster* v_cl,
 			  THaVDCChamber* chamber )
@@ -10,7 +10,6 @@
 
 #include "THaVDCPointPair.h"
 #include "THaVDCChamber.h"
-#include "TClass.h"       // for IsA()
 #include "TString.h"
 
 #include <iostream>
@@ -62,25 +61,6 @@ chi2_t THaVDCPointPair::CalcChi2() const
   return res;
 }
 
-//_____________________________________________________________________________
-Int_t THaVDCPointPair::Compare( const TObject* obj ) const
-{
-  // Compare this object to another THaVDCPointPair.
-  // Used for sorting tracks.
-
-  if( !obj || IsA() != obj->IsA() )
-    return -1;
-
-  const THaVDCPointPair* rhs = static_cast<const THaVDCPointPair*>( obj );
-
-  if( fError < rhs->fError )
-    return -1;
-  if( fError > rhs->fError )
-    return 1;
-
-  return 0;
-}
-
 //_____________________________________________________________________________
 Double_t THaVDCPointPair::CalcError( THaVDCPoint* here,
 				     THaVDCPoint* there,
@@ -214,6 +194,3 @@ void THaVDCPointPair::Release()
   // Mark this track pair as unused
 
 }
-
-///////////////////////////////////////////////////////////////////////////////
-ClassImp(THaVDCPointPair)
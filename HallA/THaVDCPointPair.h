@@ -7,24 +7,25 @@
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
 
-#include "TObject.h"
+#include "Rtypes.h"
 #include "THaVDCCluster.h"   // for chi2_t
 
 class THaVDCPoint;
 class THaTrack;
 
-class THaVDCPointPair : public TObject {
+// Transient per-event object. THaVDC creates these in its EventArena,
+// which never runs destructors, so this class must not derive from TObject
+// or own any resources.
+class THaVDCPointPair {
 
 public:
   THaVDCPointPair( THaVDCPoint* lp, THaVDCPoint* up, Double_t spacing )
     : fLowerPoint(lp), fUpperPoint(up), fSpacing(spacing), fError(1e38),
       fStatus(0) {}
-  virtual ~THaVDCPointPair() {}
 
   void            Analyze();
   void            Associate( THaTrack* track );
   VDC::chi2_t     CalcChi2() const;
-  virtual Int_t   Compare( const TObject* ) const;
   Double_t        GetError()   const { return fError; }
   THaVDCPoint*    GetLower()   const { return fLowerPoint; }
   THaVDCPoint*    GetUpper()   const { return fUpperPoint; }
@@ -32,8 +33,7 @@ public:
   Int_t           GetStatus()  const { return fStatus; }
   THaTrack*       GetTrack()   const;
   Bool_t          HasUsedCluster() const;
-  virtual Bool_t  IsSortable() const { return kTRUE; }
-  virtual void    Print( Option_t* opt="" ) const;
+  void            Print( Option_t* opt="" ) const;
   void            Release();
   void            SetStatus( Int_t i ) { fStatus = i; }
   void            Use();
@@ -56,8 +56,6 @@ protected:
 
 private:
   THaVDCPointPair();
-
-  ClassDef(THaVDCPointPair,0)     // Pair of lower/upper VDC points
 };
 
 //////////////////////////////////////////////////////////////////////////////
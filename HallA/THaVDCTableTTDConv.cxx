@@ -0,0 +1,169 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THaVDCTableTTDConv                                                        //
+//                                                                           //
+// Same parameterization as AnalyticTTDConv, but the slope-dependent         //
+// correction polynomials a1(1/tan(theta)) and a2(1/tan(theta)) are          //
+// precomputed at initialization on a grid in 1/tan(theta) and linearly      //
+// interpolated. Outside of the table range, the analytic form is used.      //
+// (The drift time dependence is piecewise linear and needs no table.)       //
+//                                                                           //
+// Database parameters (ttd.param):                                          //
+//   0-8:  as for AnalyticTTDConv                                            //
+//   9:    number of table intervals (optional, default 400)                 //
+//   10:   lower limit of 1/tan(theta) (optional, default 0.0)               //
+//   11:   upper limit of 1/tan(theta) (optional, default 2.0)               //
+//                                                                           //
+// Use CheckTable() to verify the table against the analytic result.         //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "THaVDCTableTTDConv.h"
+#include "TError.h"
+#include "TMath.h"
+
+ClassImp(VDC::TableTTDConv)
+
+using namespace std;
+
+namespace VDC {
+
+static const UInt_t   kDefaultNbins = 400;
+static const Double_t kDefaultXmin  = 0.0;
+static const Double_t kDefaultXmax  = 2.0;
+
+//_____________________________________________________________________________
+TableTTDConv::TableTTDConv()
+  : fNbins(kDefaultNbins), fXmin(kDefaultXmin), fXmax(kDefaultXmax),
+    fInvStep(0)
+{
+  // Constructor
+}
+
+//_____________________________________________________________________________
+void TableTTDConv::MakeTable()
+{
+  // Tabulate the correction polynomials at the fNbins+1 bin edges
+
+  fA1tab.resize(fNbins+1);
+  fA2tab.resize(fNbins+1);
+  Double_t step = (fXmax-fXmin)/fNbins;
+  fInvStep = 1.0/step;
+  for( UInt_t i = 0; i <= fNbins; ++i ) {
+    Double_t x = fXmin + i*step;
+    // CalcCorrections expects tan(theta). x = 0 corresponds to infinite slope
+    Double_t tanTheta = ( x != 0.0 ) ? 1.0/x : kBig;
+    CalcCorrections( tanTheta, fA1tab[i], fA2tab[i] );
+  }
+}
+
+//_____________________________________________________________________________
+void TableTTDConv::GetCorrections( Double_t tanTheta,
+				   Double_t& a1, Double_t& a2 ) const
+{
+  // Interpolate correction parameters a1 and a2 from table
+
+  Double_t u = (1.0/tanTheta - fXmin) * fInvStep;
+  if( u >= 0.0 && u < fNbins ) {
+    UInt_t i = static_cast<UInt_t>(u);
+    Double_t f = u-i;
+    a1 = fA1tab[i] + f * (fA1tab[i+1]-fA1tab[i]);
+    a2 = fA2tab[i] + f * (fA2tab[i+1]-fA2tab[i]);
+  } else
+    CalcCorrections( tanTheta, a1, a2 );
+}
+
+//_____________________________________________________________________________
+Double_t TableTTDConv::CheckTable( Double_t tmin, Double_t tmax,
+				   UInt_t nt, UInt_t nslope ) const
+{
+  // Compare tabulated drift distances against the analytic form on a grid
+  // of nt drift times in [tmin,tmax] (s) and nslope values of 1/tan(theta)
+  // covering the table range (default: 4 per table bin, offset from the
+  // bin edges). Returns the largest absolute deviation found (m), or a
+  // negative number if parameters are not set.
+
+  if( !fIsSet || fA1tab.empty() )
+    return -1.0;
+  if( nt < 2 )
+    nt = 2;
+  if( nslope == 0 )
+    nslope = 4*fNbins;
+
+  Double_t maxdev = 0;
+  Double_t xstep = (fXmax-fXmin)/nslope;
+  Double_t tstep = (tmax-tmin)/(nt-1);
+  for( UInt_t j = 0; j < nslope; ++j ) {
+    Double_t x = fXmin + (j+0.5)*xstep;
+    if( x == 0.0 )
+      continue;
+    Double_t tanTheta = 1.0/x;
+    Double_t a1, a2, b1, b2;
+    GetCorrections( tanTheta, a1, a2 );
+    CalcCorrections( tanTheta, b1, b2 );
+    for( UInt_t i = 0; i < nt; ++i ) {
+      Double_t d = fDriftVel * (tmin + i*tstep);
+      if( d < 0 )
+	continue;
+      Double_t dtab = ( d < a1 ) ? d * (1.0 + a2/a1) : d + a2;
+      Double_t dana = ( d < b1 ) ? d * (1.0 + b2/b1) : d + b2;
+      Double_t dev = TMath::Abs(dtab-dana);
+      if( dev > maxdev )
+	maxdev = dev;
+    }
+  }
+  return maxdev;
+}
+
+//_____________________________________________________________________________
+Double_t TableTTDConv::GetParameter( UInt_t i ) const
+{
+  // Get i-th parameter
+
+  switch(i) {
+  case 9:
+    return fNbins;
+  case 10:
+    return fXmin;
+  case 11:
+    return fXmax;
+  }
+  return AnalyticTTDConv::GetParameter(i);
+}
+
+//_____________________________________________________________________________
+Int_t TableTTDConv::SetParameters( const vector<double>& parameters )
+{
+  // Set parameters of the analytic form (see AnalyticTTDConv), followed
+  // by optional table parameters, and build the table
+
+  Int_t ret = AnalyticTTDConv::SetParameters( parameters );
+  if( ret != 0 )
+    return ret;
+
+  fNbins = kDefaultNbins;
+  fXmin  = kDefaultXmin;
+  fXmax  = kDefaultXmax;
+  if( parameters.size() > 9 ) {
+    if( parameters[9] < 1.0 || parameters[9] > 1e6 ) {
+      fIsSet = false;
+      return -2;
+    }
+    fNbins = static_cast<UInt_t>(parameters[9]);
+  }
+  if( parameters.size() > 10 )
+    fXmin = parameters[10];
+  if( parameters.size() > 11 )
+    fXmax = parameters[11];
+  if( fXmin >= fXmax ) {
+    fIsSet = false;
+    return -3;
+  }
+
+  MakeTable();
+  return 0;
+}
+
+} //namespace VDC
+
+///////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,53 @@
+#ifndef Podd_VDC_TableTTDConv_h_
+#define Podd_VDC_TableTTDConv_h_
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// THaVDCTableTTDConv                                                        //
+//                                                                           //
+// Analytic time-to-distance conversion with tabulated slope corrections     //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "THaVDCAnalyticTTDConv.h"
+
+namespace VDC {
+
+  class TableTTDConv : public AnalyticTTDConv {
+
+  public:
+    TableTTDConv();
+    virtual ~TableTTDConv() {}
+
+    virtual Double_t GetParameter( UInt_t i ) const;
+    virtual Int_t    SetParameters( const std::vector<double>& param );
+
+    // Compare tabulated against analytic results
+    Double_t         CheckTable( Double_t tmin, Double_t tmax,
+				 UInt_t nt = 100, UInt_t nslope = 0 ) const;
+
+    UInt_t           GetNbins()   const { return fNbins; }
+    Double_t         GetXmin()    const { return fXmin; }
+    Double_t         GetXmax()    const { return fXmax; }
+
+protected:
+
+    virtual void     GetCorrections( Double_t tanTheta,
+				     Double_t& a1, Double_t& a2 ) const;
+
+    void             MakeTable();
+
+    UInt_t   fNbins;      // Number of table intervals in 1/tan(theta)
+    Double_t fXmin;       // Lower limit of table in 1/tan(theta)
+    Double_t fXmax;       // Upper limit of table in 1/tan(theta)
+    Double_t fInvStep;    // 1/(bin width)
+    std::vector<Double_t> fA1tab; // Tabulated a1 at the bin edges
+    std::vector<Double_t> fA2tab; // Tabulated a2 at the bin edges
+
+    ClassDef(TableTTDConv,0)   // VDC tabulated TTD Conv class
+  };
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
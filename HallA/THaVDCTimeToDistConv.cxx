@@ -19,6 +19,24 @@ TimeToDistConv::TimeToDistConv( UInt_t npar )
   // Constructor
 }
 
+//_____________________________________________________________________________
+void TimeToDistConv::ConvertTimesToDist( UInt_t n, const Double_t* time,
+					 Double_t tanTheta, Double_t* dist,
+					 Double_t* ddist ) const
+{
+  // Convert n drift times that share the same track slope, tanTheta.
+  // Results go to dist[0..n-1] and, if given, ddist[0..n-1].
+  // This generic version simply calls ConvertTimeToDist for each time.
+  // Derived classes should override it if they can do better.
+  // ddist[i] is kBig if the conversion does not provide an uncertainty.
+
+  for( UInt_t i = 0; i < n; ++i ) {
+    if( ddist )
+      ddist[i] = kBig;
+    dist[i] = ConvertTimeToDist( time[i], tanTheta, ddist ? ddist+i : 0 );
+  }
+}
+
 //_____________________________________________________________________________
 void TimeToDistConv::SetDriftVel( Double_t v )
 {
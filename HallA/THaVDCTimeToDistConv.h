@@ -25,6 +25,9 @@ namespace VDC {
 
     virtual Double_t ConvertTimeToDist( Double_t time, Double_t tanTheta,
 					Double_t* ddist = 0 ) const = 0;
+    virtual void     ConvertTimesToDist( UInt_t n, const Double_t* time,
+					 Double_t tanTheta, Double_t* dist,
+					 Double_t* ddist = 0 ) const;
     Double_t         GetDriftVel() { return fDriftVel; }
     virtual Double_t GetParameter( UInt_t ) const { return kBig; }
     void             SetDriftVel( Double_t v );
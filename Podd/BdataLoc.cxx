@@ -2,7 +2,7 @@
 
 //////////////////////////////////////////////////////////////////////////
 //
-// BdataLoc, CrateLoc, WordLoc
+// BdataLoc, CrateLoc, WordLoc, MultiWordLoc
 //
 // Utility classes for THaDecData generic raw data decoder
 //
@@ -22,6 +22,7 @@
 #include <errno.h>
 #include <utility>
 #include <iostream>
+#include <algorithm>
 
 using namespace std;
 
@@ -359,6 +360,99 @@ void WordLoc::Print( Option_t* opt ) const
   cout << "\t data = " << data << endl;
 }
 
+//_____________________________________________________________________________
+static bool HeaderLess( const WordLoc* a, const WordLoc* b )
+{
+  return a->GetHeader() < b->GetHeader();
+}
+
+//_____________________________________________________________________________
+void MultiWordLoc::Add( WordLoc* loc )
+{
+  // Add a WordLoc for this crate. Call Init() after all have been added.
+
+  assert( loc && loc->GetCrate() == crate );
+  fLocs.push_back(loc);
+}
+
+//_____________________________________________________________________________
+void MultiWordLoc::Init()
+{
+  // Build the header lookup table. The table is a power of 2 in size and
+  // at most a quarter full, so a failed lookup, by far the most common case,
+  // usually costs one multiplication and one comparison.
+
+  stable_sort( fLocs.begin(), fLocs.end(), HeaderLess );
+  fHeaders.clear();
+  fFirst.clear();
+  for( UInt_t i = 0; i < fLocs.size(); ++i ) {
+    if( i == 0 || fLocs[i]->GetHeader() != fHeaders.back() ) {
+      fHeaders.push_back( fLocs[i]->GetHeader() );
+      fFirst.push_back(i);
+    }
+  }
+  fFirst.push_back( fLocs.size() );
+
+  UInt_t size = 4, nbits = 2;
+  while( size < 4*fHeaders.size() ) {
+    size <<= 1; ++nbits;
+  }
+  fShift = 32-nbits;
+  fTable.assign( size, -1 );
+  for( UInt_t j = 0; j < fHeaders.size(); ++j ) {
+    UInt_t h = (fHeaders[j] * 2654435761U) >> fShift;
+    while( fTable[h] >= 0 )
+      h = (h+1) & (size-1);
+    fTable[h] = j;
+  }
+  fDone.assign( fLocs.size(), 0 );
+}
+
+//_____________________________________________________________________________
+inline Int_t MultiWordLoc::Find( UInt_t word ) const
+{
+  // Return index of 'word' in fHeaders, or -1 if not a requested header
+
+  UInt_t mask = fTable.size()-1;
+  for( UInt_t h = (word * 2654435761U) >> fShift; ; h = (h+1) & mask ) {
+    Int_t j = fTable[h];
+    if( j < 0 || fHeaders[j] == word )
+      return j;
+  }
+}
+
+//_____________________________________________________________________________
+void MultiWordLoc::Load( const THaEvData& evdata )
+{
+  // Load the data of all WordLocs of this crate in one pass over the crate
+  // buffer. Each WordLoc gets the same result as from WordLoc::Load:
+  // the word 'ntoskip' after the first occurrence of its header.
+
+  Int_t roclen = evdata.GetRocLength(crate);
+  if( roclen < 2 || fLocs.empty() ) return;
+
+  const UInt_t* cratebuf = evdata.GetRawDataBuffer(crate);
+  assert(cratebuf);  // Must exist if roclen > 0
+
+  fDone.assign( fLocs.size(), 0 );
+  UInt_t nleft = fLocs.size();
+  for( Int_t i = 2; i <= roclen; ++i ) {
+    Int_t j = Find( cratebuf[i] );
+    if( j < 0 )
+      continue;
+    for( UInt_t k = fFirst[j]; k < fFirst[j+1]; ++k ) {
+      WordLoc* loc = fLocs[k];
+      if( fDone[k] || i > roclen-loc->ntoskip )
+	continue;
+      loc->data = cratebuf[i+loc->ntoskip];
+      fDone[k] = 1;
+      --nleft;
+    }
+    if( nleft == 0 )
+      break;
+  }
+}
+
 //_____________________________________________________________________________
 void RoclenLoc::Load( const THaEvData& evdata )
 {
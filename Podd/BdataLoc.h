@@ -172,9 +172,15 @@ public:
   // { return (crate == rhs.crate &&
   // 	    header == rhs.header && ntoskip == rhs.ntoskip); }
 
+  Int_t   GetCrate() const   { return crate; }
+  UInt_t  GetHeader() const  { return header; }
+  Int_t   GetNtoskip() const { return ntoskip; }
+
 protected:
   UInt_t header;              // header (unique either in data or in crate)
   Int_t  ntoskip;             // how far to skip beyond header
+
+  friend class MultiWordLoc;
    
 private:
   static TypeIter_t fgThisType;
@@ -182,6 +188,32 @@ private:
   ClassDef(WordLoc,0)  
 };
 
+//___________________________________________________________________________
+class MultiWordLoc {
+  // Helper for DecData. Loads all WordLoc objects of one crate with a single
+  // pass over the crate buffer, looking up each data word in a hash table
+  // of the requested header words. Not a database type by itself.
+public:
+  explicit MultiWordLoc( Int_t cra = 0 ) : crate(cra), fShift(32) {}
+
+  void    Add( WordLoc* loc );
+  void    Init();
+  void    Load( const THaEvData& evt );
+  Int_t   GetCrate() const { return crate; }
+  UInt_t  GetSize() const  { return fLocs.size(); }
+
+protected:
+  Int_t                 crate;     // Crate whose buffer to scan
+  std::vector<WordLoc*> fLocs;     // WordLocs in this crate, sorted by header
+  std::vector<UInt_t>   fFirst;    // Index of first fLocs entry per header
+  std::vector<UInt_t>   fHeaders;  // Distinct header words, sorted
+  std::vector<Int_t>    fTable;    // Hash table of indices into fHeaders
+  std::vector<char>     fDone;     // Per-event: fLocs entry was loaded
+  UInt_t                fShift;    // Hash shift, 32-log2(table size)
+
+  Int_t   Find( UInt_t word ) const;
+};
+
 //___________________________________________________________________________
 class RoclenLoc : public BdataLoc {
 public:
@@ -137,6 +137,8 @@ void DecData::Reset( Option_t* opt )
   // Reset the class. Removes all data channel definitions
 
   Clear(opt);
+  fLoadLoc.clear();
+  fWordScan.clear();
   fBdataLoc.Clear();
 }
 
@@ -369,10 +371,56 @@ Int_t DecData::ReadDatabase( const TDatime& date )
   if( err )
     return kInitError;
 
+  SetupScanners();
+
   fIsInit = kTRUE;
   return kOK;
 }
 
+//_____________________________________________________________________________
+void DecData::SetupScanners()
+{
+  // Group "word" channels by crate. Crates with more than one such channel
+  // get a MultiWordLoc that finds all their header words in a single scan of
+  // the crate buffer. All other channels are loaded individually.
+  // Classes derived from WordLoc may override Load(), so only plain WordLocs
+  // are grouped.
+
+  fLoadLoc.clear();
+  fWordScan.clear();
+
+  vector<WordLoc*> words;
+  TIter next( &fBdataLoc );
+  while( BdataLoc* dataloc = static_cast<BdataLoc*>( next() ) ) {
+    if( dataloc->IsA() == WordLoc::Class() )
+      words.push_back( static_cast<WordLoc*>(dataloc) );
+    else
+      fLoadLoc.push_back( dataloc );
+  }
+  for( vector<WordLoc*>::size_type i = 0; i < words.size(); ++i ) {
+    WordLoc* loc = words[i];
+    vector<MultiWordLoc>::size_type j = 0;
+    while( j < fWordScan.size() && fWordScan[j].GetCrate() != loc->GetCrate() )
+      ++j;
+    if( j == fWordScan.size() )
+      fWordScan.push_back( MultiWordLoc(loc->GetCrate()) );
+    fWordScan[j].Add( loc );
+  }
+  for( vector<MultiWordLoc>::size_type j = 0; j < fWordScan.size(); ) {
+    if( fWordScan[j].GetSize() == 1 ) {
+      // Single header in this crate: WordLoc::Load's memchr search is fastest
+      for( vector<WordLoc*>::size_type i = 0; i < words.size(); ++i ) {
+	if( words[i]->GetCrate() == fWordScan[j].GetCrate() )
+	  fLoadLoc.push_back( words[i] );
+      }
+      fWordScan.erase( fWordScan.begin()+j );
+    } else {
+      fWordScan[j].Init();
+      ++j;
+    }
+  }
+}
+
 
 //_____________________________________________________________________________
 THaAnalysisObject::EStatus DecData::Init( const TDatime& run_time )
@@ -397,16 +445,15 @@ Int_t DecData::Decode(const THaEvData& evdata)
 
   evtype = evdata.GetEvType();   // CODA event type
 
-  // For each raw data source registered in fBdataLoc, get the data
-
-  //TODO: accelerate search for multiple header words in same crate
-  //- group WordLoc objects by crate
-  //- for each crate with >1 WordLoc defs, make a MultiWordLoc
-  //- MultiWordLoc uses faster search algo to scan crate buffer
+  // For each raw data source registered in fBdataLoc, get the data.
+  // "word" channels sharing a crate are loaded together by one scan
+  // of that crate's buffer (see SetupScanners).
 
-  TIter next( &fBdataLoc );
-  while( BdataLoc *dataloc = static_cast<BdataLoc*>( next() ) ) {
-    dataloc->Load( evdata );
+  for( vector<BdataLoc*>::size_type i = 0; i < fLoadLoc.size(); ++i ) {
+    fLoadLoc[i]->Load( evdata );
+  }
+  for( vector<MultiWordLoc>::size_type i = 0; i < fWordScan.size(); ++i ) {
+    fWordScan[i].Load( evdata );
   }
 
   if( fDebug>1 )
@@ -10,6 +10,7 @@
 #include "THaApparatus.h"
 #include "THashList.h"
 #include "BdataLoc.h"
+#include <vector>
 
 class TString;
 
@@ -37,6 +38,11 @@ protected:
   UInt_t          evtypebits;  // Bitpattern of active trigger numbers
   THashList       fBdataLoc;   // Raw data channels
 
+  // Decoding plan, built after reading the database
+  std::vector<BdataLoc*>     fLoadLoc;  //! Channels loaded individually
+  std::vector<MultiWordLoc>  fWordScan; //! Per-crate scanners for "word" channels
+
+  void            SetupScanners();
   virtual Int_t   DefineVariables( EMode mode = kDefine );
   virtual Int_t   ReadDatabase( const TDatime& date );
 
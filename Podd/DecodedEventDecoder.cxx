@@ -0,0 +1,357 @@
+/////////////////////////////////////////////////////////////////////
+//
+//   Podd::DecodedEventDecoder
+//
+//   Decoder that replays events from a file of pre-decoded events,
+//   written by Podd::DecodedEventWriter during an earlier replay of
+//   the same run and read via Podd::DecodedEventRun. Calibration
+//   passes that replay a run many times with different detector
+//   parameters can skip the raw data decoding this way:
+//
+//     THaInterface::SetDecoder( Podd::DecodedEventDecoder::Class() );
+//     Podd::DecodedEventRun* run = new Podd::DecodedEventRun("run.dec");
+//
+//   Physics events are stored as records of the decoded contents of
+//   each crate/slot (channel, data and raw word of every hit) as well
+//   as the processed data of multi-function modules such as FADCs.
+//   These records are loaded directly into the slot data, so
+//   detectors see the same data via GetData, GetNumHits etc. as with
+//   the CODA decoder. All other events (prestart, EPICS, scalers,
+//   etc.) are stored in their original CODA format and decoded by
+//   CodaDecoder as usual.
+//
+//   The raw CODA buffer is not available for physics events, i.e.
+//   GetRawData(i), GetRawData(crate,i), GetRocLength and similar
+//   functions return nothing useful for them. Nor can the crate map
+//   be changed between writing and replaying the file; slots not in
+//   the current crate map are ignored.
+//
+//   Files of CODA events can also be read with this decoder. It then
+//   behaves like CodaRawDecoder.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "DecodedEventDecoder.h"
+#include "THaSlotData.h"
+#include "THaBenchmark.h"
+#include "THaCrateMap.h"
+#include "Module.h"
+#include <cassert>
+#include <cstddef>
+
+using namespace std;
+using namespace Decoder;
+
+namespace Podd {
+
+// Record header: length-1, (event type<<16)|kDecodedTag, event number,
+// original event length, event time (2 words), number of slots.
+// Each slot starts with (crate<<16)|slot, number of hits, number of words
+// of module data, followed by the hits and the module data.
+static const UInt_t kHeaderLen = 7;
+static const UInt_t kSlotHeaderLen = 3;
+static const Int_t  kNModuleTypes = kFineTime+1;
+
+//_____________________________________________________________________________
+// Processed data of a multi-function module, replayed from a record
+class DecodedModule : public Module {
+public:
+  DecodedModule( Int_t crate, Int_t slot )
+    : Module(crate,slot), fMask(0), fActive(kFALSE) {}
+
+  using Module::GetData;
+  using Module::GetNumEvents;
+  using Module::LoadSlot;
+
+  Bool_t  Load( const UInt_t* p, UInt_t len );
+  Bool_t  IsActive() const { return fActive; }
+  void    SetActive( Bool_t active ) { fActive = active; }
+
+  virtual Int_t  Decode( const UInt_t* ) { return 0; }
+  virtual Int_t  LoadSlot( THaSlotData*, const UInt_t*, const UInt_t* )
+  { return 0; }
+  virtual Bool_t IsMultiFunction() { return kTRUE; }
+  virtual Bool_t HasCapability( EModuleType type )
+  { return (fMask & (1U<<type)) != 0; }
+  virtual Int_t  GetNumEvents( EModuleType type, Int_t chan ) const;
+  virtual Int_t  GetData( EModuleType type, Int_t chan, Int_t hit ) const;
+  virtual Int_t  GetNumSamples( Int_t chan ) const
+  { return GetNumEvents(kSampleADC,chan); }
+
+private:
+  UInt_t fMask;                 // Bit pattern of available EModuleTypes
+  Bool_t fActive;               // Module has data in current event
+  std::vector<UInt_t> fPos;     // [type*fNumChan+chan] Index into fValues
+  std::vector<UInt_t> fNum;     // [type*fNumChan+chan] Number of values
+  std::vector<Int_t>  fValues;  // All values of this event
+};
+
+//_____________________________________________________________________________
+Bool_t DecodedModule::Load( const UInt_t* p, UInt_t len )
+{
+  // Load module data block of 'len' words: bit pattern of types, number of
+  // channels, then for each type present and each channel the number of
+  // values followed by the values.
+
+  fMask = 0;
+  if( len < 2 || p[1] == 0 || p[1] > kMaxUShort )
+    return kFALSE;
+  UInt_t mask = p[0];
+  fNumChan = p[1];
+  fPos.assign( kNModuleTypes*fNumChan, 0 );
+  fNum.assign( kNModuleTypes*fNumChan, 0 );
+  fValues.clear();
+  const UInt_t* q = p+2, *qend = p+len;
+  for( Int_t type = 0; type < kNModuleTypes; type++ ) {
+    if( (mask & (1U<<type)) == 0 )
+      continue;
+    for( Int_t chan = 0; chan < fNumChan; chan++ ) {
+      if( q == qend || *q > static_cast<UInt_t>(qend-q-1) )
+	return kFALSE;
+      UInt_t n = *q++;
+      fPos[type*fNumChan+chan] = fValues.size();
+      fNum[type*fNumChan+chan] = n;
+      fValues.insert( fValues.end(), q, q+n );
+      q += n;
+    }
+  }
+  fMask = mask;
+  return (q == qend);
+}
+
+//_____________________________________________________________________________
+Int_t DecodedModule::GetNumEvents( EModuleType type, Int_t chan ) const
+{
+  if( (fMask & (1U<<type)) == 0 || chan < 0 || chan >= fNumChan )
+    return 0;
+  return fNum[type*fNumChan+chan];
+}
+
+//_____________________________________________________________________________
+Int_t DecodedModule::GetData( EModuleType type, Int_t chan, Int_t hit ) const
+{
+  if( hit < 0 || hit >= GetNumEvents(type,chan) )
+    return 0;
+  return fValues[ fPos[type*fNumChan+chan] + hit ];
+}
+
+//_____________________________________________________________________________
+static UInt_t EncodeModule( Module* module, vector<UInt_t>& record )
+{
+  // Append the processed data of a multi-function module to 'record'
+  // in the format read by DecodedModule::Load. Returns the number of words
+  // appended, or 0 if the module has no data.
+
+  Int_t nchan = module->GetNumChan();
+  if( nchan <= 0 )
+    return 0;
+  size_t pos = record.size();
+  record.push_back(0);
+  record.push_back(nchan);
+  UInt_t mask = 0, ntot = 0;
+  for( Int_t type = 0; type < kNModuleTypes; type++ ) {
+    EModuleType mtype = static_cast<EModuleType>(type);
+    if( !module->HasCapability(mtype) )
+      continue;
+    mask |= 1U<<type;
+    for( Int_t chan = 0; chan < nchan; chan++ ) {
+      Int_t n = module->GetNumEvents(mtype,chan);
+      if( n < 0 ) n = 0;
+      record.push_back(n);
+      for( Int_t i = 0; i < n; i++ )
+	record.push_back( module->GetData(mtype,chan,i) );
+      ntot += n;
+    }
+  }
+  if( ntot == 0 ) {
+    record.resize(pos);
+    return 0;
+  }
+  record[pos] = mask;
+  return record.size()-pos;
+}
+
+//_____________________________________________________________________________
+DecodedEventDecoder::DecodedEventDecoder()
+  : fModules(MAXROC*MAXSLOT,0)
+{
+  // Constructor
+}
+
+//_____________________________________________________________________________
+DecodedEventDecoder::~DecodedEventDecoder()
+{
+  // Destructor
+
+  for( size_t i = 0; i < fModules.size(); ++i )
+    delete fModules[i];
+}
+
+//_____________________________________________________________________________
+UInt_t DecodedEventDecoder::EncodeEvent( const THaEvData& evdata,
+					 vector<UInt_t>& record )
+{
+  // Encode the decoded data of the event currently held by 'evdata' into
+  // 'record'. Only slots with data are stored.
+
+  record.resize(kHeaderLen);
+  UInt_t nslot = 0;
+  for( Int_t i = 0; i < evdata.GetNslots(); i++ ) {
+    THaSlotData* sldat = evdata.GetSlotData(i);
+    size_t pos = record.size();
+    record.resize(pos+kSlotHeaderLen);
+    sldat->getHits(record);
+    UInt_t nhits = (record.size()-pos-kSlotHeaderLen)/3;
+    UInt_t nmod = 0;
+    Module* module = sldat->GetModule();
+    if( module && module->IsMultiFunction() )
+      nmod = EncodeModule( module, record );
+    if( nhits == 0 && nmod == 0 ) {
+      record.resize(pos);
+      continue;
+    }
+    record[pos]   = (sldat->getCrate()<<16) | sldat->getSlot();
+    record[pos+1] = nhits;
+    record[pos+2] = nmod;
+    ++nslot;
+  }
+  ULong64_t evtime = evdata.GetEvTime();
+  record[0] = record.size()-1;
+  record[1] = (evdata.GetEvType()<<16) | kDecodedTag;
+  record[2] = evdata.GetEvNum();
+  record[3] = evdata.GetEvLength();
+  record[4] = static_cast<UInt_t>(evtime);
+  record[5] = static_cast<UInt_t>(evtime>>32);
+  record[6] = nslot;
+  return record.size();
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventDecoder::LoadEvent( const UInt_t* evbuffer )
+{
+  // Load event from 'evbuffer'. Records of decoded data are replayed,
+  // anything else is decoded as a CODA event.
+
+  assert( evbuffer );
+  ClearModules();
+  if( (evbuffer[1] & 0xffff) != kDecodedTag )
+    return CodaRawDecoder::LoadEvent(evbuffer);
+  return LoadDecoded(evbuffer);
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventDecoder::LoadDecoded( const UInt_t* evbuffer )
+{
+  // Replay a record of decoded data
+
+  const char* const here = "DecodedEventDecoder::LoadEvent";
+
+  UInt_t reclen = evbuffer[0]+1;
+  if( reclen < kHeaderLen ) {
+    Error( here, "Record too short (%u words)", reclen );
+    return HED_ERR;
+  }
+  buffer = evbuffer;
+  if( first_decode || fNeedInit ) {
+    Int_t ret = init_cmap();
+    if( ret != HED_OK ) return ret;
+    ret = init_slotdata();
+    if( ret != HED_OK ) return ret;
+    FindUsedSlots();
+    first_decode = kFALSE;
+  }
+  if( fDoBench ) fBench->Begin("clearEvent");
+  for( Int_t i=0; i<fNSlotClear; i++ ) crateslot[fSlotClear[i]]->clearEvent();
+  if( fDoBench ) fBench->Stop("clearEvent");
+  fMultiBlockMode = fBlockIsDone = kFALSE;
+
+  event_type   = evbuffer[1]>>16;
+  event_num    = evbuffer[2];
+  event_length = evbuffer[3];
+  evt_time     = evbuffer[4] | (static_cast<ULong64_t>(evbuffer[5])<<32);
+  recent_event = event_num;
+  UInt_t nslot = evbuffer[6];
+
+  const UInt_t* p = evbuffer + kHeaderLen;
+  const UInt_t* pend = evbuffer + reclen;
+  for( UInt_t i = 0; i < nslot; i++ ) {
+    if( pend-p < static_cast<ptrdiff_t>(kSlotHeaderLen) ) {
+      Error( here, "Corrupt record for event %d", event_num );
+      return HED_ERR;
+    }
+    Int_t  crate = p[0]>>16, slot = p[0]&0xffff;
+    UInt_t nhits = p[1], nmod = p[2];
+    p += kSlotHeaderLen;
+    if( crate >= MAXROC || slot >= MAXSLOT || nhits > kMaxUShort ||
+	static_cast<UInt_t>(pend-p) < 3*nhits+nmod ) {
+      Error( here, "Corrupt record for event %d", event_num );
+      return HED_ERR;
+    }
+    // Skip slots that are not in the current crate map
+    if( !fMap->slotUsed(crate,slot) ) {
+      p += 3*nhits+nmod;
+      continue;
+    }
+    THaSlotData* sldat = crateslot[idx(crate,slot)];
+    sldat->clearEvent();
+    for( UInt_t k = 0; k < nhits; k++, p += 3 )
+      sldat->loadData( p[0], p[1], p[2] );
+    if( nmod > 0 ) {
+      Int_t ret = LoadModule( crate, slot, p, nmod );
+      if( ret != HED_OK )
+	return ret;
+      p += nmod;
+    }
+  }
+  return HED_OK;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventDecoder::LoadModule( Int_t crate, Int_t slot,
+				       const UInt_t* p, UInt_t len )
+{
+  // Load processed data of the multi-function module in crate/slot
+
+  Int_t ix = idx(crate,slot);
+  DecodedModule*& module = fModules[ix];
+  if( !module )
+    module = new DecodedModule(crate,slot);
+  if( !module->Load(p,len) ) {
+    Error( "DecodedEventDecoder::LoadEvent", "Corrupt module data for "
+	   "crate %d, slot %d in event %d", crate, slot, event_num );
+    return HED_ERR;
+  }
+  module->SetActive(kTRUE);
+  fModActive.push_back(ix);
+  return HED_OK;
+}
+
+//_____________________________________________________________________________
+void DecodedEventDecoder::ClearModules()
+{
+  // Deactivate replayed module data of the previous event
+
+  for( size_t i = 0; i < fModActive.size(); ++i )
+    fModules[fModActive[i]]->SetActive(kFALSE);
+  fModActive.clear();
+}
+
+//_____________________________________________________________________________
+Module* DecodedEventDecoder::GetModule( Int_t roc, Int_t slot ) const
+{
+  // Return the module in roc/slot. For multi-function modules with data
+  // in the current record, this is an object holding the replayed data.
+
+  if( roc >= 0 && roc < MAXROC && slot >= 0 && slot < MAXSLOT ) {
+    DecodedModule* module = fModules[idx(roc,slot)];
+    if( module && module->IsActive() )
+      return module;
+  }
+  return CodaRawDecoder::GetModule(roc,slot);
+}
+
+//_____________________________________________________________________________
+
+} // namespace Podd
+
+ClassImp(Podd::DecodedEventDecoder)
@@ -0,0 +1,49 @@
+#ifndef Podd_DecodedEventDecoder_h_
+#define Podd_DecodedEventDecoder_h_
+
+/////////////////////////////////////////////////////////////////////
+//
+//   Podd::DecodedEventDecoder
+//
+//   Decoder that replays events from a file of pre-decoded events
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "CodaRawDecoder.h"
+#include "DecodedEventFile.h"
+#include <vector>
+
+namespace Podd {
+
+class DecodedModule;
+
+class DecodedEventDecoder : public CodaRawDecoder {
+public:
+  DecodedEventDecoder();
+  virtual ~DecodedEventDecoder();
+
+  virtual Int_t LoadEvent( const UInt_t* evbuffer );
+  virtual Decoder::Module* GetModule( Int_t roc, Int_t slot ) const;
+
+  // Encode the decoded contents of the event currently held by 'evdata'
+  // into a record that LoadEvent can replay. Returns the record length.
+  static UInt_t EncodeEvent( const THaEvData& evdata,
+			     std::vector<UInt_t>& record );
+
+  // Low 16 bits of the second word of records with decoded data
+  static const UInt_t kDecodedTag = Decoder::DecodedEventFile::kDecodedTag;
+
+protected:
+  std::vector<DecodedModule*> fModules; // Replayed module data by crate/slot
+  std::vector<Int_t> fModActive;        // crateslot indices of modules in use
+
+  Int_t LoadDecoded( const UInt_t* evbuffer );
+  Int_t LoadModule( Int_t crate, Int_t slot, const UInt_t* p, UInt_t len );
+  void  ClearModules();
+
+  ClassDef(DecodedEventDecoder,0) // Decoder replaying pre-decoded events
+};
+
+} // namespace Podd
+
+#endif
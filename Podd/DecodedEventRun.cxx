@@ -0,0 +1,68 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::DecodedEventRun
+//
+// A run read from a file of pre-decoded events written by
+// Podd::DecodedEventWriter. Use with Podd::DecodedEventDecoder.
+//
+// Run parameters (date, run number, prescales) are found by prescanning
+// the file like for THaRun. Since files of decoded events are not split
+// into segments, the file name suffix is not interpreted as a segment
+// number.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "DecodedEventRun.h"
+#include "DecodedEventFile.h"
+
+using namespace Decoder;
+
+namespace Podd {
+
+//_____________________________________________________________________________
+DecodedEventRun::DecodedEventRun( const char* fname, const char* description )
+  : THaRun(fname,description)
+{
+  // Normal & default constructor
+
+  delete fCodaData;
+  fCodaData = new DecodedEventFile;
+  fSegment = 0;
+}
+
+//_____________________________________________________________________________
+DecodedEventRun::DecodedEventRun( const DecodedEventRun& rhs ) :
+  THaRun(rhs)
+{
+  // Copy ctor
+
+  delete fCodaData;
+  fCodaData = new DecodedEventFile;
+  fSegment = 0;
+}
+
+//_____________________________________________________________________________
+DecodedEventRun& DecodedEventRun::operator=( const THaRunBase& rhs )
+{
+  // Assignment operator
+
+  if( this != &rhs ) {
+    THaRun::operator=(rhs);
+    delete fCodaData;
+    fCodaData = new DecodedEventFile;
+    fSegment = 0;
+  }
+  return *this;
+}
+
+//_____________________________________________________________________________
+DecodedEventRun::~DecodedEventRun()
+{
+  // Destructor
+}
+
+//_____________________________________________________________________________
+
+} // namespace Podd
+
+ClassImp(Podd::DecodedEventRun)
@@ -0,0 +1,27 @@
+#ifndef Podd_DecodedEventRun_h_
+#define Podd_DecodedEventRun_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::DecodedEventRun
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "THaRun.h"
+
+namespace Podd {
+
+class DecodedEventRun : public THaRun {
+
+public:
+  DecodedEventRun( const char* filename="", const char* description="" );
+  DecodedEventRun( const DecodedEventRun& run );
+  virtual DecodedEventRun& operator=( const THaRunBase& rhs );
+  virtual ~DecodedEventRun();
+
+  ClassDef(DecodedEventRun,1)  // A run based on a file of pre-decoded events
+};
+
+} // namespace Podd
+
+#endif
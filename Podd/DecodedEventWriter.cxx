@@ -0,0 +1,121 @@
+/////////////////////////////////////////////////////////////////////
+//
+//   Podd::DecodedEventWriter
+//
+//   Post-processing module that writes every event it sees to a file
+//   of pre-decoded events, which can be replayed much faster than the
+//   original CODA file with Podd::DecodedEventRun and
+//   Podd::DecodedEventDecoder:
+//
+//     analyzer->AddPostProcess( new Podd::DecodedEventWriter("run.dec") );
+//
+//   Physics events are written as decoded crate/slot data, all others
+//   as the original CODA event. See DecodedEventDecoder for details.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "DecodedEventWriter.h"
+#include "DecodedEventDecoder.h"
+#include "DecodedEventFile.h"
+#include "THaRunBase.h"
+#include "THaEvData.h"
+// only for ERetVal, used by Process(). Should put ERetVal in a separate header
+#include "THaAnalyzer.h"
+
+using namespace std;
+using namespace Decoder;
+
+namespace Podd {
+
+//_____________________________________________________________________________
+DecodedEventWriter::DecodedEventWriter( const char* filename ) :
+  fFileName(filename), fOut(0)
+{
+  // Constructor
+
+  // This module returns compatible return codes
+  SetBit(kUseReturnCode);
+}
+
+//_____________________________________________________________________________
+DecodedEventWriter::~DecodedEventWriter()
+{
+  // Destructor
+
+  Close();
+  delete fOut;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventWriter::Close()
+{
+  // Close the output file
+
+  if( !fOut ) return 0;
+  fIsInit = 0;
+  return fOut->codaClose();
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventWriter::Init( const TDatime& )
+{
+  // Open the output file
+
+  const char* const here = "DecodedEventWriter::Init";
+
+  if( fIsInit )
+    return 0;
+
+  if( !fOut )
+    fOut = new DecodedEventFile;
+  if( fOut->codaOpen(fFileName, "w") != CODA_OK ) {
+    Error( here, "Cannot open file %s for writing.", fFileName.Data() );
+    return -3;
+  }
+  fIsInit = 1;
+  return 0;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventWriter::Process( const THaEvData* evdata,
+				   const THaRunBase* run, Int_t /* code */ )
+{
+  // Write the current event. Physics events are encoded from the decoded
+  // data in 'evdata', all others are copied from the run's event buffer.
+
+  const char* const here = "DecodedEventWriter::Process";
+
+  if( !fIsInit || !evdata )
+    return THaAnalyzer::kOK;
+
+  if( fOut->getCodaVersion() == 0 )
+    fOut->setCodaVersion( evdata->GetDataVersion() );
+
+  const UInt_t* rec = 0;
+  if( evdata->IsPhysicsTrigger() ) {
+    if( DecodedEventDecoder::EncodeEvent(*evdata, fRecord) > MAXEVLEN ) {
+      Error( here, "Record for event %d too long (%u words). Event not "
+	     "written", evdata->GetEvNum(), static_cast<UInt_t>(fRecord.size()) );
+      return THaAnalyzer::kOK;
+    }
+    rec = &fRecord[0];
+  } else
+    rec = run->GetEvBuffer();
+
+  Int_t ret = fOut->codaWrite(rec);
+  if( ret == CODA_FATAL ) {
+    Error( here, "Fatal error writing to file %s. Check if you have "
+	   "write permission and enough disk space", fFileName.Data() );
+    return THaAnalyzer::kFatal;
+  } else if( ret != CODA_OK ) {
+    Error( here, "Error writing to file %s. Event %d not written",
+	   fFileName.Data(), evdata->GetEvNum() );
+  }
+  return THaAnalyzer::kOK;
+}
+
+//_____________________________________________________________________________
+
+} // namespace Podd
+
+ClassImp(Podd::DecodedEventWriter)
@@ -0,0 +1,43 @@
+#ifndef Podd_DecodedEventWriter_h_
+#define Podd_DecodedEventWriter_h_
+
+/////////////////////////////////////////////////////////////////////
+//
+//   Podd::DecodedEventWriter
+//
+//   Post-processing module writing decoded events to a file
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "THaPostProcess.h"
+#include "TString.h"
+#include "Decoder.h"
+#include <vector>
+
+namespace Decoder {
+  class DecodedEventFile;
+}
+
+namespace Podd {
+
+class DecodedEventWriter : public THaPostProcess {
+ public:
+  DecodedEventWriter( const char* filename );
+  virtual ~DecodedEventWriter();
+
+  virtual Int_t Init(const TDatime&);
+  virtual Int_t Process( const THaEvData*, const THaRunBase*, Int_t code );
+  virtual Int_t Close();
+
+ protected:
+  TString   fFileName;   // Name of output file
+  Decoder::DecodedEventFile* fOut; // The output file
+  std::vector<UInt_t> fRecord;     // Record buffer
+
+ public:
+  ClassDef(DecodedEventWriter,0)
+};
+
+} // namespace Podd
+
+#endif
@@ -0,0 +1,196 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::ElossTable
+//
+// Energy loss per unit length (dE/dx, GeV/m) of electrons or singly
+// charged hadrons in a given medium, tabulated at equidistant points in
+// ln(beta*gamma) and linearly interpolated. The values are those of
+// THaElossCorrection::ElossElectron and ElossHadron, which depend only on
+// beta and are proportional to the pathlength (and, for hadrons, to the
+// square of the charge), so a single table per medium serves all
+// particle masses and pathlengths.
+//
+// When a table is built, the interpolation is compared with the analytic
+// result halfway between all table points, and the point density is
+// doubled until the largest relative deviation is below kTolerance.
+// Outside of the tabulated beta*gamma range, the analytic functions are
+// used directly.
+//
+// Tables are shared. Get() returns the table for a given particle type
+// and medium, building it on first use. Get() is meant to be called
+// during initialization and is not thread-safe; lookups are.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "ElossTable.h"
+#include "THaElossCorrection.h"
+#include "TMath.h"
+#include <map>
+
+using namespace std;
+
+namespace Podd {
+
+const Double_t ElossTable::kTolerance = 1e-4;
+
+// Tabulated range of beta*gamma, initial number of points per unit of
+// ln(beta*gamma), and maximum number of points per table
+static const Double_t kBGmin = 0.2;
+static const Double_t kBGmax = 1e5;
+static const UInt_t   kNperUnit = 20;
+static const UInt_t   kMaxPoints = 1U<<18;
+
+namespace {
+  struct MediumKey {
+    MediumKey( Bool_t el, Double_t z, Double_t a, Double_t d )
+      : electron(el), z_med(z), a_med(a), d_med(d) {}
+    Bool_t   electron;
+    Double_t z_med, a_med, d_med;
+    bool operator<( const MediumKey& rhs ) const {
+      if( electron != rhs.electron ) return electron < rhs.electron;
+      if( z_med != rhs.z_med )       return z_med < rhs.z_med;
+      if( a_med != rhs.a_med )       return a_med < rhs.a_med;
+      return d_med < rhs.d_med;
+    }
+  };
+  typedef map<MediumKey,ElossTable*> TableCache_t;
+  TableCache_t fgTables;  // Unsupported media are cached as null
+}
+
+//_____________________________________________________________________________
+ElossTable::ElossTable( Bool_t electron, Double_t z_med, Double_t a_med,
+			Double_t d_med )
+  : fElectron(electron), fZmed(z_med), fAmed(a_med), fDensity(d_med),
+    fXmin(TMath::Log(kBGmin)), fXmax(TMath::Log(kBGmax)), fInvStep(0),
+    fMaxError(THaAnalysisObject::kBig)
+{
+  // Constructor. Builds the table with the required accuracy, if possible.
+
+  // Analytic() returns zero everywhere for unknown media (with a warning)
+  if( Analytic(1.0) == 0.0 )
+    return;
+  UInt_t npoints = static_cast<UInt_t>( kNperUnit*(fXmax-fXmin) ) + 1;
+  while( !Build(npoints) && 2*npoints-1 <= kMaxPoints )
+    npoints = 2*npoints-1;
+}
+
+//_____________________________________________________________________________
+Double_t ElossTable::Analytic( Double_t betagamma ) const
+{
+  // Energy loss per meter (GeV/m) from the analytic formulas
+
+  Double_t beta = betagamma / TMath::Sqrt(1.0 + betagamma*betagamma);
+  if( fElectron )
+    return THaElossCorrection::ElossElectron( beta, fZmed, fAmed,
+					      fDensity, 1.0 );
+  return THaElossCorrection::ElossHadron( 1, beta, fZmed, fAmed,
+					  fDensity, 1.0 );
+}
+
+//_____________________________________________________________________________
+Bool_t ElossTable::Build( UInt_t npoints )
+{
+  // Fill the table with 'npoints' points and check the interpolation
+  // halfway between them. Returns true if the accuracy is sufficient.
+
+  Double_t step = (fXmax-fXmin)/(npoints-1);
+  fInvStep = 1.0/step;
+  fTable.resize(npoints);
+  Double_t peak = 0;
+  for( UInt_t i = 0; i < npoints; i++ ) {
+    fTable[i] = Analytic( TMath::Exp(fXmin + i*step) );
+    peak = TMath::Max( peak, TMath::Abs(fTable[i]) );
+  }
+  // Avoid dividing by near-zero values where the stopping power changes sign
+  Double_t floor = 1e-6*peak;
+  fMaxError = 0;
+  for( UInt_t i = 0; i+1 < npoints; i++ ) {
+    Double_t x = fXmin + (i+0.5)*step;
+    Double_t exact = Analytic( TMath::Exp(x) );
+    Double_t err = TMath::Abs(Interpolate(x)-exact) /
+      TMath::Max( TMath::Abs(exact), floor );
+    fMaxError = TMath::Max( fMaxError, err );
+  }
+  return (fMaxError < kTolerance);
+}
+
+//_____________________________________________________________________________
+Double_t ElossTable::Interpolate( Double_t x ) const
+{
+  // Linear interpolation in the table at ln(beta*gamma) = x
+
+  Double_t u = (x-fXmin)*fInvStep;
+  UInt_t i = static_cast<UInt_t>(u);
+  if( i+1 >= fTable.size() )
+    i = static_cast<UInt_t>(fTable.size()) - 2;
+  Double_t f = u-i;
+  return fTable[i] + f*(fTable[i+1]-fTable[i]);
+}
+
+//_____________________________________________________________________________
+Double_t ElossTable::GetdEdx( Double_t betagamma ) const
+{
+  // Energy loss per meter (GeV/m) of a singly charged particle with the
+  // given beta*gamma
+
+  if( betagamma <= 0.0 )
+    return 0.0;
+  Double_t x = TMath::Log(betagamma);
+  if( x < fXmin || x > fXmax )
+    return Analytic(betagamma);
+  return Interpolate(x);
+}
+
+//_____________________________________________________________________________
+Double_t ElossTable::GetEloss( Double_t p, Double_t m, Double_t pathlength,
+			       Int_t Z ) const
+{
+  // Energy loss (GeV) of a particle with momentum p (GeV/c), mass m
+  // (GeV/c^2) and, for hadrons, charge Z over the given pathlength (m).
+  // Same as ElossElectron/ElossHadron for beta = p/sqrt(p^2+m^2).
+
+  if( p <= 0.0 || m <= 0.0 || pathlength == 0.0 )
+    return 0.0;
+  Double_t dEdx = GetdEdx( p/m );
+  if( !fElectron )
+    dEdx *= Double_t(Z*Z);
+  return dEdx * pathlength;
+}
+
+//_____________________________________________________________________________
+const ElossTable* ElossTable::Get( Bool_t electron, Double_t z_med,
+				   Double_t a_med, Double_t d_med )
+{
+  // Return the shared table for the given particle type and medium.
+  // Returns null if the analytic formulas do not support the medium or
+  // the table cannot be built with the required accuracy.
+
+  MediumKey key( electron, z_med, a_med, d_med );
+  TableCache_t::iterator it = fgTables.find(key);
+  if( it != fgTables.end() )
+    return it->second;
+
+  ElossTable* table = 0;
+  if( z_med != 0.0 && a_med != 0.0 ) {
+    table = new ElossTable( electron, z_med, a_med, d_med );
+    if( table->fMaxError >= kTolerance ) {
+      delete table;
+      table = 0;
+    }
+  }
+  fgTables.insert( make_pair(key,table) );
+  return table;
+}
+
+//_____________________________________________________________________________
+void ElossTable::ClearCache()
+{
+  // Delete all shared tables
+
+  for( TableCache_t::iterator it = fgTables.begin(); it != fgTables.end();
+       ++it )
+    delete it->second;
+  fgTables.clear();
+}
+
+} // namespace Podd
@@ -0,0 +1,61 @@
+#ifndef Podd_ElossTable_h_
+#define Podd_ElossTable_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::ElossTable
+//
+// Tabulated energy loss per unit length versus beta*gamma for one medium
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+
+namespace Podd {
+
+  class ElossTable {
+
+  public:
+    // Shared table for the given particle type and medium, built on first
+    // use. Returns null if the medium is not supported.
+    static const ElossTable* Get( Bool_t electron, Double_t z_med,
+				  Double_t a_med, Double_t d_med );
+    static void  ClearCache();
+
+    // Energy loss (GeV) over 'pathlength' (m) of a particle with momentum
+    // p (GeV/c), mass m (GeV/c^2) and charge Z (hadrons only)
+    Double_t     GetEloss( Double_t p, Double_t m, Double_t pathlength,
+			   Int_t Z = 1 ) const;
+    // Energy loss per unit length (GeV/m) of a singly charged particle
+    Double_t     GetdEdx( Double_t betagamma ) const;
+
+    Bool_t       IsElectron()  const { return fElectron; }
+    UInt_t       GetNpoints()  const { return static_cast<UInt_t>(fTable.size()); }
+    // Largest relative deviation from the analytic result found at setup
+    Double_t     GetMaxError() const { return fMaxError; }
+
+    static const Double_t kTolerance; // Target relative accuracy
+
+  private:
+    ElossTable( Bool_t electron, Double_t z_med, Double_t a_med,
+		Double_t d_med );
+
+    Double_t     Analytic( Double_t betagamma ) const;
+    Bool_t       Build( UInt_t npoints );
+    Double_t     Interpolate( Double_t x ) const;
+
+    Bool_t       fElectron;   // Electron (true) or hadron table
+    Double_t     fZmed;       // Effective Z of medium
+    Double_t     fAmed;       // Effective A of medium
+    Double_t     fDensity;    // Density of medium (g/cm^3)
+    Double_t     fXmin;       // ln(beta*gamma) of first table point
+    Double_t     fXmax;       // ln(beta*gamma) of last table point
+    Double_t     fInvStep;    // 1/(step in ln(beta*gamma))
+    Double_t     fMaxError;
+    std::vector<Double_t> fTable; // dE/dx (GeV/m) at equidistant ln(beta*gamma)
+  };
+
+} // namespace Podd
+
+#endif
@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::EventArena
+//
+// Memory pool for objects that are needed only while an event is being
+// reconstructed, such as candidate combinations in tracking. Objects are
+// created with placement new,
+//
+//   THaVDCPointPair* pair = new(fArena) THaVDCPointPair(...);
+//
+// and are all released at once with Reset(), typically from the owner's
+// Clear() at the end of the event. Reset() takes constant time and keeps
+// the memory, so after the first few events no further allocations occur,
+// and objects created one after the other are adjacent in memory.
+//
+// Destructors are never called. Only objects that do not own resources
+// (heap memory, etc.) may be put into an arena. This excludes TObjects,
+// which register themselves with ROOT (object table, cleanup lists, TRefs)
+// and must be destroyed properly. Objects that are written out via global
+// variables belong in TClonesArrays as before.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "EventArena.h"
+#include <cstdlib>
+#include <new>
+
+namespace Podd {
+
+//_____________________________________________________________________________
+EventArena::EventArena( size_t chunksize )
+  : fChunkSize(chunksize), fCur(0), fPos(0)
+{
+  // Constructor. No memory is allocated until the first Allocate().
+}
+
+//_____________________________________________________________________________
+EventArena::~EventArena()
+{
+  // Destructor. Frees all memory. Destructors of the objects in the
+  // arena are not called.
+
+  for( size_t i = 0; i < fChunks.size(); ++i )
+    free( fChunks[i].fBuf );
+}
+
+//_____________________________________________________________________________
+void* EventArena::AllocateSlow( size_t size )
+{
+  // Allocate from the next chunk that is large enough. Adds a new chunk
+  // if necessary. Chunks skipped here are reused after the next Reset().
+
+  if( fCur < fChunks.size() && fPos > 0 )
+    ++fCur;
+  while( fCur < fChunks.size() && fChunks[fCur].fSize < size )
+    ++fCur;
+  if( fCur == fChunks.size() ) {
+    Chunk c;
+    c.fSize = (size > fChunkSize) ? size : fChunkSize;
+    c.fBuf  = static_cast<char*>( malloc(c.fSize) );
+    if( !c.fBuf )
+      throw std::bad_alloc();
+    fChunks.push_back(c);
+  }
+  fPos = size;
+  return fChunks[fCur].fBuf;
+}
+
+//_____________________________________________________________________________
+size_t EventArena::GetCapacity() const
+{
+  // Total memory held by the arena (bytes)
+
+  size_t n = 0;
+  for( size_t i = 0; i < fChunks.size(); ++i )
+    n += fChunks[i].fSize;
+  return n;
+}
+
+} // namespace Podd
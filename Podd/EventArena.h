@@ -0,0 +1,70 @@
+#ifndef Podd_EventArena_h_
+#define Podd_EventArena_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::EventArena
+//
+// Bump allocator for transient objects that live for one event
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+#include <cstddef>
+
+namespace Podd {
+
+  class EventArena {
+
+  public:
+    explicit EventArena( size_t chunksize = 65536 );
+    ~EventArena();
+
+    void*    Allocate( size_t size );
+    // Release all objects at once. Destructors are not called.
+    void     Reset() { fCur = 0; fPos = 0; }
+    size_t   GetCapacity() const;
+
+  private:
+    struct Chunk {
+      char*  fBuf;
+      size_t fSize;
+    };
+    std::vector<Chunk> fChunks;
+    size_t   fChunkSize;  // Default size of new chunks (bytes)
+    size_t   fCur;        // Index of current chunk
+    size_t   fPos;        // Next free byte in current chunk
+
+    void*    AllocateSlow( size_t size );
+
+    EventArena( const EventArena& );
+    EventArena& operator=( const EventArena& );
+  };
+
+  //___________________________________________________________________________
+  inline void* EventArena::Allocate( size_t size )
+  {
+    // Return 'size' bytes of storage, aligned for any type
+
+    const size_t kAlign = 2*sizeof(Double_t);
+    size = (size + kAlign-1) & ~(kAlign-1);
+    if( fCur < fChunks.size() && fPos + size <= fChunks[fCur].fSize ) {
+      void* p = fChunks[fCur].fBuf + fPos;
+      fPos += size;
+      return p;
+    }
+    return AllocateSlow(size);
+  }
+
+} // namespace Podd
+
+// Placement new for objects in an arena: new(arena) T(args)
+inline void* operator new( size_t size, Podd::EventArena& arena )
+{
+  return arena.Allocate(size);
+}
+// Called only if the constructor throws
+inline void operator delete( void*, Podd::EventArena& ) {}
+
+#endif
@@ -6,25 +6,113 @@
 //
 // A "global variable" referencing a class member function call
 //
+// By default, the function is called via TMethodCall (i.e. the
+// interpreter). Classes may register compiled accessors for their getters
+// with the PODD_REGISTER_ACCESSORS macro (see THaTrack.cxx). If an accessor with
+// a matching return type is registered for the method, it is bound when the
+// variable is defined and used instead of TMethodCall for every evaluation.
+//
 //////////////////////////////////////////////////////////////////////////
 
 #include "MethodVar.h"
 #include "THaVar.h"
 #include "TError.h"
 #include "TMethodCall.h"
+#include "TMethod.h"
+#include "TClass.h"
 #include <cstring> // for memcpy
 #include <cassert>
 #include <cmath>
 #include <limits>
+#include <map>
+#include <string>
 
 using namespace std;
 
 namespace Podd {
 
+//_____________________________________________________________________________
+struct AccessorInfo {
+  AccessorInfo() : fType(kVarTypeEnd), fFunc(0) {}
+  AccessorInfo( VarType type, MethodAccessor_t func )
+    : fType(type), fFunc(func) {}
+  VarType          fType;
+  MethodAccessor_t fFunc;
+};
+typedef map<string,AccessorInfo> AccessorMap_t;
+
+//_____________________________________________________________________________
+static AccessorMap_t& GetAccessorMap()
+{
+  // Registry of compiled accessors. Function-local so that it is constructed
+  // before any static registration in other translation units uses it.
+
+  static AccessorMap_t accessors;
+  return accessors;
+}
+
+//_____________________________________________________________________________
+static string AccessorKey( const char* classname, const char* method )
+{
+  string key(classname);
+  key.append("::").append(method);
+  return key;
+}
+
+//_____________________________________________________________________________
+Bool_t MethodVar::AddAccessor( const char* classname, const char* method,
+			       VarType type, MethodAccessor_t func )
+{
+  // Register compiled accessor 'func' for member function 'method' of class
+  // 'classname', returning data of 'type'. Most classes register a table
+  // of accessors via AddAccessors instead.
+
+  if( !classname || !*classname || !method || !*method || !func ) {
+    ::Error( "MethodVar::AddAccessor", "Invalid arguments" );
+    return kFALSE;
+  }
+  GetAccessorMap()[AccessorKey(classname,method)] = AccessorInfo(type,func);
+  return kTRUE;
+}
+
+//_____________________________________________________________________________
+Bool_t MethodVar::AddAccessors( const MethodAccessorDef* defs )
+{
+  // Register the compiled accessors in 'defs', a table terminated by an
+  // entry with classname = 0. Typically called from a static initializer
+  // via the PODD_REGISTER_ACCESSORS macro.
+
+  if( !defs )
+    return kFALSE;
+  Bool_t ok = kTRUE;
+  for( ; defs->classname; ++defs ) {
+    if( !AddAccessor(defs->classname, defs->method, defs->type, defs->func) )
+      ok = kFALSE;
+  }
+  return ok;
+}
+
+//_____________________________________________________________________________
+MethodAccessor_t MethodVar::FindAccessor( const char* classname,
+					  const char* method, VarType type )
+{
+  // Find compiled accessor for member function 'method' of class 'classname'.
+  // Returns 0 if none is registered or if its return type is not 'type'.
+
+  if( !classname || !method )
+    return 0;
+  const AccessorMap_t& accessors = GetAccessorMap();
+  AccessorMap_t::const_iterator it =
+    accessors.find( AccessorKey(classname,method) );
+  if( it == accessors.end() || it->second.fType != type )
+    return 0;
+  return it->second.fFunc;
+}
+
 //_____________________________________________________________________________
 MethodVar::MethodVar( THaVar* pvar, const void* addr,
 		      VarType type, TMethodCall* method )
-  : Variable(pvar,addr,type), fMethod(method), fData(0)
+  : Variable(pvar,addr,type), fMethod(method), fAccessor(0), fData(0)
 {
   // Constructor
   assert( fMethod );
@@ -33,6 +121,13 @@ MethodVar::MethodVar( THaVar* pvar, const void* addr,
     fValueP = 0;
     return;
   }
+
+  // Use a compiled accessor, if one is registered for the class that
+  // declares the method. Like TMethodCall, this assumes that the object
+  // address is also the address of the declaring class subobject.
+  TMethod* m = dynamic_cast<TMethod*>( fMethod->GetMethod() );
+  if( m && m->GetClass() )
+    fAccessor = FindAccessor( m->GetClass()->GetName(), m->GetName(), fType );
 }
 
 //_____________________________________________________________________________
@@ -67,6 +162,11 @@ const void* MethodVar::GetDataPointer( const void* obj ) const
 {
   // Make the method call on the object pointed to by 'obj'
 
+  if( fAccessor ) {
+    fAccessor( obj, &fData );
+    return &fData;
+  }
+
   void* pobj = const_cast<void*>(obj);  // TMethodCall wants a non-const object...
 
   if( IsFloat() ) {
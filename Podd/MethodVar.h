@@ -15,6 +15,39 @@ class TMethodCall;
 
 namespace Podd {
 
+  // Compiled accessor for a member function returning basic data. Calls the
+  // function on 'obj' and stores the result in 'result' as the native type.
+  typedef void (*MethodAccessor_t)( const void* obj, void* result );
+
+  template< class C, typename R, R (C::*M)() const >
+  void CallMethod( const void* obj, void* result )
+  {
+    *static_cast<R*>(result) = (static_cast<const C*>(obj)->*M)();
+  }
+
+  // VarType corresponding to a method return type. Must agree with the
+  // type mapping in THaVarList::DefineByRTTI, else the accessor is not used.
+  template< typename R > struct MethodVarType;
+
+  // Entry in a table of compiled accessors, see PODD_REGISTER_ACCESSORS
+  struct MethodAccessorDef {
+    const char*      classname;
+    const char*      method;
+    VarType          type;
+    MethodAccessor_t func;
+  };
+  template<> struct MethodVarType<Double_t> { static const VarType kType = kDouble; };
+  template<> struct MethodVarType<Float_t>  { static const VarType kType = kFloat;  };
+  template<> struct MethodVarType<Long_t>   { static const VarType kType = kLong;   };
+  template<> struct MethodVarType<ULong_t>  { static const VarType kType = kULong;  };
+  template<> struct MethodVarType<Int_t>    { static const VarType kType = kInt;    };
+  template<> struct MethodVarType<UInt_t>   { static const VarType kType = kUInt;   };
+  template<> struct MethodVarType<Short_t>  { static const VarType kType = kShort;  };
+  template<> struct MethodVarType<UShort_t> { static const VarType kType = kUShort; };
+  template<> struct MethodVarType<Char_t>   { static const VarType kType = kChar;   };
+  template<> struct MethodVarType<UChar_t>  { static const VarType kType = kUChar;  };
+  template<> struct MethodVarType<Bool_t>   { static const VarType kType = kChar;   };
+
   class MethodVar : virtual public Variable {
 
   public:
@@ -25,8 +58,19 @@ namespace Podd {
     virtual const void*  GetDataPointer( Int_t i = 0 ) const;
     virtual Bool_t       IsBasic() const;
 
+    Bool_t               IsCompiled() const { return fAccessor != 0; }
+
+    // Registry of compiled accessors, keyed by class and method name
+    static Bool_t           AddAccessor( const char* classname,
+					 const char* method, VarType type,
+					 MethodAccessor_t func );
+    static Bool_t           AddAccessors( const MethodAccessorDef* defs );
+    static MethodAccessor_t FindAccessor( const char* classname,
+					  const char* method, VarType type );
+
   protected:
     TMethodCall*         fMethod;   //Member function to access data in object
+    MethodAccessor_t     fAccessor; //Compiled accessor for fMethod, if any
     // Data cache, filled in GetDataPointer()
     mutable Double_t     fData;     //Function call result (interpretation depends on fType!)
 
@@ -35,4 +79,24 @@ namespace Podd {
 
 }// namespace Podd
 
+// Compiled accessor for the argument-less const member function
+// CLASS::METHOD returning RTYPE. Method variables bound to this function
+// call it directly instead of through TMethodCall. Used in tables that are
+// registered with PODD_REGISTER_ACCESSORS at file scope, e.g.
+//
+//   static const Podd::MethodAccessorDef accessors[] = {
+//     PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetLabPx ),
+//     ...
+//     { 0 }
+//   };
+//   PODD_REGISTER_ACCESSORS( accessors );
+#define PODD_METHOD_ACCESSOR(CLASS,RTYPE,METHOD)			\
+  { #CLASS, #METHOD, Podd::MethodVarType<RTYPE>::kType,			\
+    &Podd::CallMethod<CLASS,RTYPE,&CLASS::METHOD> }
+
+// Register a table of compiled accessors when the library is loaded
+#define PODD_REGISTER_ACCESSORS(DEFS)					\
+  static const Bool_t fgAccessorsRegistered =				\
+    Podd::MethodVar::AddAccessors( DEFS )
+
 #endif
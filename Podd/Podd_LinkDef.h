@@ -112,6 +112,9 @@
 #pragma link C++ class Podd::MCTrackPoint+;
 #pragma link C++ class Podd::SimDecoder+;
 #pragma link C++ class Podd::CodaRawDecoder+;
+#pragma link C++ class Podd::DecodedEventDecoder+;
+#pragma link C++ class Podd::DecodedEventRun+;
+#pragma link C++ class Podd::DecodedEventWriter+;
 
 #ifdef ONLINE_ET
 #pragma link C++ class THaOnlRun+;
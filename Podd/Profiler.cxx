@@ -0,0 +1,275 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::Profiler
+//
+// Hierarchical timer for the analysis event loop. Replaces the string-keyed
+// lookups of THaBenchmark with probes that are defined once and then
+// referred to by index.
+//
+// Probes are defined with DefineProbe() during setup. Start(id)/Stop(id)
+// accumulate the elapsed time, the number of calls and the longest call,
+// using a monotonic nanosecond clock. A probe started while another one is
+// running is recorded as its child only if it was defined that way;
+// StartChild() defines such children on the fly, which is convenient for
+// loops over modules whose names are only known at run time.
+//
+// BeginEvent()/EndEvent() time complete events. The event latencies are
+// collected in a histogram with logarithmic bins (powers of 2 in ns).
+// The time spent in each probe during the current event is available
+// from GetEventTime() until the next BeginEvent().
+//
+// Print() shows the probe tree on the terminal. Write() saves all results
+// to a JSON file for automated comparisons.
+//
+// While the analyzer runs with benchmarks enabled, its profiler is
+// available via Profiler::GetActive(), so that apparatuses can time
+// their detectors.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Profiler.h"
+#include <iostream>
+#include <fstream>
+#include <iomanip>
+#include <cstring>
+#include <cstdio>
+
+using namespace std;
+
+namespace Podd {
+
+Profiler* Profiler::fgActive = 0;
+
+//_____________________________________________________________________________
+Profiler::Profiler()
+{
+  // Constructor
+
+  Reset();
+}
+
+//_____________________________________________________________________________
+Int_t Profiler::FindProbe( const char* name, Int_t parent ) const
+{
+  // Return index of probe 'name' under 'parent', or -1 if not found
+
+  if( !name )
+    return -1;
+  for( Int_t i = 0; i < GetNprobes(); ++i ) {
+    const Probe& p = fProbes[i];
+    if( p.fParent == parent && p.fName == name )
+      return i;
+  }
+  return -1;
+}
+
+//_____________________________________________________________________________
+Int_t Profiler::DefineProbe( const char* name, Int_t parent )
+{
+  // Define a new probe with the given name under 'parent' (-1 = top level).
+  // If such a probe already exists, return its index.
+
+  if( !name || parent >= GetNprobes() )
+    return -1;
+  Int_t id = FindProbe( name, parent );
+  if( id < 0 ) {
+    id = GetNprobes();
+    fProbes.push_back( Probe(name,parent) );
+  }
+  return id;
+}
+
+//_____________________________________________________________________________
+Int_t Profiler::FindChild( Int_t parent, Int_t index, const char* name )
+{
+  // Slow path of StartChild: look up or define the child probe 'name'
+  // of 'parent' and remember it in the parent's slot 'index'
+
+  Int_t id = DefineProbe( name ? name : "(unnamed)", parent );
+  vector<Int_t>& ch = (parent < 0) ? fTopChild : fProbes[parent].fChild;
+  vector<const char*>& nm = (parent < 0) ? fTopChildName
+    : fProbes[parent].fChildName;
+  if( index >= 0 ) {
+    if( index >= static_cast<Int_t>(ch.size()) ) {
+      ch.resize( index+1, -1 );
+      nm.resize( index+1, 0 );
+    }
+    ch[index] = id;
+    nm[index] = name;
+  }
+  return id;
+}
+
+//_____________________________________________________________________________
+void Profiler::BeginEvent()
+{
+  // Start timing an event. Ends the previous event, if still open.
+
+  if( fInEvent )
+    EndEvent();
+  fStack.clear();
+  for( vector<Probe>::iterator it = fProbes.begin(); it != fProbes.end();
+       ++it ) {
+    it->fEvent = 0;
+  }
+  fInEvent = kTRUE;
+  fEventStart = Now();
+}
+
+//_____________________________________________________________________________
+ULong64_t Profiler::EndEvent()
+{
+  // Finish timing the current event and record its latency.
+  // Returns the latency (ns), or 0 if no event was being timed.
+
+  if( !fInEvent )
+    return 0;
+  ULong64_t dt = Now() - fEventStart, latency = dt;
+  fInEvent = kFALSE;
+  ++fNevents;
+  fEventTotal += dt;
+  if( dt < fEventMin ) fEventMin = dt;
+  if( dt > fEventMax ) fEventMax = dt;
+  Int_t bin = 0;
+  while( (dt >>= 1) != 0 )
+    ++bin;
+  ++fLatency[bin];
+  return latency;
+}
+
+//_____________________________________________________________________________
+void Profiler::Reset()
+{
+  // Clear all results. Probe definitions are kept.
+
+  for( vector<Probe>::iterator it = fProbes.begin(); it != fProbes.end();
+       ++it ) {
+    it->fStart = it->fTotal = it->fMax = it->fCalls = it->fEvent = 0;
+  }
+  fStack.clear();
+  fInEvent = kFALSE;
+  fEventStart = fNevents = fEventTotal = fEventMax = 0;
+  fEventMin = static_cast<ULong64_t>(-1);
+  memset( fLatency, 0, sizeof(fLatency) );
+}
+
+//_____________________________________________________________________________
+void Profiler::PrintProbe( Int_t id, Int_t level ) const
+{
+  // Print statistics for probe 'id' and, recursively, its children
+
+  const Probe& p = fProbes[id];
+  if( p.fCalls > 0 ) {
+    string name = string(2*level,' ') + p.fName;
+    Double_t frac = 100.;
+    if( p.fParent >= 0 && fProbes[p.fParent].fTotal > 0 )
+      frac = 100.*p.fTotal/fProbes[p.fParent].fTotal;
+    cout << left << setw(32) << name << right
+	 << setw(12) << p.fCalls
+	 << setw(12) << fixed << setprecision(3) << 1e-9*p.fTotal
+	 << setw(12) << setprecision(2) << 1e-3*p.fTotal/p.fCalls
+	 << setw(12) << 1e-3*p.fMax;
+    if( level > 0 )
+      cout << setw(8) << setprecision(1) << frac << "%";
+    cout << endl;
+  }
+  for( Int_t i = id+1; i < GetNprobes(); ++i ) {
+    if( fProbes[i].fParent == id )
+      PrintProbe( i, level+1 );
+  }
+}
+
+//_____________________________________________________________________________
+void Profiler::Print() const
+{
+  // Print timing summary
+
+  cout << left << setw(32) << "Section" << right
+       << setw(12) << "Calls"
+       << setw(12) << "Total (s)"
+       << setw(12) << "Mean (us)"
+       << setw(12) << "Max (us)"
+       << setw(9)  << "Parent" << endl;
+  for( Int_t i = 0; i < GetNprobes(); ++i ) {
+    if( fProbes[i].fParent < 0 )
+      PrintProbe( i, 0 );
+  }
+  if( fNevents > 0 ) {
+    cout << "Event latency: " << fNevents << " events, "
+	 << "mean " << fixed << setprecision(2)
+	 << 1e-3*fEventTotal/fNevents << " us, "
+	 << "min " << 1e-3*fEventMin << " us, "
+	 << "max " << 1e-3*fEventMax << " us" << endl;
+    for( Int_t i = 0; i < kNbins; ++i ) {
+      if( fLatency[i] == 0 ) continue;
+      cout << "  < " << setw(12) << setprecision(1)
+	   << 1e-3*(static_cast<ULong64_t>(2)<<i) << " us: "
+	   << setw(12) << fLatency[i] << endl;
+    }
+  }
+  cout.unsetf( ios::floatfield );
+  cout << setprecision(6);
+}
+
+//_____________________________________________________________________________
+static string JSONString( const string& s )
+{
+  // Return 's' as a quoted JSON string
+
+  string r = "\"";
+  for( string::size_type i = 0; i < s.size(); ++i ) {
+    char c = s[i];
+    if( c == '"' || c == '\\' ) {
+      r += '\\'; r += c;
+    } else if( static_cast<unsigned char>(c) < 0x20 ) {
+      char buf[8];
+      sprintf( buf, "\\u%04x", c );
+      r += buf;
+    } else
+      r += c;
+  }
+  r += '"';
+  return r;
+}
+
+//_____________________________________________________________________________
+Int_t Profiler::Write( const char* filename ) const
+{
+  // Write all results to 'filename' in JSON format. Times are in ns.
+  // Probes are listed in order of definition; "parent" is the index of
+  // the parent probe or -1. Latency bin i counts events with latencies
+  // in [2^i,2^(i+1)) ns. Returns 0 on success, -1 on error.
+
+  if( !filename || !*filename )
+    return -1;
+  ofstream ofs(filename);
+  if( !ofs ) {
+    cerr << "Podd::Profiler: Cannot open output file " << filename << endl;
+    return -1;
+  }
+  ofs << "{" << endl << "  \"probes\": [" << endl;
+  for( Int_t i = 0; i < GetNprobes(); ++i ) {
+    const Probe& p = fProbes[i];
+    ofs << "    { \"id\": " << i
+	<< ", \"name\": " << JSONString(p.fName)
+	<< ", \"parent\": " << p.fParent
+	<< ", \"calls\": " << p.fCalls
+	<< ", \"total_ns\": " << p.fTotal
+	<< ", \"max_ns\": " << p.fMax << " }"
+	<< (i+1 < GetNprobes() ? "," : "") << endl;
+  }
+  ofs << "  ]," << endl
+      << "  \"events\": {" << endl
+      << "    \"count\": " << fNevents << "," << endl
+      << "    \"total_ns\": " << fEventTotal << "," << endl
+      << "    \"min_ns\": " << (fNevents > 0 ? fEventMin : 0) << "," << endl
+      << "    \"max_ns\": " << fEventMax << "," << endl
+      << "    \"latency_log2_ns\": [";
+  for( Int_t i = 0; i < kNbins; ++i )
+    ofs << (i > 0 ? ", " : "") << fLatency[i];
+  ofs << "]" << endl << "  }" << endl << "}" << endl;
+
+  return ofs.good() ? 0 : -1;
+}
+
+} // namespace Podd
@@ -0,0 +1,173 @@
+#ifndef Podd_Profiler_h_
+#define Podd_Profiler_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::Profiler
+//
+// Low-overhead hierarchical timer for the event loop
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <ctime>
+#include <string>
+#include <vector>
+
+namespace Podd {
+
+  class Profiler {
+
+  public:
+    Profiler();
+
+    // Setup. Probes are identified by the index returned here.
+    Int_t        DefineProbe( const char* name, Int_t parent = -1 );
+    Int_t        FindProbe( const char* name, Int_t parent = -1 ) const;
+    Int_t        GetNprobes() const { return static_cast<Int_t>(fProbes.size()); }
+    const char*  GetName( Int_t id ) const { return fProbes[id].fName.c_str(); }
+    Int_t        GetParent( Int_t id ) const { return fProbes[id].fParent; }
+
+    // Timing
+    void         Start( Int_t id );
+    void         Stop( Int_t id );
+    Int_t        StartChild( Int_t index, const char* name );
+    void         BeginEvent();
+    ULong64_t    EndEvent();
+    void         CancelEvent() { fInEvent = kFALSE; }
+    Bool_t       IsInEvent() const { return fInEvent; }
+
+    // Results
+    ULong64_t    GetCalls( Int_t id ) const { return fProbes[id].fCalls; }
+    Double_t     GetTime( Int_t id )  const { return 1e-9*fProbes[id].fTotal; }
+    ULong64_t    GetNevents()         const { return fNevents; }
+    // Time spent in probe 'id' during the current (or last) event (ns)
+    ULong64_t    GetEventTime( Int_t id ) const { return fProbes[id].fEvent; }
+    void         Print() const;
+    void         Reset();
+    Int_t        Write( const char* filename ) const;
+
+    // Profiler to be used by modules called from the event loop, if any
+    static Profiler* GetActive() { return fgActive; }
+    static void      SetActive( Profiler* p ) { fgActive = p; }
+
+    static ULong64_t Now();
+
+    enum { kNbins = 64 };  // Latency histogram bins (powers of 2 in ns)
+
+  protected:
+    struct Probe {
+      Probe( const char* name, Int_t parent )
+	: fName(name), fParent(parent), fStart(0), fTotal(0), fMax(0),
+	  fCalls(0), fEvent(0) {}
+      std::string  fName;    // Name of the timed section
+      Int_t        fParent;  // Index of parent probe, -1 if top level
+      ULong64_t    fStart;   // Start time of current call (ns)
+      ULong64_t    fTotal;   // Accumulated time (ns)
+      ULong64_t    fMax;     // Longest single call (ns)
+      ULong64_t    fCalls;   // Number of calls
+      ULong64_t    fEvent;   // Time in current event (ns)
+      std::vector<Int_t>       fChild;     // Children by StartChild index
+      std::vector<const char*> fChildName; // Name used to define fChild[i]
+    };
+
+    std::vector<Probe> fProbes;   // All probes, in order of definition
+    std::vector<Int_t> fStack;    // Currently running probes
+    std::vector<Int_t> fTopChild; // Top-level probes by StartChild index
+    std::vector<const char*> fTopChildName;
+
+    // Per-event latency
+    Bool_t       fInEvent;        // BeginEvent called, but not EndEvent
+    ULong64_t    fEventStart;     // Start time of current event (ns)
+    ULong64_t    fNevents;        // Number of events timed
+    ULong64_t    fEventTotal;     // Sum of event latencies (ns)
+    ULong64_t    fEventMin;       // Shortest event (ns)
+    ULong64_t    fEventMax;       // Longest event (ns)
+    ULong64_t    fLatency[kNbins];// Events per latency bin [2^i,2^(i+1)) ns
+
+    Int_t        FindChild( Int_t parent, Int_t index, const char* name );
+    void         PrintProbe( Int_t id, Int_t level ) const;
+
+    static Profiler* fgActive;
+  };
+
+  //___________________________________________________________________________
+  inline ULong64_t Profiler::Now()
+  {
+    // Current time in ns from a monotonic clock
+
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return static_cast<ULong64_t>(ts.tv_sec)*1000000000 + ts.tv_nsec;
+  }
+
+  //___________________________________________________________________________
+  inline void Profiler::Start( Int_t id )
+  {
+    fStack.push_back(id);
+    fProbes[id].fStart = Now();
+  }
+
+  //___________________________________________________________________________
+  inline void Profiler::Stop( Int_t id )
+  {
+    // Stop probe 'id'. Any probes started after 'id' and still running,
+    // e.g. because of an exception, are discarded.
+
+    ULong64_t now = Now();
+    Probe& p = fProbes[id];
+    ULong64_t dt = now - p.fStart;
+    p.fTotal += dt;
+    p.fEvent += dt;
+    ++p.fCalls;
+    if( dt > p.fMax )
+      p.fMax = dt;
+    while( !fStack.empty() ) {
+      Int_t top = fStack.back();
+      fStack.pop_back();
+      if( top == id )
+	break;
+    }
+  }
+
+  //___________________________________________________________________________
+  inline Int_t Profiler::StartChild( Int_t index, const char* name )
+  {
+    // Start the index-th child probe of the currently running probe,
+    // defining it with the given name on first use. Intended for loops
+    // over modules, where 'index' is the position in the loop.
+    // Returns the probe id to pass to Stop().
+
+    Int_t parent = fStack.empty() ? -1 : fStack.back();
+    const std::vector<Int_t>& ch = (parent < 0) ? fTopChild
+      : fProbes[parent].fChild;
+    const std::vector<const char*>& nm = (parent < 0) ? fTopChildName
+      : fProbes[parent].fChildName;
+    Int_t id;
+    if( index < static_cast<Int_t>(ch.size()) && nm[index] == name )
+      id = ch[index];
+    else
+      id = FindChild( parent, index, name );
+    Start(id);
+    return id;
+  }
+
+  //___________________________________________________________________________
+  class ProbeScope {
+    // Times the enclosing scope as a child of the running probe.
+    // Does nothing if 'profiler' is null.
+  public:
+    ProbeScope( Profiler* profiler, Int_t index, const char* name )
+      : fProfiler(profiler),
+	fId( profiler ? profiler->StartChild(index,name) : -1 ) {}
+    ~ProbeScope() { if( fProfiler ) fProfiler->Stop(fId); }
+  private:
+    Profiler* fProfiler;
+    Int_t     fId;
+    ProbeScope( const ProbeScope& );
+    ProbeScope& operator=( const ProbeScope& );
+  };
+
+} // namespace Podd
+
+#endif
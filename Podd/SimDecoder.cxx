@@ -9,6 +9,7 @@
 #include "SimDecoder.h"
 #include "THaVarList.h"
 #include "THaGlobals.h"
+#include "MethodVar.h"
 #include <iostream>
 
 using namespace std;
@@ -21,6 +22,21 @@ const char* const MC_PREFIX = "MC.";
 // Default half-size of search window for reconstructed hits (m)
 Double_t MCTrackPoint::fgWindowSize = 1e-3;
 
+//_____________________________________________________________________________
+static const Podd::MethodAccessorDef accessors[] = {
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, X        ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, Y        ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, ThetaT   ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, PhiT     ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, R        ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, Theta    ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, Phi      ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, ThetaDir ),
+  PODD_METHOD_ACCESSOR( Podd::MCTrackPoint, Double_t, PhiDir   ),
+  { 0 }
+};
+PODD_REGISTER_ACCESSORS( accessors );
+
 //_____________________________________________________________________________
 SimDecoder::SimDecoder()
   : fWeight(1.0), fMCHits(0), fMCTracks(0), fIsSetup(false)
@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::SlowEventList
+//
+// Keeps the N events with the longest analysis time seen during a replay,
+// as measured by Podd::Profiler. For each event, the event number and type,
+// the time spent in each profiler probe and a copy of the raw event data
+// are saved. The raw data can be written to a CODA file with Write() so
+// that the events can be replayed offline.
+//
+// Only events that qualify (see IsSlow()) are copied, so the per-event
+// cost is a single comparison once the list is full.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "SlowEventList.h"
+#include "Profiler.h"
+#include "THaEvData.h"
+#include "THaCodaFile.h"
+#include <iostream>
+#include <iomanip>
+#include <algorithm>
+
+using namespace std;
+
+namespace Podd {
+
+//_____________________________________________________________________________
+struct SlowerThan {
+  // Heap ordering: the fastest of the kept events is at the front
+  bool operator()( const SlowEventList::Entry& a,
+		   const SlowEventList::Entry& b ) const
+  { return a.fLatency > b.fLatency; }
+};
+
+//_____________________________________________________________________________
+static bool ByLatency( const SlowEventList::Entry* a,
+		       const SlowEventList::Entry* b )
+{
+  return a->fLatency > b->fLatency;
+}
+
+//_____________________________________________________________________________
+static bool ByEvNum( const SlowEventList::Entry* a,
+		     const SlowEventList::Entry* b )
+{
+  return a->fEvNum < b->fEvNum;
+}
+
+//_____________________________________________________________________________
+void SlowEventList::Add( ULong64_t latency, const THaEvData& evdata,
+			 const Profiler& prof )
+{
+  // Add the event currently held by 'evdata' if it is one of the fNmax
+  // slowest so far. 'latency' is its total analysis time in ns.
+  // The per-probe times are taken from 'prof'.
+
+  if( !IsSlow(latency) )
+    return;
+
+  // Reuse the storage of the entry being replaced
+  if( fEntries.size() < fNmax )
+    fEntries.push_back( Entry() );
+  else
+    pop_heap( fEntries.begin(), fEntries.end(), SlowerThan() );
+  Entry& e = fEntries.back();
+
+  e.fLatency = latency;
+  e.fEvNum   = evdata.GetEvNum();
+  e.fEvType  = evdata.GetEvType();
+  e.fTimes.resize( prof.GetNprobes() );
+  for( Int_t i = 0; i < prof.GetNprobes(); ++i )
+    e.fTimes[i] = prof.GetEventTime(i);
+  const UInt_t* buf = evdata.GetRawDataBuffer();
+  Int_t len = evdata.GetEvLength();
+  if( buf && len > 0 )
+    e.fBuffer.assign( buf, buf+len );
+  else
+    e.fBuffer.clear();
+
+  push_heap( fEntries.begin(), fEntries.end(), SlowerThan() );
+}
+
+//_____________________________________________________________________________
+void SlowEventList::GetSorted( vector<const Entry*>& sorted ) const
+{
+  // Get pointers to the kept entries, slowest first
+
+  sorted.clear();
+  for( vector<Entry>::const_iterator it = fEntries.begin();
+       it != fEntries.end(); ++it )
+    sorted.push_back( &*it );
+  sort( sorted.begin(), sorted.end(), ByLatency );
+}
+
+//_____________________________________________________________________________
+void SlowEventList::Print( const Profiler& prof ) const
+{
+  // Print the kept events, slowest first, with the times of the top-level
+  // profiler probes and of their slowest child
+
+  if( fEntries.empty() )
+    return;
+  vector<const Entry*> sorted;
+  GetSorted( sorted );
+
+  cout << "Slowest " << sorted.size() << " events:" << endl;
+  cout << fixed << setprecision(1);
+  for( size_t k = 0; k < sorted.size(); ++k ) {
+    const Entry& e = *sorted[k];
+    cout << "  Event " << setw(9) << e.fEvNum
+	 << "  type " << setw(3) << e.fEvType
+	 << "  " << setw(7) << e.fBuffer.size() << " words"
+	 << "  " << setw(12) << 1e-3*e.fLatency << " us" << endl;
+    Int_t n = min( prof.GetNprobes(), static_cast<Int_t>(e.fTimes.size()) );
+    for( Int_t i = 0; i < n; ++i ) {
+      if( prof.GetParent(i) >= 0 || e.fTimes[i] == 0 )
+	continue;
+      Int_t slowest = -1;
+      for( Int_t j = i+1; j < n; ++j ) {
+	if( prof.GetParent(j) == i && e.fTimes[j] > 0 &&
+	    (slowest < 0 || e.fTimes[j] > e.fTimes[slowest]) )
+	  slowest = j;
+      }
+      cout << "    " << left << setw(20) << prof.GetName(i) << right
+	   << setw(12) << 1e-3*e.fTimes[i] << " us";
+      if( slowest >= 0 )
+	cout << "  (" << prof.GetName(slowest) << ": "
+	     << 1e-3*e.fTimes[slowest] << " us)";
+      cout << endl;
+    }
+  }
+  cout.unsetf( ios::floatfield );
+  cout << setprecision(6);
+}
+
+//_____________________________________________________________________________
+Int_t SlowEventList::Write( const char* filename ) const
+{
+  // Write the raw data of the kept events to CODA file 'filename',
+  // in order of event number. Returns the number of events written,
+  // or -1 on error.
+
+  if( !filename || !*filename )
+    return -1;
+  vector<const Entry*> sorted;
+  GetSorted( sorted );
+
+  Decoder::THaCodaFile file;
+  if( file.codaOpen(filename, "w", 1) != 0 ) {
+    cerr << "Podd::SlowEventList: Cannot open CODA file " << filename
+	 << " for writing" << endl;
+    return -1;
+  }
+  sort( sorted.begin(), sorted.end(), ByEvNum );
+  Int_t nwritten = 0;
+  for( size_t k = 0; k < sorted.size(); ++k ) {
+    if( sorted[k]->fBuffer.empty() )
+      continue;
+    if( file.codaWrite(&sorted[k]->fBuffer[0]) != 0 ) {
+      nwritten = -1;
+      break;
+    }
+    ++nwritten;
+  }
+  file.codaClose();
+  return nwritten;
+}
+
+} // namespace Podd
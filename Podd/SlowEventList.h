@@ -0,0 +1,62 @@
+#ifndef Podd_SlowEventList_h_
+#define Podd_SlowEventList_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::SlowEventList
+//
+// The N slowest events of a replay, with their raw data
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+
+class THaEvData;
+
+namespace Podd {
+
+  class Profiler;
+
+  class SlowEventList {
+
+  public:
+    explicit SlowEventList( UInt_t nmax = 0 ) : fNmax(nmax) {}
+
+    struct Entry {
+      ULong64_t  fLatency;  // Total event time (ns)
+      UInt_t     fEvNum;    // Event number
+      Int_t      fEvType;   // Event type
+      std::vector<ULong64_t> fTimes;  // Time per profiler probe (ns)
+      std::vector<UInt_t>    fBuffer; // Raw event data
+    };
+
+    void      Add( ULong64_t latency, const THaEvData& evdata,
+		   const Profiler& prof );
+    void      Clear()         { fEntries.clear(); }
+    UInt_t    GetMax()  const { return fNmax; }
+    UInt_t    GetSize() const { return static_cast<UInt_t>(fEntries.size()); }
+    Bool_t    IsSlow( ULong64_t latency ) const;
+    void      Print( const Profiler& prof ) const;
+    void      SetMax( UInt_t nmax ) { fNmax = nmax; Clear(); }
+    Int_t     Write( const char* filename ) const;
+
+  protected:
+    UInt_t             fNmax;     // Maximum number of events to keep
+    std::vector<Entry> fEntries;  // Min-heap on fLatency
+
+    void      GetSorted( std::vector<const Entry*>& sorted ) const;
+  };
+
+  //___________________________________________________________________________
+  inline Bool_t SlowEventList::IsSlow( ULong64_t latency ) const
+  {
+    // True if an event with the given latency would be kept
+
+    return fNmax > 0 &&
+      (fEntries.size() < fNmax || latency > fEntries.front().fLatency);
+  }
+
+} // namespace Podd
+
+#endif
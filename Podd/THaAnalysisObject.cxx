@@ -243,6 +243,8 @@ THaAnalysisObject* THaAnalysisObject::FindModule( const char* name,
   // to kInitError.
   // If do_error == false, don't print error messages and not test if object is
   // initialized.
+  // The module found is recorded in fInputModules, from which the analyzer
+  // determines the dependencies between physics modules.
   //
   // This function is intended to be called from physics module initialization
   // routines.
@@ -313,6 +315,9 @@ THaAnalysisObject* THaAnalysisObject::FindModule( const char* name,
       return NULL;
     }
   }
+  if( find(fInputModules.begin(), fInputModules.end(), aobj) ==
+      fInputModules.end() )
+    fInputModules.push_back( aobj );
   return aobj;
 }
 
@@ -639,6 +644,9 @@ Int_t THaAnalysisObject::InitOutput( THaOutput* /* output */ )
   // all is okay, and return 0
   //
   // anything else will trigger error messages.
+  //
+  // In histogram-only mode (output->IsHistogramsOnly()), there is no tree.
+  // Modules should then skip their tree output and still return 0.
   fOKOut = true;
   return kOK;
 }
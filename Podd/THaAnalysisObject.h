@@ -48,6 +48,10 @@ public:
           const char*  GetConfig() const         { return fConfig.Data(); }
           Int_t        GetDebug() const          { return fDebug; }
           const char*  GetPrefix() const         { return fPrefix; }
+  // Modules located with FindModule(), i.e. inputs of this module
+  const std::vector<THaAnalysisObject*>& GetInputModules() const
+  { return fInputModules; }
+          void         ClearInputModules()       { fInputModules.clear(); }
           EStatus      Init();
   virtual EStatus      Init( const TDatime& run_time );
           Bool_t       IsInit() const            { return IsOK(); }
@@ -147,6 +151,8 @@ protected:
   std::map<std::string,UInt_t> fMessages; // Warning messages & count
   UInt_t          fNEventsWithWarnings;   // Events with warnings
 
+  std::vector<THaAnalysisObject*> fInputModules; //! Found with FindModule
+
   TObject*        fExtra;     // Additional member data (for binary compat.)
 
   virtual Int_t        DefineVariables( EMode mode = kDefine );
@@ -33,6 +33,9 @@
 #include "THaPhysicsModule.h"
 #include "THaPostProcess.h"
 #include "THaBenchmark.h"
+#include "Profiler.h"
+#include "SlowEventList.h"
+#include "TaskPool.h"
 #include "THaEvtTypeHandler.h"
 #include "THaEpicsEvtHandler.h"
 #include "TList.h"
@@ -54,6 +57,9 @@
 #include <cstring>
 #include <exception>
 #include <stdexcept>
+#include <set>
+#include <map>
+#include <string>
 
 using namespace std;
 using namespace Decoder;
@@ -67,6 +73,99 @@ const int MAXCOUNTER = 200; // Sanity limit on number of counters
 // Pointer to single instance of this object
 THaAnalyzer* THaAnalyzer::fgAnalyzer = 0;
 
+//_____________________________________________________________________________
+class THaAnalyzer::ModuleTask : public Podd::TaskPool::Task {
+  // Processes one module for the current event. Used to process several
+  // modules concurrently, see SetParallelApps() and SetParallelPhysics().
+  // Exceptions are recorded and re-thrown in the main thread by RunTasks().
+public:
+  ModuleTask( THaAnalysisObject* module )
+    : fModule(module), fEvData(0), fFailed(false), fLevel(0) {}
+  virtual ~ModuleTask() {}
+  virtual void Run();
+  virtual void Process() = 0;
+  static bool LevelLess( const ModuleTask* a, const ModuleTask* b )
+  { return a->fLevel < b->fLevel; }
+
+  THaAnalysisObject* fModule;
+  const THaEvData*   fEvData;
+  bool               fFailed;  // Run() caught an exception
+  string             fError;   // Exception message
+  Int_t              fLevel;   // Scheduling level (physics modules)
+};
+
+//_____________________________________________________________________________
+void THaAnalyzer::ModuleTask::Run()
+{
+  try {
+    Process();
+  }
+  catch( exception& e ) {
+    fFailed = true;
+    fError = e.what();
+  }
+  catch( ... ) {
+    fFailed = true;
+    fError = "unknown exception";
+  }
+}
+
+//_____________________________________________________________________________
+class THaAnalyzer::AppTask : public THaAnalyzer::ModuleTask {
+  // Runs one analysis stage of one apparatus
+public:
+  AppTask( THaApparatus* app ) : ModuleTask(app), fStage(-1) {}
+  virtual void Process()
+  { RunStage( static_cast<THaApparatus*>(fModule), fStage, *fEvData ); }
+  static void RunStage( THaApparatus* app, Int_t stage,
+			const THaEvData& evdata );
+
+  Int_t fStage;
+};
+
+//_____________________________________________________________________________
+void THaAnalyzer::AppTask::RunStage( THaApparatus* app, Int_t stage,
+				     const THaEvData& evdata )
+{
+  // Run analysis stage 'stage' for apparatus 'app'
+
+  switch( stage ) {
+  case kDecode:
+    app->Clear();
+    app->Decode( evdata );
+    break;
+  case kCoarseTrack:
+    if( THaSpectrometer* spectro = dynamic_cast<THaSpectrometer*>(app) )
+      spectro->CoarseTrack();
+    break;
+  case kCoarseRecon:
+    app->CoarseReconstruct();
+    break;
+  case kTracking:
+    if( THaSpectrometer* spectro = dynamic_cast<THaSpectrometer*>(app) )
+      spectro->Track();
+    break;
+  case kReconstruct:
+    app->Reconstruct();
+    break;
+  }
+}
+
+//_____________________________________________________________________________
+class THaAnalyzer::PhysTask : public THaAnalyzer::ModuleTask {
+  // Processes one physics module
+public:
+  PhysTask( THaPhysicsModule* module ) : ModuleTask(module), fRetval(0) {}
+  virtual void Process()
+  {
+    THaPhysicsModule* theModule = static_cast<THaPhysicsModule*>(fModule);
+    theModule->Clear();
+    fRetval = theModule->Process( *fEvData );
+  }
+
+  Int_t fRetval;  // Return value of Process()
+};
+
 //FIXME:
 // do we need to "close" scalers/EPICS analysis if we reach the event limit?
 
@@ -76,13 +175,16 @@ THaAnalyzer::THaAnalyzer() :
   fOdefFileName(kDefaultOdefFile), fEvent(NULL), fNStages(0), fNCounters(0),
   fWantCodaVers(-1),
   fStages(NULL), fCounters(NULL), fNev(0), fMarkInterval(1000), fCompress(1),
-  fVerbose(2), fCountMode(kCountRaw), fBench(NULL), fPrevEvent(NULL),
+  fVerbose(2), fCountMode(kCountRaw), fBench(NULL), fProfiler(NULL),
+  fSlowEvents(NULL), fNAppThreads(1), fNPhysThreads(1), fTaskPool(NULL),
+  fAppTasks(NULL), fNAppTasks(0), fPhysTasks(NULL), fNPhysTasks(0),
+  fPrevEvent(NULL),
   fRun(NULL), fEvData(NULL), fApps(NULL), fPhysics(NULL),
-  fPostProcess(NULL), fEvtHandlers(NULL),
-  fIsInit(kFALSE), fAnalysisStarted(kFALSE), fLocalEvent(kFALSE),
+  fPostProcess(NULL), fEvtHandlers(NULL), fActiveApps(NULL),
+  fActivePhysics(NULL), fIsInit(kFALSE), fAnalysisStarted(kFALSE), fLocalEvent(kFALSE),
   fUpdateRun(kTRUE), fOverwrite(kTRUE), fDoBench(kFALSE),
   fDoHelicity(kFALSE), fDoPhysics(kTRUE), fDoOtherEvents(kTRUE),
-  fDoSlowControl(kTRUE), fFirstPhysics(true), fExtra(0)
+  fDoSlowControl(kTRUE), fDoHistOnly(kFALSE), fFirstPhysics(true), fExtra(0)
 
 {
   // Default constructor.
@@ -99,6 +201,8 @@ THaAnalyzer::THaAnalyzer() :
   fApps    = gHaApps;
   fPhysics = gHaPhysics;
   fEvtHandlers = gHaEvtHandlers;
+  fActiveApps    = new TList;
+  fActivePhysics = new TList;
 
   // EPICs data
   fEpicsHandler = new THaEpicsEvtHandler("epics","EPICS event type");
@@ -108,6 +212,14 @@ THaAnalyzer::THaAnalyzer() :
 
   // Timers
   fBench = new THaBenchmark;
+  fProfiler = new Podd::Profiler;
+  const char* const probes[kNProbes] = {
+    "Init", "RawDecode", "Decode", "CoarseTracking", "CoarseReconstruct",
+    "Tracking", "Reconstruct", "Physics", "Output", "Cuts", "PostProcess"
+  };
+  for( Int_t i = 0; i < kNProbes; ++i )
+    fProfiler->DefineProbe( probes[i] );
+  fSlowEvents = new Podd::SlowEventList;
 }
 
 //_____________________________________________________________________________
@@ -118,7 +230,11 @@ THaAnalyzer::~THaAnalyzer()
   Close();
   delete fExtra; fExtra = 0;
   delete fPostProcess;  //deletes PostProcess objects
+  delete fActiveApps;
+  delete fActivePhysics;
   delete fBench;
+  delete fProfiler;
+  delete fSlowEvents;
   delete [] fStages;
   delete [] fCounters;
   if( fgAnalyzer == this )
@@ -193,6 +309,7 @@ void THaAnalyzer::Close()
   if( gHaRun && *gHaRun == *fRun )
     gHaRun = NULL;
 
+  DeleteTaskPool();
   delete fEvData; fEvData = NULL;
   delete fOutput; fOutput = NULL;
   if( TROOT::Initialized() )
@@ -256,12 +373,69 @@ void THaAnalyzer::EnableBenchmarks( Bool_t b )
   fDoBench = b;
 }
 
+//_____________________________________________________________________________
+void THaAnalyzer::SetSlowEventCapture( UInt_t nevents, const char* codafile )
+{
+  // Keep the 'nevents' slowest events of each replay and print their
+  // timing at the end of Process(). If 'codafile' is given, also write
+  // their raw data to that CODA file for offline reproduction.
+  // Event timing requires benchmarks, so these are enabled if nevents > 0.
+
+  fSlowEvents->SetMax( nevents );
+  fSlowEventFileName = codafile;
+  if( nevents > 0 )
+    fDoBench = kTRUE;
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::SetParallelApps( UInt_t nthreads )
+{
+  // Process up to 'nthreads' apparatuses of each event concurrently.
+  // Each of the stages Decode, CoarseTracking, CoarseReconstruct, Tracking
+  // and Reconstruct runs for all apparatuses in parallel and completes
+  // before the stage's tests are evaluated, so cuts behave as in serial
+  // processing. Only use this if the apparatuses are independent, i.e.
+  // no apparatus or detector uses results of another one before the
+  // Reconstruct stage has finished. Per-apparatus timing (see
+  // EnableBenchmarks) is not available in this mode.
+  // 0 or 1 (default) means serial processing.
+  // Takes effect at the next Init().
+
+  fNAppThreads = (nthreads > 0) ? nthreads : 1;
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::SetParallelPhysics( UInt_t nthreads )
+{
+  // Process up to 'nthreads' physics modules of each event concurrently.
+  // The modules are ordered by the inputs they locate during Init (see
+  // SchedulePhysics), and modules that do not depend on each other are
+  // processed in parallel. If the dependencies cannot be determined
+  // consistently, the modules are processed in list order. Per-module
+  // timing is not available in this mode.
+  // 0 or 1 (default) means serial processing.
+  // Takes effect at the next Init().
+
+  fNPhysThreads = (nthreads > 0) ? nthreads : 1;
+}
+
 //_____________________________________________________________________________
 void THaAnalyzer::EnableHelicity( Bool_t b )
 {
   fDoHelicity = b;
 }
 
+//_____________________________________________________________________________
+void THaAnalyzer::EnableHistogramsOnly( Bool_t b )
+{
+  // Histogram-only mode, e.g. for online monitoring. No output tree is
+  // written, and apparatuses and physics modules that the histograms and
+  // tests do not depend on are not processed. See SelectModules().
+  // Takes effect at the next Init() that creates the output.
+
+  fDoHistOnly = b;
+}
+
 //_____________________________________________________________________________
 void THaAnalyzer::EnableRunUpdate( Bool_t b )
 {
@@ -307,7 +481,7 @@ bool THaAnalyzer::EvalStage( int n )
   // If event is skipped, increment associated statistics counter.
   // Call InitCuts() before using!  This is an internal function.
 
-  if( fDoBench ) fBench->Begin("Cuts");
+  if( fDoBench ) fProfiler->Start(kPrCuts);
 
   const Stage_t* theStage = fStages+n;
 
@@ -326,10 +500,316 @@ bool THaAnalyzer::EvalStage( int n )
       ret = false;
     }
   }
-  if( fDoBench ) fBench->Stop("Cuts");
+  if( fDoBench ) fProfiler->Stop(kPrCuts);
   return ret;
 }
 
+//_____________________________________________________________________________
+static Bool_t UsesPrefix( const set<string>& names, const char* prefix )
+{
+  // True if any of the variable names begins with 'prefix'
+
+  if( !prefix || !*prefix )
+    return kTRUE;
+  size_t len = strlen(prefix);
+  // Names beginning with prefix sort contiguously from lower_bound(prefix)
+  set<string>::const_iterator it = names.lower_bound(prefix);
+  return ( it != names.end() && it->compare(0,len,prefix) == 0 );
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::SelectModules()
+{
+  // Set up the lists of apparatuses and physics modules to be processed for
+  // each event. Normally, these are all modules.
+  //
+  // In histogram-only mode, modules are skipped if none of their global
+  // variables are used by the histograms or tests. Since a physics module
+  // may depend on the results of any module processed before it, all
+  // physics modules up to the last needed one are kept, and apparatuses
+  // are only skipped if no physics module is needed. With post-processing
+  // modules defined, nothing is skipped.
+
+  fActiveApps->Clear();
+  fActivePhysics->Clear();
+  if( !fDoHistOnly || !fOutput || !fOutput->IsHistogramsOnly() ||
+      (fPostProcess && !fPostProcess->IsEmpty()) ) {
+    fActiveApps->AddAll( fApps );
+    fActivePhysics->AddAll( fPhysics );
+    return;
+  }
+
+  set<string> names;
+  fOutput->GetHistogramVars( names );
+  if( const THashList* cuts = gHaCuts->GetCutList() ) {
+    TIter nextc( cuts );
+    while( THaCut* cut = static_cast<THaCut*>(nextc()) )
+      cut->GetVarNames( names );
+  }
+
+  TObject* last_needed = 0;
+  TIter nextp( fPhysics );
+  while( THaAnalysisObject* obj = static_cast<THaAnalysisObject*>(nextp()) ) {
+    if( UsesPrefix(names, obj->GetPrefix()) )
+      last_needed = obj;
+  }
+  if( last_needed ) {
+    nextp.Reset();
+    TObject* obj;
+    while( (obj = nextp()) ) {
+      fActivePhysics->Add( obj );
+      if( obj == last_needed )
+	break;
+    }
+  }
+  TIter nexta( fApps );
+  while( THaAnalysisObject* obj = static_cast<THaAnalysisObject*>(nexta()) ) {
+    if( last_needed || UsesPrefix(names, obj->GetPrefix()) )
+      fActiveApps->Add( obj );
+  }
+
+  if( fVerbose > 1 ) {
+    Int_t nskip = fApps->GetSize() + fPhysics->GetSize()
+      - fActiveApps->GetSize() - fActivePhysics->GetSize();
+    cout << "Histogram-only mode: processing " << fActiveApps->GetSize()
+	 << " apparatus(es) and " << fActivePhysics->GetSize()
+	 << " physics module(s), skipping " << nskip << endl;
+  }
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::InitTaskPool()
+{
+  // Set up the tasks and threads for concurrent processing of apparatuses
+  // and physics modules, if requested with SetParallelApps() and
+  // SetParallelPhysics(). Also checks the dependencies between the
+  // physics modules (see SchedulePhysics).
+
+  DeleteTaskPool();
+
+  // The main thread runs tasks as well
+  UInt_t nthreads = 1;
+  Int_t napps = fActiveApps->GetSize();
+  if( fNAppThreads > 1 && napps > 1 ) {
+    nthreads = TMath::Min( fNAppThreads, static_cast<UInt_t>(napps) );
+    fAppTasks = new ModuleTask*[napps];
+    TIter next(fActiveApps);
+    while( THaApparatus* app = static_cast<THaApparatus*>(next()) )
+      fAppTasks[fNAppTasks++] = new AppTask(app);
+    if( fVerbose > 1 )
+      cout << "Processing " << napps << " apparatuses in " << nthreads
+	   << " threads" << endl;
+  }
+
+  Int_t width = SchedulePhysics();
+  if( fNPhysThreads > 1 && width > 1 ) {
+    UInt_t nphys = TMath::Min( fNPhysThreads, static_cast<UInt_t>(width) );
+    nthreads = TMath::Max( nthreads, nphys );
+    if( fVerbose > 1 )
+      cout << "Processing " << fNPhysTasks << " physics modules in "
+	   << fPhysTasks[fNPhysTasks-1]->fLevel+1 << " steps with up to "
+	   << nphys << " threads" << endl;
+  } else {
+    for( Int_t i = 0; i < fNPhysTasks; ++i )
+      delete fPhysTasks[i];
+    delete [] fPhysTasks; fPhysTasks = NULL;
+    fNPhysTasks = 0;
+  }
+
+  if( nthreads > 1 )
+    fTaskPool = new Podd::TaskPool( nthreads-1 );
+}
+
+//_____________________________________________________________________________
+Int_t THaAnalyzer::SchedulePhysics()
+{
+  // Order the active physics modules by their dependencies. Each module is
+  // assigned a level such that it comes after all the modules it depends
+  // on. Modules of the same level may be processed concurrently.
+  //
+  // A module depends on the modules that it located with FindModule()
+  // during initialization. Modules using the same spectrometer are kept in
+  // list order, since physics modules may modify the spectrometer's tracks
+  // (THaReactionPoint sets the track vertex, for example). A module that
+  // did not locate any other module may depend on anything, so it comes
+  // after all modules before it, and all later modules come after it.
+  //
+  // The tasks are put in fPhysTasks, sorted by level. Returns the largest
+  // number of modules in a level, or 0 if a module depends on a module that
+  // is processed after it (a misordered replay script), in which case the
+  // modules must be run in list order.
+
+  static const char* const here = "SchedulePhysics";
+
+  Int_t n = fActivePhysics->GetSize();
+  if( n == 0 )
+    return 0;
+  fPhysTasks = new ModuleTask*[n];
+
+  map<const THaAnalysisObject*,Int_t> level;       // Level of each module
+  map<const THaAnalysisObject*,Int_t> spectro_level;// Last level using spectro
+  Int_t base = 0, maxlevel = -1;
+  bool ok = true;
+  TIter next(fActivePhysics);
+  while( THaPhysicsModule* mod = static_cast<THaPhysicsModule*>(next()) ) {
+    const vector<THaAnalysisObject*>& inputs = mod->GetInputModules();
+    Int_t lev = base;
+    if( inputs.empty() ) {
+      lev = base = maxlevel+1;
+      ++base;
+    }
+    for( vector<THaAnalysisObject*>::size_type i = 0; i < inputs.size(); ++i ) {
+      const THaAnalysisObject* in = inputs[i];
+      map<const THaAnalysisObject*,Int_t>::iterator it = level.find(in);
+      if( it != level.end() )
+	lev = TMath::Max( lev, it->second+1 );
+      else if( fPhysics->FindObject(in) ) {
+	Warning( here, "Physics module %s uses module %s, which is processed "
+		 "after it. Check the order of modules in the replay script.",
+		 mod->GetName(), in->GetName() );
+	ok = false;
+      }
+      else if( dynamic_cast<const THaSpectrometer*>(in) ) {
+	it = spectro_level.find(in);
+	if( it != spectro_level.end() )
+	  lev = TMath::Max( lev, it->second+1 );
+      }
+    }
+    for( vector<THaAnalysisObject*>::size_type i = 0; i < inputs.size(); ++i ) {
+      if( dynamic_cast<const THaSpectrometer*>(inputs[i]) ) {
+	Int_t& slev = spectro_level.insert(make_pair(inputs[i],-1)).first->second;
+	slev = TMath::Max( slev, lev );
+      }
+    }
+    level[mod] = lev;
+    maxlevel = TMath::Max( maxlevel, lev );
+    ModuleTask* task = new PhysTask(mod);
+    task->fLevel = lev;
+    fPhysTasks[fNPhysTasks++] = task;
+  }
+  if( !ok )
+    return 0;
+
+  stable_sort( fPhysTasks, fPhysTasks+fNPhysTasks, ModuleTask::LevelLess );
+  vector<Int_t> width( maxlevel+1, 0 );
+  for( Int_t i = 0; i < fNPhysTasks; ++i )
+    ++width[fPhysTasks[i]->fLevel];
+  return *max_element( width.begin(), width.end() );
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::DeleteTaskPool()
+{
+  // Stop the threads for concurrent processing, if any, and delete the tasks
+
+  delete fTaskPool; fTaskPool = NULL;
+  for( Int_t i = 0; i < fNAppTasks; ++i )
+    delete fAppTasks[i];
+  delete [] fAppTasks; fAppTasks = NULL;
+  fNAppTasks = 0;
+  for( Int_t i = 0; i < fNPhysTasks; ++i )
+    delete fPhysTasks[i];
+  delete [] fPhysTasks; fPhysTasks = NULL;
+  fNPhysTasks = 0;
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::RunTasks( ModuleTask** tasks, Int_t ntasks, TObject*& obj )
+{
+  // Run 'ntasks' tasks concurrently on fTaskPool and wait for them.
+  // If a task caught an exception, throw it again, with 'obj' pointing to
+  // the module that threw it.
+
+  // Modules must not use the profiler from several threads
+  Podd::Profiler* active = Podd::Profiler::GetActive();
+  Podd::Profiler::SetActive(0);
+  for( Int_t i = 0; i < ntasks; ++i ) {
+    tasks[i]->fEvData = fEvData;
+    tasks[i]->fFailed = false;
+    if( ntasks > 1 )
+      fTaskPool->Submit( tasks[i] );
+  }
+  if( ntasks > 1 )
+    fTaskPool->Wait();
+  else if( ntasks == 1 )
+    tasks[0]->Run();
+  Podd::Profiler::SetActive(active);
+  for( Int_t i = 0; i < ntasks; ++i ) {
+    if( tasks[i]->fFailed ) {
+      obj = tasks[i]->fModule;
+      throw runtime_error( tasks[i]->fError );
+    }
+  }
+}
+
+//_____________________________________________________________________________
+void THaAnalyzer::ProcessApparatuses( Int_t stage, TObject*& obj )
+{
+  // Run analysis stage 'stage' for all active apparatuses, concurrently if
+  // set up. Returns when all apparatuses are done.
+  // If an apparatus throws, the exception is passed on to the caller,
+  // with 'obj' pointing to the apparatus.
+
+  if( fTaskPool && fNAppTasks > 0 ) {
+    for( Int_t i = 0; i < fNAppTasks; ++i )
+      static_cast<AppTask*>(fAppTasks[i])->fStage = stage;
+    RunTasks( fAppTasks, fNAppTasks, obj );
+    return;
+  }
+
+  Podd::Profiler* prof = fDoBench ? fProfiler : 0;
+  Int_t imod = 0;
+  TIter next(fActiveApps);
+  while( (obj = next()) ) {
+    Podd::ProbeScope scope( prof, imod++, obj->GetName() );
+    AppTask::RunStage( static_cast<THaApparatus*>(obj), stage, *fEvData );
+  }
+}
+
+//_____________________________________________________________________________
+Int_t THaAnalyzer::ProcessPhysics( TObject*& obj )
+{
+  // Process all active physics modules, concurrently by dependency level if
+  // set up (see SchedulePhysics). Returns kFatal or kTerminate if a module
+  // requested it, else kOK. After a fatal error, no further modules are
+  // processed; in concurrent mode, the modules of the same level still
+  // complete.
+
+  Int_t code = kOK;
+  if( fTaskPool && fNPhysTasks > 0 ) {
+    Int_t i = 0;
+    while( i < fNPhysTasks ) {
+      Int_t j = i+1;
+      while( j < fNPhysTasks && fPhysTasks[j]->fLevel == fPhysTasks[i]->fLevel )
+	++j;
+      RunTasks( fPhysTasks+i, j-i, obj );
+      for( ; i < j; ++i ) {
+	Int_t err = static_cast<PhysTask*>(fPhysTasks[i])->fRetval;
+	if( err == THaPhysicsModule::kTerminate )
+	  code = kTerminate;
+	else if( err == THaPhysicsModule::kFatal )
+	  return kFatal;
+      }
+    }
+    return code;
+  }
+
+  Podd::Profiler* prof = fDoBench ? fProfiler : 0;
+  Int_t imod = 0;
+  TIter next(fActivePhysics);
+  while( (obj = next()) ) {
+    Podd::ProbeScope scope( prof, imod++, obj->GetName() );
+    THaPhysicsModule* theModule = static_cast<THaPhysicsModule*>(obj);
+    theModule->Clear();
+    Int_t err = theModule->Process( *fEvData );
+    if( err == THaPhysicsModule::kTerminate )
+      code = kTerminate;
+    else if( err == THaPhysicsModule::kFatal )
+      return kFatal;
+  }
+  return code;
+}
+
 //_____________________________________________________________________________
 THaEvData* THaAnalyzer::GetDecoder() const
 {
@@ -455,6 +935,7 @@ Int_t THaAnalyzer::InitModules( TList* module_list, TDatime& run_time,
       continue;
     }
     try {
+      theModule->ClearInputModules();
       retval = theModule->Init( run_time );
     }
     catch( exception& e ) {
@@ -485,12 +966,15 @@ Int_t THaAnalyzer::Init( THaRunBase* run )
   // This is a wrapper so we can conveniently control the benchmark counter
   if( !run ) return -1;
 
-  if( !fIsInit ) fBench->Reset();
+  if( !fIsInit ) {
+    fBench->Reset();
+    fProfiler->Reset();
+  }
   fBench->Begin("Total");
 
-  if( fDoBench ) fBench->Begin("Init");
+  if( fDoBench ) fProfiler->Start(kPrInit);
   Int_t retval = DoInit( run );
-  if( fDoBench ) fBench->Stop("Init");
+  if( fDoBench ) fProfiler->Stop(kPrInit);
 
   // Stop "Total" counter since Init() may be called separately from Process()
   fBench->Stop("Total");
@@ -730,6 +1214,8 @@ Int_t THaAnalyzer::DoInit( THaRunBase* run )
     TDirectory *olddir = gDirectory;
     fFile->cd();
 
+    if( new_output )
+      fOutput->SetHistogramsOnly( fDoHistOnly );
     if( (retval = fOutput->Init( fOdefFileName )) < 0 ) {
       Error( here, "Error initializing THaOutput." );
     } else if( retval == 1 )
@@ -764,6 +1250,11 @@ Int_t THaAnalyzer::DoInit( THaRunBase* run )
     }
   }
 
+  if( retval == 0 ) {
+    SelectModules();
+    InitTaskPool();
+  }
+
   // If initialization succeeded, set status flags accordingly
   if( retval == 0 ) {
     fIsInit = kTRUE;
@@ -799,10 +1290,11 @@ Int_t THaAnalyzer::InitOutput( const TList* module_list,
       retval = -2;
       break;
     }
-    theModule->InitOutput( fOutput );
-    if( !theModule->IsOKOut() ) {
-      Error( here, "Error initializing output for  %s (%s). "
-          "Analyzer initialization failed.", obj->GetName(), obj->GetTitle() );
+    Int_t ret = theModule->InitOutput( fOutput );
+    if( ret != 0 || !theModule->IsOKOut() ) {
+      Error( here, "Error %d initializing output for  %s (%s). "
+          "Analyzer initialization failed.", ret, obj->GetName(),
+	     obj->GetTitle() );
       retval = -1;
       break;
     }
@@ -817,7 +1309,11 @@ Int_t THaAnalyzer::ReadOneEvent()
   // Read one event from current run (fRun) and raw-decode it using the
   // current decoder (fEvData)
 
-  if( fDoBench ) fBench->Begin("RawDecode");
+  if( fDoBench ) {
+    EndEventTiming();
+    fProfiler->BeginEvent();
+    fProfiler->Start(kPrRawDecode);
+  }
 
   bool to_read_file = false;
   if( !fEvData->IsMultiBlockMode() ||
@@ -828,6 +1324,7 @@ Int_t THaAnalyzer::ReadOneEvent()
   Int_t status = THaRunBase::READ_OK;
   if (to_read_file)
     status = fRun->ReadEvent();
+  bool loaded = false;
 
   switch( status ) {
   case THaRunBase::READ_OK:
@@ -837,6 +1334,7 @@ Int_t THaAnalyzer::ReadOneEvent()
     } else {
       status = fEvData->LoadFromMultiBlock( );  // load next event in block
     }
+    loaded = true;
     switch( status ) {
     case THaEvData::HED_OK:     // fall through
     case THaEvData::HED_WARN:
@@ -863,10 +1361,29 @@ Int_t THaAnalyzer::ReadOneEvent()
     break;
   }
 
-  if( fDoBench ) fBench->Stop("RawDecode");
+  if( fDoBench ) {
+    fProfiler->Stop(kPrRawDecode);
+    // Don't time reads that did not produce an event
+    if( !loaded )
+      fProfiler->CancelEvent();
+  }
   return status;
 }
 
+//_____________________________________________________________________________
+void THaAnalyzer::EndEventTiming()
+{
+  // Finish timing the event currently held by the decoder and keep it
+  // if it is one of the slowest. Must be called before reading the
+  // next event.
+
+  if( !fProfiler->IsInEvent() )
+    return;
+  ULong64_t latency = fProfiler->EndEvent();
+  if( fSlowEvents->IsSlow(latency) )
+    fSlowEvents->Add( latency, *fEvData, *fProfiler );
+}
+
 //_____________________________________________________________________________
 void THaAnalyzer::SetEpicsEvtType(Int_t itype)
 {
@@ -1068,15 +1585,11 @@ Int_t THaAnalyzer::PhysicsAnalysis( Int_t code )
 
   TObject* obj = 0;
   TString stage = "Decode";
-  if( fDoBench ) fBench->Begin(stage);
-  TIter next(fApps);
+  Int_t probe = kPrDecode;
+  if( fDoBench ) fProfiler->Start(probe);
   try {
-    while( (obj = next()) ) {
-      THaApparatus* theApparatus = static_cast<THaApparatus*>(obj);
-      theApparatus->Clear();
-      theApparatus->Decode( *fEvData );
-    }
-    if( fDoBench ) fBench->Stop(stage);
+    ProcessApparatuses( kDecode, obj );
+    if( fDoBench ) fProfiler->Stop(probe);
     if( !EvalStage(kDecode) )  return kSkip;
 
     //--- Main physics analysis. Calls the following for each defined apparatus
@@ -1090,68 +1603,44 @@ Int_t THaAnalyzer::PhysicsAnalysis( Int_t code )
     //-- Coarse processing
 
     stage = "CoarseTracking";
-    if( fDoBench ) fBench->Begin(stage);
-    next.Reset();
-    while( (obj = next()) ) {
-      THaSpectrometer* theSpectro = dynamic_cast<THaSpectrometer*>(obj);
-      if( theSpectro )
-	theSpectro->CoarseTrack();
-    }
-    if( fDoBench ) fBench->Stop(stage);
+    probe = kPrCoarseTrack;
+    if( fDoBench ) fProfiler->Start(probe);
+    ProcessApparatuses( kCoarseTrack, obj );
+    if( fDoBench ) fProfiler->Stop(probe);
     if( !EvalStage(kCoarseTrack) )  return kSkip;
 
 
     stage = "CoarseReconstruct";
-    if( fDoBench ) fBench->Begin(stage);
-    next.Reset();
-    while( (obj = next()) ) {
-      THaApparatus* theApparatus = static_cast<THaApparatus*>(obj);
-      theApparatus->CoarseReconstruct();
-    }
-    if( fDoBench ) fBench->Stop(stage);
+    probe = kPrCoarseRecon;
+    if( fDoBench ) fProfiler->Start(probe);
+    ProcessApparatuses( kCoarseRecon, obj );
+    if( fDoBench ) fProfiler->Stop(probe);
     if( !EvalStage(kCoarseRecon) )  return kSkip;
 
     //-- Fine (Full) Reconstruct().
 
     stage = "Tracking";
-    if( fDoBench ) fBench->Begin(stage);
-    next.Reset();
-    while( (obj = next()) ) {
-      THaSpectrometer* theSpectro = dynamic_cast<THaSpectrometer*>(obj);
-      if( theSpectro )
-	theSpectro->Track();
-    }
-    if( fDoBench ) fBench->Stop(stage);
+    probe = kPrTracking;
+    if( fDoBench ) fProfiler->Start(probe);
+    ProcessApparatuses( kTracking, obj );
+    if( fDoBench ) fProfiler->Stop(probe);
     if( !EvalStage(kTracking) )  return kSkip;
 
 
     stage = "Reconstruct";
-    if( fDoBench ) fBench->Begin(stage);
-    next.Reset();
-    while( (obj = next()) ) {
-      THaApparatus* theApparatus = static_cast<THaApparatus*>(obj);
-      theApparatus->Reconstruct();
-    }
-    if( fDoBench ) fBench->Stop(stage);
+    probe = kPrReconstruct;
+    if( fDoBench ) fProfiler->Start(probe);
+    ProcessApparatuses( kReconstruct, obj );
+    if( fDoBench ) fProfiler->Stop(probe);
     if( !EvalStage(kReconstruct) )  return kSkip;
 
     //--- Process the list of physics modules
 
     stage = "Physics";
-    if( fDoBench ) fBench->Begin(stage);
-    TIter next_physics(fPhysics);
-    while( (obj = next_physics()) ) {
-      THaPhysicsModule* theModule = static_cast<THaPhysicsModule*>(obj);
-      theModule->Clear();
-      Int_t err = theModule->Process( *fEvData );
-      if( err == THaPhysicsModule::kTerminate )
-	code = kTerminate;
-      else if( err == THaPhysicsModule::kFatal ) {
-	code = kFatal;
-	break;
-      }
-    }
-    if( fDoBench ) fBench->Stop(stage);
+    probe = kPrPhysics;
+    if( fDoBench ) fProfiler->Start(probe);
+    code = ProcessPhysics( obj );
+    if( fDoBench ) fProfiler->Stop(probe);
     if( code == kFatal ) return kFatal;
 
     //--- Evaluate "Physics" test block
@@ -1167,16 +1656,16 @@ Int_t THaAnalyzer::PhysicsAnalysis( Int_t code )
     Error( here, "Caught exception %s in module %s (%s) during %s analysis "
 	   "stage. Terminating analysis.", e.what(), module_name.Data(),
 	   module_desc.Data(), stage.Data() );
-    if( fDoBench ) fBench->Stop(stage);
+    if( fDoBench ) fProfiler->Stop(probe);
     code = kFatal;
     goto errexit;
   }
 
   //---  Process output
-  if( fDoBench ) fBench->Begin("Output");
+  if( fDoBench ) fProfiler->Start(kPrOutput);
   try {
-    //--- If Event defined, fill it.
-    if( fEvent ) {
+    //--- If Event defined, fill it. Not needed without output tree.
+    if( fEvent && !(fOutput && fOutput->IsHistogramsOnly()) ) {
       fEvent->GetHeader()->Set( static_cast<UInt_t>(fEvData->GetEvNum()),
 				fEvData->GetEvType(),
 				fEvData->GetEvLength(),
@@ -1194,7 +1683,7 @@ Int_t THaAnalyzer::PhysicsAnalysis( Int_t code )
 	   "Terminating analysis.", e.what(), fNev );
     code = kFatal;
   }
-  if( fDoBench ) fBench->Stop("Output");
+  if( fDoBench ) fProfiler->Stop(kPrOutput);
 
  errexit:
   return code;
@@ -1210,9 +1699,9 @@ Int_t THaAnalyzer::SlowControlAnalysis( Int_t code )
   if( code == kFatal )
     return code;
   if ( !fEpicsHandler ) return kOK;
-  if( fDoBench ) fBench->Begin("Output");
+  if( fDoBench ) fProfiler->Start(kPrOutput);
   if( fOutput ) fOutput->ProcEpics(fEvData, fEpicsHandler);
-  if( fDoBench ) fBench->Stop("Output");
+  if( fDoBench ) fProfiler->Stop(kPrOutput);
   if( code == kTerminate )
     return code;
   return kOK;
@@ -1238,10 +1727,10 @@ Int_t THaAnalyzer::PostProcess( Int_t code )
   // THaPostProcess::Process() function for optional evaluation,
   // e.g. skipping events that fail analysis stage cuts.
 
-  if( fDoBench ) fBench->Begin("PostProcess");
-
   if( code == kFatal )
     return code;
+
+  if( fDoBench ) fProfiler->Start(kPrPostProcess);
   TIter next(fPostProcess);
   while( THaPostProcess* obj = static_cast<THaPostProcess*>(next())) {
     Int_t ret = obj->Process(fEvData,fRun,code);
@@ -1249,7 +1738,7 @@ Int_t THaAnalyzer::PostProcess( Int_t code )
 	ret > code )
       code = ret;
   }
-  if( fDoBench ) fBench->Stop("PostProcess");
+  if( fDoBench ) fProfiler->Stop(kPrPostProcess);
   return code;
 }
 
@@ -1373,6 +1862,8 @@ Int_t THaAnalyzer::Process( THaRunBase* run )
   bool terminate = false, fatal = false;
   UInt_t nlast = fRun->GetLastEvent();
   fAnalysisStarted = kTRUE;
+  fSlowEvents->Clear();
+  if( fDoBench ) Podd::Profiler::SetActive(fProfiler);
   BeginAnalysis();
   if( fFile ) {
     fFile->cd();
@@ -1408,18 +1899,23 @@ Int_t THaAnalyzer::Process( THaRunBase* run )
       break;
     }
 
-    //--- Print marks periodically
-    if( fVerbose>1 && evnum > 0 && (evnum % fMarkInterval == 0))
-      cout << dec << evnum << endl;
+    //--- Print marks periodically. Also bring histograms up to date,
+    //    so that they are never more than fMarkInterval events behind.
+    if( evnum > 0 && fMarkInterval > 0 && (evnum % fMarkInterval == 0)) {
+      if( fVerbose>1 )
+	cout << dec << evnum << endl;
+      if( fOutput )
+	fOutput->FlushHistograms();
+    }
 
     //--- Update run parameters with current event
     if( fUpdateRun )
       fRun->Update( fEvData );
 
     //--- Clear all tests/cuts
-    if( fDoBench ) fBench->Begin("Cuts");
+    if( fDoBench ) fProfiler->Start(kPrCuts);
     gHaCuts->ClearAll();
-    if( fDoBench ) fBench->Stop("Cuts");
+    if( fDoBench ) fProfiler->Stop(kPrCuts);
 
     //--- Perform the analysis
     Int_t err = MainAnalysis();
@@ -1444,6 +1940,10 @@ Int_t THaAnalyzer::Process( THaRunBase* run )
 
   }  // End of event loop
 
+  if( fDoBench ) {
+    EndEventTiming();
+    Podd::Profiler::SetActive(0);
+  }
   EndAnalysis();
 
   //--- Close the input file
@@ -1456,7 +1956,7 @@ Int_t THaAnalyzer::Process( THaRunBase* run )
   // This writes the Tree as well as any objects (histograms etc.)
   // that are defined in the current directory.
 
-  if( fDoBench ) fBench->Begin("Output");
+  if( fDoBench ) fProfiler->Start(kPrOutput);
   // Ensure that we are in the output file's current directory
   // ... someone might have pulled the rug from under our feet
 
@@ -1470,7 +1970,7 @@ Int_t THaAnalyzer::Process( THaRunBase* run )
     //    fFile->Write();//already done by fOutput->End()
     fFile->Purge();         // get rid of excess object "cycles"
   }
-  if( fDoBench ) fBench->Stop("Output");
+  if( fDoBench ) fProfiler->Stop(kPrOutput);
 
   fBench->Stop("Total");
 
@@ -1502,16 +2002,19 @@ Int_t THaAnalyzer::Process( THaRunBase* run )
   // Print timing statistics, if benchmarking enabled
   if( fDoBench && !fatal ) {
     cout << "Timing summary:" << endl;
-    fBench->Print("Init");
-    fBench->Print("RawDecode");
-    fBench->Print("Decode");
-    fBench->Print("CoarseTracking");
-    fBench->Print("CoarseReconstruct");
-    fBench->Print("Tracking");
-    fBench->Print("Reconstruct");
-    fBench->Print("Physics");
-    fBench->Print("Output");
-    fBench->Print("Cuts");
+    fProfiler->Print();
+    if( !fProfileFileName.IsNull() &&
+	fProfiler->Write(fProfileFileName) == 0 && fVerbose>1 )
+      cout << "Timing statistics written to " << fProfileFileName << endl;
+    fSlowEvents->Print( *fProfiler );
+    if( !fSlowEventFileName.IsNull() && fSlowEvents->GetSize() > 0 ) {
+      Int_t n = fSlowEvents->Write( fSlowEventFileName );
+      if( n < 0 )
+	Error( here, "Failed to write slow events to %s",
+	       fSlowEventFileName.Data() );
+      else if( fVerbose>1 )
+	cout << n << " slow events written to " << fSlowEventFileName << endl;
+    }
   }
   if( (fVerbose>1 || fDoBench) && !fatal )
     fBench->Print("Total");
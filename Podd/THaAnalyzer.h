@@ -19,6 +19,7 @@ class TFile;
 class TDatime;
 class THaCut;
 class THaBenchmark;
+namespace Podd { class Profiler; class SlowEventList; class TaskPool; }
 class THaEvData;
 class THaPostProcess;
 class THaCrateMap;
@@ -40,6 +41,7 @@ public:
 
   void           EnableBenchmarks( Bool_t b = kTRUE );
   void           EnableHelicity( Bool_t b = kTRUE );
+  void           EnableHistogramsOnly( Bool_t b = kTRUE );
   void           EnableOtherEvents( Bool_t b = kTRUE );
   void           EnableOverwrite( Bool_t b = kTRUE );
   void           EnablePhysicsEvents( Bool_t b = kTRUE );
@@ -50,6 +52,9 @@ public:
   const char*    GetCutFileName()      const  { return fCutFileName.Data(); }
   const char*    GetOdefFileName()     const  { return fOdefFileName.Data(); }
   const char*    GetSummaryFileName()  const  { return fSummaryFileName.Data(); }
+  const char*    GetProfileFileName()  const  { return fProfileFileName.Data(); }
+  Podd::Profiler* GetProfiler()        const  { return fProfiler; }
+  const Podd::SlowEventList* GetSlowEvents() const { return fSlowEvents; }
   TFile*         GetOutFile()          const  { return fFile; }
   Int_t          GetCompressionLevel() const  { return fCompress; }
   THaEvent*      GetEvent()            const  { return fEvent; }
@@ -61,9 +66,12 @@ public:
   TList*         GetPostProcess()      const  { return fPostProcess; }
   Bool_t         HasStarted()          const  { return fAnalysisStarted; }
   Bool_t         HelicityEnabled()     const  { return fDoHelicity; }
+  Bool_t         HistogramsOnlyEnabled() const { return fDoHistOnly; }
   Bool_t         PhysicsEnabled()      const  { return fDoPhysics; }
   Bool_t         OtherEventsEnabled()  const  { return fDoOtherEvents; }
   Bool_t         SlowControlEnabled()  const  { return fDoSlowControl; }
+  UInt_t         GetParallelApps()     const  { return fNAppThreads; }
+  UInt_t         GetParallelPhysics()  const  { return fNPhysThreads; }
   virtual Int_t  SetCountMode( Int_t mode );
   void           SetCrateMapFileName( const char* name );
   void           SetEvent( THaEvent* event )     { fEvent = event; }
@@ -71,8 +79,12 @@ public:
   void           SetCutFile( const char* name )  { fCutFileName = name; }
   void           SetOdefFile( const char* name ) { fOdefFileName = name; }
   void           SetSummaryFile( const char* name ) { fSummaryFileName = name; }
+  void           SetProfileFile( const char* name ) { fProfileFileName = name; }
+  void           SetSlowEventCapture( UInt_t nevents, const char* codafile = 0 );
   void           SetCompressionLevel( Int_t level ) { fCompress = level; }
   void           SetMarkInterval( UInt_t interval ) { fMarkInterval = interval; }
+  void           SetParallelApps( UInt_t nthreads );
+  void           SetParallelPhysics( UInt_t nthreads );
   void           SetVerbosity( Int_t level )        { fVerbose = level; }
   void           SetCodaVersion(Int_t vers);
 
@@ -115,6 +127,13 @@ protected:
 
   enum ECountMode { kCountPhysics, kCountAll, kCountRaw };
 
+  // Timing probes, defined in the constructor
+  enum {
+    kPrInit = 0, kPrRawDecode, kPrDecode, kPrCoarseTrack, kPrCoarseRecon,
+    kPrTracking, kPrReconstruct, kPrPhysics, kPrOutput, kPrCuts,
+    kPrPostProcess, kNProbes
+  };
+
   TFile*         fFile;            //The ROOT output file.
   THaOutput*     fOutput;          //Flexible ROOT output (tree, histograms)
   THaEpicsEvtHandler* fEpicsHandler; // EPICS event handler used by THaOutput
@@ -123,6 +142,8 @@ protected:
   TString        fLoadedCutFileName;//Name of last loaded cut definition file
   TString        fOdefFileName;    //Name of output definition file
   TString        fSummaryFileName; //Name of test/cut statistics output file
+  TString        fProfileFileName; //Name of timing statistics output file (JSON)
+  TString        fSlowEventFileName;//Name of CODA file for slowest events
   THaEvent*      fEvent;           //The event structure to be written to file.
   Int_t          fNStages;         //Number of analysis stages
   Int_t          fNCounters;       //Number of counters
@@ -134,7 +155,19 @@ protected:
   Int_t          fCompress;        //Compression level for ROOT output file
   Int_t          fVerbose;         //Verbosity level
   Int_t          fCountMode;       //Event counting mode (see ECountMode)
-  THaBenchmark*  fBench;           //Counters for timing statistics
+  THaBenchmark*  fBench;           //Total run time
+  Podd::Profiler* fProfiler;       //Detailed timing statistics
+  Podd::SlowEventList* fSlowEvents;//Slowest events of the last replay
+  UInt_t         fNAppThreads;     //Max apparatuses processed concurrently
+  UInt_t         fNPhysThreads;    //Max physics modules processed concurrently
+  Podd::TaskPool* fTaskPool;       //! Threads for concurrent processing
+  class ModuleTask;                // Defined in THaAnalyzer.cxx
+  class AppTask;
+  class PhysTask;
+  ModuleTask**   fAppTasks;        //! [fNAppTasks] Per-apparatus tasks
+  Int_t          fNAppTasks;       //! Number of tasks in fAppTasks
+  ModuleTask**   fPhysTasks;       //! [fNPhysTasks] Physics tasks by level
+  Int_t          fNPhysTasks;      //! Number of tasks in fPhysTasks
   THaEvent*      fPrevEvent;       //Event structure from last Init()
   THaRunBase*    fRun;             //Pointer to current run
   THaEvData*     fEvData;          //Instance of decoder used by us
@@ -142,6 +175,8 @@ protected:
   TList*         fPhysics;         //List of physics modules
   TList*         fPostProcess;     //List of post-processing modules
   TList*         fEvtHandlers;     //List of event handlers
+  TList*         fActiveApps;      //Apparatuses processed for each event
+  TList*         fActivePhysics;   //Physics modules processed for each event
 
   // Status and control flags
   Bool_t         fIsInit;          // Init() called successfully
@@ -154,6 +189,7 @@ protected:
   Bool_t         fDoPhysics;       // Enable physics event processing
   Bool_t         fDoOtherEvents;   // Enable other event processing
   Bool_t         fDoSlowControl;   // Enable slow control processing
+  Bool_t         fDoHistOnly;      // Fill histograms only, skip unused modules
 
   // Variables used by analysis functions
   Bool_t         fFirstPhysics;    // Status flag for physics analysis
@@ -168,6 +204,10 @@ protected:
   virtual Int_t  OtherAnalysis( Int_t code );
   virtual Int_t  PostProcess( Int_t code );
   virtual Int_t  ReadOneEvent();
+  void           EndEventTiming();
+  void           ProcessApparatuses( Int_t stage, TObject*& obj );
+  Int_t          ProcessPhysics( TObject*& obj );
+  void           RunTasks( ModuleTask** tasks, Int_t ntasks, TObject*& obj );
 
   // Support methods & data
   void           ClearCounters();
@@ -186,6 +226,10 @@ protected:
   virtual void   PrintCounters() const;
   virtual void   PrintScalers() const;  // archaic
   virtual void   PrintCutSummary() const;
+  virtual void   SelectModules();
+  void           InitTaskPool();
+  Int_t          SchedulePhysics();
+  void           DeleteTaskPool();
 
   static THaAnalyzer* fgAnalyzer;  //Pointer to instance of this class
 
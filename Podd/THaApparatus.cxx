@@ -16,6 +16,7 @@
 #include "THaDetector.h"
 #include "TClass.h"
 #include "TList.h"
+#include "Profiler.h"
 
 #include <cstring>
 #ifdef WITH_DEBUG
@@ -127,8 +128,11 @@ Int_t THaApparatus::Decode( const THaEvData& evdata )
 {
   // Call the Decode() method for all detectors defined for this apparatus.
 
+  Podd::Profiler* prof = Podd::Profiler::GetActive();
+  Int_t idet = 0;
   TIter next(fDetectors);
   while( THaDetector* theDetector = static_cast<THaDetector*>( next() )) {
+    Podd::ProbeScope scope( prof, idet++, theDetector->GetName() );
 #ifdef WITH_DEBUG
     if( fDebug>1 ) cout << "Decoding " << theDetector->GetName()
 			<< "... " << flush;
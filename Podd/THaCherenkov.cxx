@@ -147,6 +147,13 @@ Int_t THaCherenkov::ReadDatabase( const TDatime& date )
     fA_p  = new Float_t[ nval ];
     fA_c  = new Float_t[ nval ];
 
+    // Per-event data are reset sparsely in Clear(), so start from a
+    // fully reset state here
+    for( UInt_t i=0; i<nval; ++i ) {
+      fT[i] = fT_c[i] = fA[i] = fA_p[i] = fA_c[i] = kBig;
+    }
+    InitFired( nval );
+
     fIsInit = true;
   }
 
@@ -253,9 +260,15 @@ void THaCherenkov::Clear( Option_t* opt )
   THaPidDetector::Clear(opt);
   fNThit = fNAhit = 0;
   assert(fIsInit);
-  for( Int_t i=0; i<fNelem; ++i ) {
+  // Only mirrors that had data in the last event need resetting, provided
+  // Decode() kept track of them. Otherwise reset all mirrors.
+  Bool_t sparse = IsFiredValid();
+  Int_t n = sparse ? GetNfired() : fNelem;
+  for( Int_t j=0; j<n; ++j ) {
+    Int_t i = sparse ? GetFired(j) : j;
     fT[i] = fT_c[i] = fA[i] = fA_p[i] = fA_c[i] = kBig;
   }
+  ClearFired();
   fASUM_p = fASUM_c = 0.0;
 }
 
@@ -318,6 +331,7 @@ Int_t THaCherenkov::Decode( const THaEvData& evdata )
       }
 
       // Copy the data to the local variables.
+      MarkFired(k);
       if ( adc ) {
 	fA[k]   = data;
 	fA_p[k] = data - fPed[k];
@@ -346,6 +360,8 @@ Int_t THaCherenkov::Decode( const THaEvData& evdata )
   if( has_warning )
     ++fNEventsWithWarnings;
 
+  SetFiredValid();
+
 #ifdef WITH_DEBUG
   if ( fDebug > 3 ) {
     cout << endl << "Cherenkov " << GetPrefix() << ":" << endl;
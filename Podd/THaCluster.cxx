@@ -7,12 +7,22 @@
 ///////////////////////////////////////////////////////////////////////////////
 
 #include "THaCluster.h"
+#include "MethodVar.h"
 #include <iostream>
 
 using namespace std;
 
 const Double_t THaCluster::kBig = 1e38;
 
+//_____________________________________________________________________________
+static const Podd::MethodAccessorDef accessors[] = {
+  PODD_METHOD_ACCESSOR( THaCluster, Double_t, X ),
+  PODD_METHOD_ACCESSOR( THaCluster, Double_t, Y ),
+  PODD_METHOD_ACCESSOR( THaCluster, Double_t, Z ),
+  { 0 }
+};
+PODD_REGISTER_ACCESSORS( accessors );
+
 //_____________________________________________________________________________
 void THaCluster::Clear( Option_t* )
 {
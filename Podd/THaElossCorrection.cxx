@@ -11,6 +11,7 @@
 #include "THaTrack.h"
 #include "THaTrackInfo.h"
 #include "THaVertexModule.h"
+#include "ElossTable.h"
 #include "TMath.h"
 #include "TVector3.h"
 #include "VarDef.h"
@@ -29,7 +30,7 @@ THaElossCorrection::THaElossCorrection( const char* name,
   fZmed(0.0), fAmed(0.0), fDensity(0.0), fPathlength(0.0), 
   fZref(0.0), fScale(0.0),
   fTestMode(kFALSE), fExtPathMode(kFALSE), fInputName(input_tracks),
-  fVertexModule(NULL)
+  fVertexModule(NULL), fUseTable(kTRUE), fTable(NULL)
 {
   // Normal constructor.
 
@@ -60,6 +61,8 @@ THaAnalysisObject::EStatus THaElossCorrection::Init( const TDatime& run_time )
 {
   // Initialize the module.
 
+  static const char* const here = "Init";
+
   if( fExtPathMode ) {
     fVertexModule = dynamic_cast<THaVertexModule*>
       ( FindModule( fVertexName.Data(), "THaVertexModule" ));
@@ -69,10 +72,42 @@ THaAnalysisObject::EStatus THaElossCorrection::Init( const TDatime& run_time )
 
   // Continue with standard initialization
   THaPhysicsModule::Init( run_time );
+  if( fStatus )
+    return fStatus;
+
+  // Get the shared energy loss table for the medium, now that the medium
+  // parameters are known
+  fTable = NULL;
+  if( fUseTable && !fTestMode ) {
+    fTable = Podd::ElossTable::Get( fElectronMode, fZmed, fAmed, fDensity );
+    if( !fTable )
+      Warning( Here(here), "Cannot tabulate energy loss for medium "
+	       "Z = %g, A = %g, density = %g g/cm^3. Using analytic "
+	       "calculation.", fZmed, fAmed, fDensity );
+    else if( fDebug > 0 )
+      Info( Here(here), "Energy loss table with %u points, max. "
+	    "relative error %g", fTable->GetNpoints(), fTable->GetMaxError() );
+  }
 
   return fStatus;
 }
 
+//_____________________________________________________________________________
+Double_t THaElossCorrection::ComputeEloss( Double_t p ) const
+{
+  // Energy loss (GeV) of a particle with momentum p (GeV/c) in the medium
+  // over the current pathlength. Uses the energy loss table if available,
+  // otherwise the analytic functions.
+
+  if( fTable )
+    return fTable->GetEloss( p, TMath::Abs(fM), fPathlength, fZ );
+
+  Double_t beta = p / TMath::Sqrt(p*p + fM*fM);
+  if( fElectronMode )
+    return ElossElectron( beta, fZmed, fAmed, fDensity, fPathlength );
+  return ElossHadron( fZ, beta, fZmed, fAmed, fDensity, fPathlength );
+}
+
 //_____________________________________________________________________________
 Int_t THaElossCorrection::DefineVariables( EMode mode )
 {
@@ -218,6 +253,20 @@ void THaElossCorrection::SetPathlength( const char* vertex_module,
     PrintInitError("SetPathlength");
 }
 
+//_____________________________________________________________________________
+void THaElossCorrection::SetUseTable( Bool_t enable )
+{
+  // Use a table of the energy loss versus beta*gamma, computed once for
+  // the medium at Init, instead of evaluating the analytic formulas for
+  // every event (default). The table reproduces the analytic result to
+  // a relative accuracy of Podd::ElossTable::kTolerance.
+
+  if( !IsInit() )
+    fUseTable = enable;
+  else
+    PrintInitError("SetUseTable");
+}
+
 //-----------------------------------------------------------------------
 // The following four routines have been taken from ESPACE 
 // (file kinematics/eloss.f) and translated from FORTRAN to C++.
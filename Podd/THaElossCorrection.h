@@ -11,6 +11,7 @@
 #include "TString.h"
 
 class THaVertexModule;
+namespace Podd { class ElossTable; }
 
 class THaElossCorrection : public THaPhysicsModule {
   
@@ -32,6 +33,7 @@ public:
           void      SetPathlength( Double_t pathlength /* m */ );
           void      SetPathlength( const char* vertex_module,
 				   Double_t z_ref /* m */, Double_t scale = 1.0 );
+          void      SetUseTable( Bool_t enable=kTRUE );
 
   static  Double_t  ElossElectron( Double_t beta, Double_t z_med,
 				   Double_t a_med, 
@@ -64,6 +66,10 @@ protected:
   TString            fInputName;   // Name of input module
   TString            fVertexName;  // Name of vertex module for var pathlength, if any
   THaVertexModule*   fVertexModule;// Pointer to vertex module
+  Bool_t             fUseTable;    // Use tabulated energy loss, if available
+  const Podd::ElossTable* fTable;  //! Energy loss table for the medium
+
+  Double_t           ComputeEloss( Double_t p /* GeV/c */ ) const;
 
   // Setup functions
   virtual Int_t DefineVariables( EMode mode = kDefine );
@@ -35,12 +35,41 @@
 #include <string>
 #include <vector>
 #include <iomanip>
+#include <algorithm>
 
 ClassImp(THaEventHeader)
 ClassImp(THaEvent)
 
+using namespace std;
+
+typedef void (*ConvertFunc_t)( void* dest, Int_t j, Double_t val );
+
+//_____________________________________________________________________________
+template< typename T >
+static void ConvertValue( void* dest, Int_t j, Double_t val )
+{
+  static_cast<T*>(dest)[j] = static_cast<T>(val);
+}
+
+//_____________________________________________________________________________
+struct THaEvent::CopyOp {
+  // One step of the copy plan executed by Fill()
+  enum EKind { kCopy, kGather, kConvert };
+  EKind          kind;
+  Int_t          ncopy;    // Number of elements, <= 0 if determined per event
+  Int_t*         ncopyvar; // Variable holding number of elements (if ncopy<=0)
+  THaVar*        pvar;     // Source variable
+  const void*    loc;      // kCopy: data, or address of data pointer if
+                           // indirect. kGather: address of pointer array
+  Bool_t         indirect; // loc holds address of data pointer
+  void*          dest;     // Destination member variable
+  size_t         size;     // Element size
+  ConvertFunc_t  convert;  // Element conversion (kConvert only)
+};
+
 //_____________________________________________________________________________
-THaEvent::THaEvent() : fInit(kFALSE), fDataMap(NULL)
+THaEvent::THaEvent() : fInit(kFALSE), fDataMap(NULL), fCopyOps(NULL),
+		       fNcopyOps(0)
 {
   // Create a THaEvent object.
   Class()->IgnoreTObjectStreamer();
@@ -51,6 +80,7 @@ THaEvent::~THaEvent()
 {
   // Destructor. Clean up all my objects.
 
+  delete [] fCopyOps; fCopyOps = NULL;
   delete [] fDataMap; fDataMap = NULL;
 }
 
@@ -64,8 +94,13 @@ void THaEvent::Clear( Option_t* )
 Int_t THaEvent::Fill()
 {
   // Copy global variables specified in the data map to the event structure.
-
-  static const char* const here = "Fill()";
+  //
+  // The copying is done according to the plan compiled from fDataMap by
+  // Init(). Basic data are copied with memcpy. The user needs to ensure
+  // that the destination type matches the source type -> potential for
+  // error! Data of object variables are retrieved via GetValue() and
+  // converted to the type of the variable, which again is assumed to be
+  // the type of the destination.
 
   // Initialize datamap if not yet done
   if( !fInit ) {
@@ -74,135 +109,163 @@ Int_t THaEvent::Fill()
       return status;
   }
 
-  // Move the data into the members variables of this Event object
-  //
-  // For basic types, this can be reduced to a memcpy. Knowledge of the
-  // type of the destination is not necessary, BUT the user needs to ensure
-  // the destination type matches the source type -> potential for error!
-  //
-  // For object types, this is no longer that easy (without rewriting the
-  // variable system); we really have to convert the data retrieved via
-  // GetData() to the type of the destination.
-  //
-  // These complications will go away completely once this class is rewritten
-  // with an intelligent streamer.
-  //
-
   Int_t nvar = 0;
-  Int_t ncopy;
-  THaVar* pvar;
-  if( DataMap* datamap = fDataMap ) {
-    while( datamap->ncopy ) {
-      if( (pvar = datamap->pvar) ) {
-	if( datamap->ncopy>0 )
-	  ncopy = datamap->ncopy;
-	else if( datamap->ncopyvar )
-	  ncopy = *datamap->ncopyvar;
-	else {
-	  ncopy = pvar->GetLen();
-	  if( ncopy == THaVar::kInvalidInt ) 
-	    continue;
-	}
-	Int_t       type = pvar->GetType();
-	size_t      size = pvar->GetTypeSize();
-	const void* src  = pvar->GetValuePointer();
-	if( !src ) continue;
-	if( pvar->IsBasic() ) {
-	  if( type >= kDoubleP ) {
-	    // Pointers to pointers - get the pointer they currently point to
-	    void** loc = (void**)src;
-	           src = (const void*)(*loc);
-	  }
-	  if( !src ) continue;
-	  if( !pvar->IsPointerArray() )
-	    memcpy( datamap->dest, src, ncopy*size );
-	  else {
-	    // For pointer arrays, we need to copy the elements one by one
-	    // Type doesn't matter for memcpy, but size does ;)
-	    for( int i=0; i<ncopy; i++ ) {
-	      const int** psrc = (const int**)src;
-	      int*        dest = static_cast<int*>( datamap->dest );
-	      memcpy( dest+i, *(psrc+i), size );
-	    }
-	  }
-	} else {
-	  // Object variables: Now we have to worry about the type of
-	  // the destination. We assume it is the same type as the
-	  // source. Ugly and inefficient, but good enough for now I guess.
-	  // Note: Function return values are either Long_t or Double_t,
-	  // regardless of the actual return value of the function.
-	  // This is a ROOT limitation.
-	  for( int i=0, j=0; i<ncopy; i++, j++ ) {
-	    Double_t val = pvar->GetValue(i);
-	    if( val == THaVar::kInvalid )
-	      continue;
-	    switch( type ) {
-	    case kDouble: case kDoubleP:
-	      *(((Double_t*)datamap->dest)+j) = val;
-	      break;
-	    case kFloat:  case kFloatP:
-	      *(((Float_t*)datamap->dest)+j)  = static_cast<Float_t>(val);
-	      break;
-	    case kInt:    case kIntP:
-	      *(((Int_t*)datamap->dest)+j)    = static_cast<Int_t>(val);
-	      break;
-	    case kUInt:   case kUIntP:
-	      *(((UInt_t*)datamap->dest)+j)   = static_cast<UInt_t>(val);
-	      break;
-	    case kShort:  case kShortP:
-	      *(((Short_t*)datamap->dest)+j)  = static_cast<Short_t>(val);
-	      break;
-	    case kUShort: case kUShortP:
-	      *(((UShort_t*)datamap->dest)+j) = static_cast<UShort_t>(val);
-	      break;
-	    case kLong:   case kLongP:
-	      *(((Long64_t*)datamap->dest)+j) = static_cast<Long64_t>(val);
-	      break;
-	    case kULong:  case kULongP:
-	      *(((ULong64_t*)datamap->dest)+j)= static_cast<ULong64_t>(val);
-	      break;
-	    case kChar:   case kCharP:
-	      *(((Char_t*)datamap->dest)+j)   = static_cast<Char_t>(val);
-	      break;
-	    case kByte:   case kByteP:
-	      *(((Byte_t*)datamap->dest)+j)   = static_cast<Byte_t>(val);
-	      break;
-	    default:
-	      Warning( here, "Unknown type for variable %s "
-		 "Not filled.", pvar->GetName() );
-	      j--; nvar--;
-	      break;
-	    }
-	  }
+  for( Int_t k = 0; k < fNcopyOps; ++k ) {
+    const CopyOp& op = fCopyOps[k];
+    Int_t ncopy = op.ncopy;
+    if( ncopy <= 0 ) {
+      if( op.ncopyvar )
+	ncopy = *op.ncopyvar;
+      else {
+	ncopy = op.pvar->GetLen();
+	if( ncopy == THaVar::kInvalidInt )
+	  continue;
+      }
+      if( ncopy <= 0 )
+	continue;
+    }
+    switch( op.kind ) {
+    case CopyOp::kCopy:
+      {
+	const void* src = op.indirect
+	  ? *static_cast<const void* const*>(op.loc) : op.loc;
+	if( !src )
+	  continue;
+	memcpy( op.dest, src, ncopy*op.size );
+      }
+      break;
+    case CopyOp::kGather:
+      {
+	// Pointer arrays: copy the elements one by one
+	const void* const* ptrs = *static_cast<const void* const* const*>(op.loc);
+	if( !ptrs )
+	  continue;
+	char* dest = static_cast<char*>(op.dest);
+	for( Int_t i = 0; i < ncopy; ++i, dest += op.size ) {
+	  if( ptrs[i] )
+	    memcpy( dest, ptrs[i], op.size );
 	}
-	nvar += ncopy;
       }
-      datamap++;
+      break;
+    case CopyOp::kConvert:
+      for( Int_t i = 0; i < ncopy; ++i ) {
+	Double_t val = op.pvar->GetValue(i);
+	if( val != THaVar::kInvalid )
+	  op.convert( op.dest, i, val );
+      }
+      break;
     }
+    nvar += ncopy;
   }
 
   return nvar;
 }
 
+//_____________________________________________________________________________
+static ConvertFunc_t GetConverter( Int_t type )
+{
+  // Return conversion function for elements of the given variable type
+
+  switch( type ) {
+  case kDouble: case kDoubleP: return &ConvertValue<Double_t>;
+  case kFloat:  case kFloatP:  return &ConvertValue<Float_t>;
+  case kInt:    case kIntP:    return &ConvertValue<Int_t>;
+  case kUInt:   case kUIntP:   return &ConvertValue<UInt_t>;
+  case kShort:  case kShortP:  return &ConvertValue<Short_t>;
+  case kUShort: case kUShortP: return &ConvertValue<UShort_t>;
+  case kLong:   case kLongP:   return &ConvertValue<Long64_t>;
+  case kULong:  case kULongP:  return &ConvertValue<ULong64_t>;
+  case kChar:   case kCharP:   return &ConvertValue<Char_t>;
+  case kByte:   case kByteP:   return &ConvertValue<Byte_t>;
+  default: break;
+  }
+  return 0;
+}
+
 //_____________________________________________________________________________
 Int_t THaEvent::Init()
 {
-  // Initialize fDataMap. Called automatically by Fill() as necessary.
+  // Initialize fDataMap and compile it into the copy plan executed by Fill().
+  // Called automatically by Fill() as necessary.
+  //
+  // Each data map entry becomes a memcpy of contiguous basic data (directly
+  // or via the variable's data pointer), an element-wise gather from a
+  // pointer array, or a conversion loop over GetValue() for object
+  // variables. Fixed-size copies whose sources and destinations are
+  // adjacent in memory are merged into a single memcpy.
+
+  static const char* const here = "Init()";
 
   if( !gHaVars ) return -2;
 
+  delete [] fCopyOps; fCopyOps = NULL;
+  fNcopyOps = 0;
+
+  vector<CopyOp> ops;
   if( DataMap* datamap = fDataMap ) {
     while( datamap->ncopy ) {
-      if( THaVar* pvar = gHaVars->Find( datamap->name )) {
-	datamap->pvar = pvar;
+      THaVar* pvar = gHaVars->Find( datamap->name );
+      datamap->pvar = pvar;
+      if( !pvar ) {
+	Warning( here, "Global variable %s not found. "
+		 "Will be filled with zero.", datamap->name );
+	datamap++;
+	continue;
+      }
+      CopyOp op;
+      op.ncopy    = (datamap->ncopy > 0) ? datamap->ncopy : 0;
+      op.ncopyvar = datamap->ncopyvar;
+      op.pvar     = pvar;
+      op.loc      = 0;
+      op.indirect = kFALSE;
+      op.dest     = datamap->dest;
+      op.size     = pvar->GetTypeSize();
+      op.convert  = 0;
+      Int_t type  = pvar->GetType();
+      if( pvar->GetDirectAccess(op.loc,op.indirect) ) {
+	op.kind = CopyOp::kCopy;
+      } else if( pvar->IsPointerArray() && type >= kDouble2P &&
+		 type <= kUChar2P ) {
+	op.kind = CopyOp::kGather;
+	op.loc  = pvar->GetValuePointer();
+      } else if( (op.convert = GetConverter(type)) ) {
+	op.kind = CopyOp::kConvert;
+	op.loc  = pvar->GetValuePointer();
       } else {
-	Warning("Init()", "Global variable %s not found. "
-		"Will be filled with zero.", datamap->name );
-	datamap->pvar = NULL;
+	Warning( here, "Unknown type for variable %s. Not filled.",
+		 pvar->GetName() );
+	datamap++;
+	continue;
       }
+      if( !op.loc ) {
+	datamap++;
+	continue;
+      }
+      // Merge with the previous operation if both are fixed-size copies of
+      // adjacent memory into adjacent members
+      if( !ops.empty() ) {
+	CopyOp& prev = ops.back();
+	size_t nbytes = prev.ncopy*prev.size;
+	if( op.kind == CopyOp::kCopy && prev.kind == CopyOp::kCopy &&
+	    !op.indirect && !prev.indirect && op.ncopy > 0 && prev.ncopy > 0 &&
+	    op.size == prev.size &&
+	    static_cast<const char*>(prev.loc) + nbytes ==
+	    static_cast<const char*>(op.loc) &&
+	    static_cast<char*>(prev.dest) + nbytes == static_cast<char*>(op.dest) ) {
+	  prev.ncopy += op.ncopy;
+	  datamap++;
+	  continue;
+	}
+      }
+      ops.push_back(op);
       datamap++;
     }
   }
+  if( !ops.empty() ) {
+    fNcopyOps = ops.size();
+    fCopyOps = new CopyOp[fNcopyOps];
+    copy( ops.begin(), ops.end(), fCopyOps );
+  }
   fInit = kTRUE;
   return 0;
 }
@@ -85,6 +85,10 @@ protected:
   };
   DataMap*       fDataMap;       //! Map of global variables to copy
 
+  struct CopyOp;                 // Compiled copy operation, see Init()
+  CopyOp*        fCopyOps;       //! Copy plan compiled from fDataMap
+  Int_t          fNcopyOps;      //! Number of operations in fCopyOps
+
   ClassDef(THaEvent,3)  //Base class for event structure definition
 };
 
@@ -185,7 +185,7 @@ THaFormula& THaFormula::operator=( const THaFormula& rhs )
 
 //_____________________________________________________________________________
 THaFormula::FVarDef_t::FVarDef_t( const FVarDef_t& rhs )
-  : type(rhs.type), obj(rhs.obj), index(rhs.index)
+  : type(rhs.type), obj(rhs.obj), index(rhs.index), handle(rhs.handle)
 {
   if( (type == kFormula || type == kVarFormula) && rhs.obj != 0 )
     obj = new THaFormula(*static_cast<THaFormula*>(rhs.obj));
@@ -203,6 +203,7 @@ THaFormula::FVarDef_t& THaFormula::FVarDef_t::operator=( const FVarDef_t& rhs )
     else
       obj = rhs.obj;
     index = rhs.index;
+    handle = rhs.handle;
   }
   return *this;
 }
@@ -210,7 +211,7 @@ THaFormula::FVarDef_t& THaFormula::FVarDef_t::operator=( const FVarDef_t& rhs )
 #if __cplusplus >= 201103L
 //_____________________________________________________________________________
 THaFormula::FVarDef_t::FVarDef_t( FVarDef_t&& rhs ) noexcept
-  : type(rhs.type), obj(rhs.obj), index(rhs.index)
+  : type(rhs.type), obj(rhs.obj), index(rhs.index), handle(rhs.handle)
 {
   rhs.obj = nullptr;
 }
@@ -224,6 +225,7 @@ THaFormula::FVarDef_t& THaFormula::FVarDef_t::operator=( FVarDef_t&& rhs ) noexc
     type  = rhs.type;
     obj   = rhs.obj;
     index = rhs.index;
+    handle = rhs.handle;
     rhs.obj = nullptr;
   }
   return *this;
@@ -316,15 +318,16 @@ Double_t THaFormula::DefinedValue( Int_t i )
   case kString:
   case kArray:
     {
-      const THaVar* var = static_cast<const THaVar*>(def.obj);
-      assert(var);
+      // The handle reads basic-type data directly from memory
+      const Podd::VarHandle& var = def.handle;
+      assert(!var.IsNull());
       Int_t index = (def.type == kArray) ? fInstance : def.index;
       assert(index >= 0);
-      if( index >= var->GetLen() ) {
+      if( index >= var.GetLen() ) {
 	SetBit(kInvalid);
 	return 1.0; // safer than kBig to prevent overflow
       }
-      return var->GetValue( index );
+      return var.GetValue( index );
     }
     break;
   case kCut:
@@ -576,10 +579,12 @@ Int_t THaFormula::DefinedGlobalVariableExtraList( TString& name, const THaVarLis
 
   // Find the variable with this name in the extralist (Hall C Parameter)
   THaVar* var = 0;
+  const THaVarList* list = extralist;
   if( extralist ) {
     var = extralist->Find( parsed_name.GetName() );
   }
   if( !var && fVarList ) {
+    list = fVarList;
     var = fVarList->Find( parsed_name.GetName() );
   }
   if(!var) {
@@ -624,8 +629,10 @@ Int_t THaFormula::DefinedGlobalVariableExtraList( TString& name, const THaVarLis
       return i;
     }
   }
-  // If this is a new variable, add it to the list
+  // If this is a new variable, add it to the list. Resolve it to a handle
+  // now so that it can be read without lookup in every event.
   fVarDef.push_back( FVarDef_t(type,var,index) );
+  fVarDef.back().handle = list->GetHandle( var );
 
   return fVarDef.size()-1;
 }
@@ -760,11 +767,10 @@ Int_t THaFormula::GetNdataUnchecked() const
     switch( def.type ) {
     case kArray:
       {
-	const THaVar* pvar = static_cast<const THaVar*>(def.obj);
-	assert( pvar );
-	assert( pvar->IsArray() );
-	assert( pvar->GetNdim() > 0 );
-	ndata = TMath::Min( ndata, pvar->GetLen() );
+	assert( def.obj );
+	assert( static_cast<const THaVar*>(def.obj)->IsArray() );
+	assert( static_cast<const THaVar*>(def.obj)->GetNdim() > 0 );
+	ndata = TMath::Min( ndata, def.handle.GetLen() );
       }
       break;
     case kFormula:
@@ -797,6 +803,38 @@ Int_t THaFormula::GetNdata() const
   return GetNdataUnchecked();
 }
 
+//_____________________________________________________________________________
+void THaFormula::GetVarNames( set<string>& names ) const
+{
+  // Add the names of all global variables that this formula depends on to
+  // 'names', including those used by cuts and formulas referenced in it
+
+  for( vector<FVarDef_t>::const_iterator it = fVarDef.begin();
+       it != fVarDef.end(); ++it ) {
+    const FVarDef_t& def = *it;
+    if( !def.obj )
+      continue;
+    switch( def.type ) {
+    case kVariable:
+    case kString:
+    case kArray:
+      names.insert( static_cast<const THaVar*>(def.obj)->GetName() );
+      break;
+    case kCut:
+    case kCutScaler:
+    case kCutNCalled:
+      static_cast<const THaCut*>(def.obj)->GetVarNames( names );
+      break;
+    case kFormula:
+    case kVarFormula:
+      static_cast<const THaFormula*>(def.obj)->GetVarNames( names );
+      break;
+    default:
+      break;
+    }
+  }
+}
+
 //_____________________________________________________________________________
 void THaFormula::Print( Option_t* option ) const
 {
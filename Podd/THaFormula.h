@@ -16,7 +16,10 @@
 #endif
 
 #include "THaGlobals.h"
+#include "VarHandle.h"
 #include <vector>
+#include <set>
+#include <string>
 #include <iostream>
 
 class THaVarList;
@@ -58,6 +61,7 @@ public:
   { return const_cast<THaFormula*>(this)->Eval(); }
   virtual Double_t    EvalInstance( Int_t instance );
   virtual Int_t       GetNdata()   const;
+          void        GetVarNames( std::set<std::string>& names ) const;
   virtual Bool_t      IsArray()    const { return TestBit(kArrayFormula); }
   virtual Bool_t      IsVarArray() const { return TestBit(kVarArray); }
           Bool_t      IsError()    const { return TestBit(kError); }
@@ -90,6 +94,7 @@ protected:
     EVariableType type;                //Type of variable in the formula
     void*         obj;                 //Pointer to the respective object
     Int_t         index;               //Linear index into array, if fixed-size
+    Podd::VarHandle handle;            //Resolved global variable, if any
     FVarDef_t( EVariableType t, void* p, Int_t i ) : type(t), obj(p), index(i) {}
     FVarDef_t( const FVarDef_t& rhs );
     FVarDef_t& operator=( const FVarDef_t& rhs );
@@ -16,12 +16,15 @@
 #include "THaTrack.h"
 #include "THaTrackProj.h"
 #include <cassert>
+#include <algorithm>
+
+using namespace std;
 
 //______________________________________________________________________________
 THaNonTrackingDetector::THaNonTrackingDetector( const char* name,
 						const char* description,
 						THaApparatus* apparatus )
-  : THaSpectrometerDetector(name,description,apparatus)
+  : THaSpectrometerDetector(name,description,apparatus), fFiredValid(kFALSE)
 {
   // Normal constructor with name and description
 
@@ -30,7 +33,7 @@ THaNonTrackingDetector::THaNonTrackingDetector( const char* name,
 
 //______________________________________________________________________________
 THaNonTrackingDetector::THaNonTrackingDetector()
-  : THaSpectrometerDetector(), fTrackProj(0)
+  : THaSpectrometerDetector(), fTrackProj(0), fFiredValid(kFALSE)
 {
   // for ROOT I/O only
 }
@@ -102,5 +105,41 @@ Int_t THaNonTrackingDetector::CalcTrackProj( TClonesArray& tracks )
   return n_cross;
 }
 
+//_____________________________________________________________________________
+void THaNonTrackingDetector::InitFired( Int_t nelem )
+{
+  // Size the fired-element bookkeeping for 'nelem' detector elements
+  // and mark all elements as not fired. Call from ReadDatabase after
+  // the per-element data arrays have been reset.
+
+  fFired.clear();
+  fFired.reserve( nelem );
+  fIsFired.assign( nelem, 0 );
+  fFiredValid = kFALSE;
+}
+
+//_____________________________________________________________________________
+void THaNonTrackingDetector::ClearFired()
+{
+  // Unmark the elements that fired in the current event. Derived classes
+  // should call this at the end of Clear(), after resetting the data
+  // of the elements in fFired. Cost is proportional to the number of
+  // fired elements, not the size of the detector.
+
+  for( vector<Int_t>::size_type i = 0; i < fFired.size(); ++i )
+    fIsFired[fFired[i]] = 0;
+  fFired.clear();
+  fFiredValid = kFALSE;
+}
+
+//_____________________________________________________________________________
+void THaNonTrackingDetector::SortFired()
+{
+  // Sort the fired-element list in ascending order of element number.
+  // Elements are recorded in decoding order, which follows the detector map.
+
+  sort( fFired.begin(), fFired.end() );
+}
+
 //_____________________________________________________________________________
 ClassImp(THaNonTrackingDetector)
@@ -8,6 +8,7 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "THaSpectrometerDetector.h"
+#include <vector>
 
 class TClonesArray;
 
@@ -33,6 +34,33 @@ protected:
 
   Int_t CalcTrackProj( TClonesArray& tracks );
 
+  // Sparse bookkeeping of detector elements that received data in the
+  // current event. Derived classes call InitFired() once the number of
+  // elements is known, MarkFired() in Decode(), and SetFiredValid() at the
+  // end of Decode(). In Clear(), if IsFiredValid(), reset only the elements
+  // in the fired list, otherwise all elements, then call ClearFired().
+  // Derived classes with their own Decode() that does not maintain the
+  // list thus still get a full reset.
+  std::vector<Int_t>  fFired;    //! Elements with data in current event
+  std::vector<char>   fIsFired;  //! Per-element flag: element is in fFired
+  Bool_t              fFiredValid; //! fFired complete for current event
+
+  void   InitFired( Int_t nelem );
+  void   ClearFired();
+  void   SortFired();
+  Bool_t MarkFired( Int_t k )
+  {
+    // Record element k as fired. Returns true if not yet marked this event
+    if( fIsFired[k] ) return kFALSE;
+    fIsFired[k] = 1; fFired.push_back(k);
+    return kTRUE;
+  }
+  Bool_t IsFired( Int_t k ) const { return fIsFired[k] != 0; }
+  Int_t  GetNfired() const { return fFired.size(); }
+  Int_t  GetFired( Int_t i ) const { return fFired[i]; }
+  void   SetFiredValid() { fFiredValid = kTRUE; }
+  Bool_t IsFiredValid() const { return fFiredValid; }
+
   //Only derived classes may construct me
   THaNonTrackingDetector( const char* name, const char* description,
 			  THaApparatus* a = NULL);
@@ -180,10 +180,25 @@ Bool_t THaOdata::Resize(Int_t i)
   return false;
 }
 
+//_____________________________________________________________________________
+static void DropUnused( vector<THaVform*>& forms, const set<THaVform*>& used )
+{
+  // Delete the formulas in 'forms' that are not in 'used'
+
+  Iter_f_t keep = forms.begin();
+  for (Iter_f_t it = forms.begin(); it != forms.end(); ++it) {
+    if (used.count(*it))
+      *keep++ = *it;
+    else
+      delete *it;
+  }
+  forms.erase(keep, forms.end());
+}
+
 //_____________________________________________________________________________
 THaOutput::THaOutput()
   : fNvar(0), fVar(0), fEpicsVar(0), fTree(0), fEpicsTree(0), fInit(false),
-    fExtra(0), fEpicsHandler(0),
+    fHistOnly(false), fExtra(0), fEpicsHandler(0),
     nx(0), ny(0), iscut(0), xlo(0), xhi(0), ylo(0), yhi(0),
     fOpenEpics(false), fFirstEpics(false), fIsScalar(false)
 {
@@ -246,8 +261,12 @@ Int_t THaOutput::Init( const char* filename )
 
   if( fgDoBench ) fgBench.Begin("Init");
 
-  fTree = new TTree("T","Hall A Analyzer Output DST");
-  fTree->SetAutoSave(200000000);
+  // In histogram-only mode, there is no tree. Global variables and formulas
+  // are then only evaluated as far as the histograms need them.
+  if( !fHistOnly ) {
+    fTree = new TTree("T","Hall A Analyzer Output DST");
+    fTree->SetAutoSave(200000000);
+  }
   fOpenEpics  = kFALSE;
   fFirstEpics = kTRUE; 
 
@@ -267,6 +286,7 @@ Int_t THaOutput::Init( const char* filename )
   fVNames.clear();
 
   THaVar *pvar;
+  if (fHistOnly) fNvar = 0;
   for (Int_t ivar = 0; ivar < fNvar; ivar++) {
     pvar = gHaVars->Find(fVarnames[ivar].c_str());
     if (pvar) {
@@ -297,10 +317,11 @@ Int_t THaOutput::Init( const char* filename )
       --k;
       continue;
     }
-    pform->SetOutput(fTree);
     fFormulas.push_back(pform);
     if( fgVerbose > 2 )
       pform->LongPrint();  // for debug
+    if( !fTree ) continue;
+    pform->SetOutput(fTree);
 // Add variables (i.e. those var's used by the formula) to tree.
 // Reason is that TTree::Draw() may otherwise fail with ERROR 26 
     vector<string> avar = pform->GetVars();
@@ -345,11 +366,12 @@ Int_t THaOutput::Init( const char* filename )
       --k;
       continue;
     }
-    pcut->SetOutput(fTree);
+    if( fTree ) pcut->SetOutput(fTree);
     fCuts.push_back(pcut);
     if( fgVerbose>2 )
       pcut->LongPrint();  // for debug
   }
+  set<THaVform*> hist_forms;
   for (Iter_h_t ihist = fHistos.begin(); ihist != fHistos.end(); ++ihist) {
     THaVhist* vhist = *ihist;
 // After initializing formulas and cuts, must sort through
@@ -362,9 +384,11 @@ Int_t THaOutput::Init( const char* filename )
       string stemp((*iform)->GetName());
       if (CmpNoCase(sfvarx,stemp) == 0) { 
 	vhist->SetX(*iform);
+	hist_forms.insert(*iform);
       }
       if (CmpNoCase(sfvary,stemp) == 0) { 
 	vhist->SetY(*iform);
+	hist_forms.insert(*iform);
       }
     }
     if (vhist->HasCut()) {
@@ -373,10 +397,19 @@ Int_t THaOutput::Init( const char* filename )
         string stemp((*icut)->GetName());
         if (CmpNoCase(scut,stemp) == 0) { 
 	  vhist->SetCut(*icut);
+	  hist_forms.insert(*icut);
         }
       }
     }
     vhist->Init();
+    // Histogram-only mode is for online monitoring, where histograms
+    // may be viewed at any time. Fill them without delay.
+    if (fHistOnly) vhist->SetBuffered(kFALSE);
+  }
+  if (fHistOnly) {
+    // Formulas and cuts not used by any histogram have no purpose
+    DropUnused(fFormulas, hist_forms);
+    DropUnused(fCuts, hist_forms);
   }
 
   if (!fEpicsKey.empty()) {
@@ -388,7 +421,7 @@ Int_t THaOutput::Init( const char* filename )
       fEpicsVar[i] = -1e32;
       string epicsbr = CleanEpicsName((*it)->GetName());
       string tinfo = epicsbr + "/D";
-      fTree->Branch(epicsbr.c_str(), &fEpicsVar[i], 
+      if (fTree) fTree->Branch(epicsbr.c_str(), &fEpicsVar[i], 
         tinfo.c_str(), kNbout);
       fEpicsTree->Branch(epicsbr.c_str(), &fEpicsVar[i], 
         tinfo.c_str(), kNbout);
@@ -412,6 +445,18 @@ Int_t THaOutput::Init( const char* filename )
   return 0;
 }
 
+//_____________________________________________________________________________
+void THaOutput::GetHistogramVars( set<string>& names ) const
+{
+  // Add the names of the global variables that the histograms, including
+  // their cuts and formulas, depend on to 'names'.
+
+  typedef vector<THaVhist*>::const_iterator Iterc_h_t;
+  for (Iterc_h_t ihist = fHistos.begin(); ihist != fHistos.end(); ++ihist)
+    (*ihist)->GetVarNames(names);
+}
+
+//_____________________________________________________________________________
 void THaOutput::BuildList( const vector<string>& vdata) 
 {
   // Build list of EPICS variables and
@@ -469,12 +514,12 @@ Int_t THaOutput::Attach()
     pvar = gHaVars->Find(fVNames[ivar].c_str());
     if (pvar) {
       if ( !pvar->IsArray() ) {
-	fVariables[ivar] = pvar;
+	fVariables[ivar] = gHaVars->GetHandle(pvar);
       } else {
 	cout << "\tTHaOutput::Attach: ERROR: Global variable " << fVNames[ivar]
 	     << " changed from simple to array!! Leaving empty space for variable"
 	     << endl;
-	fVariables[ivar] = 0;
+	fVariables[ivar] = Podd::VarHandle();
       }
     } else {
       cout << "\nTHaOutput::Attach: WARNING: Global variable ";
@@ -488,12 +533,12 @@ Int_t THaOutput::Attach()
     pvar = gHaVars->Find(fArrayNames[ivar].c_str());
     if (pvar) {
       if ( pvar->IsArray() ) {
-	fArrays[ivar] = pvar;
+	fArrays[ivar] = gHaVars->GetHandle(pvar);
       } else {
 	cout << "\tTHaOutput::Attach: ERROR: Global variable " << fVNames[ivar]
 	     << " changed from ARRAY to Simple!! Leaving empty space for variable"
 	     << endl;
-	fArrays[ivar] = 0;
+	fArrays[ivar] = Podd::VarHandle();
       }
     } else {
       cout << "\nTHaOutput::Attach: WARNING: Global variable ";
@@ -572,27 +617,28 @@ Int_t THaOutput::Process()
   if( fgDoBench ) fgBench.Stop("Cuts");
 
   if( fgDoBench ) fgBench.Begin("Variables");
-  THaVar *pvar;
+  // Variables were resolved to handles in Attach(). Handles to variables
+  // removed since then are invalid and skipped.
   for (Int_t ivar = 0; ivar < fNvar; ivar++) {
-    pvar = fVariables[ivar];
-    if (pvar) fVar[ivar] = pvar->GetValue();
+    const Podd::VarHandle& hvar = fVariables[ivar];
+    if (hvar.IsValid()) fVar[ivar] = hvar.GetValue();
   }
   Int_t k = 0;
   for (Iter_o_t it = fOdata.begin(); it != fOdata.end(); ++it, ++k) { 
     THaOdata* pdat(*it);
     pdat->Clear();
-    pvar = fArrays[k];
-    if ( pvar == NULL ) continue;
+    const Podd::VarHandle& hvar = fArrays[k];
+    if ( !hvar.IsValid() ) continue;
     // Fill array in reverse order so that fOdata[k] gets resized just once
-    Int_t i = pvar->GetLen();
+    Int_t i = hvar.GetLen();
     bool first = true;
     while( i-- > 0 ) {
       // FIXME: for better efficiency, should use pointer to data and 
       // Fill(int n,double* data) method in case of a contiguous array
-      if (pdat->Fill(i,pvar->GetValue(i)) != 1) {
+      if (pdat->Fill(i,hvar.GetValue(i)) != 1) {
 	if( fgVerbose>0 && first ) {
 	  cerr << "THaOutput::ERROR: storing too much variable sized data: " 
-	       << pvar->GetName() <<"  "<<pvar->GetLen()<<endl;
+	       << hvar.GetName() <<"  "<<hvar.GetLen()<<endl;
 	  first = false;
 	}
       }
@@ -612,6 +658,15 @@ Int_t THaOutput::Process()
   return 0;
 }
 
+//_____________________________________________________________________________
+void THaOutput::FlushHistograms()
+{
+  // Fill all buffered histogram entries into the histograms
+
+  for (Iter_h_t ihist = fHistos.begin(); ihist != fHistos.end(); ++ihist)
+    (*ihist)->Flush();
+}
+
 //_____________________________________________________________________________
 Int_t THaOutput::End() 
 {
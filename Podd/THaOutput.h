@@ -8,8 +8,10 @@
 //////////////////////////////////////////////////////////////////////////
 
 #include "Rtypes.h"
+#include "VarHandle.h"
 #include <vector>
 #include <map>
+#include <set>
 #include <string> 
 #include <cstring>
 
@@ -81,6 +83,15 @@ public:
   virtual Bool_t TreeDefined() const { return fTree != 0; };
   virtual TTree* GetTree() const { return fTree; };
 
+  // Histogram-only mode: no tree, only histograms and what they depend on.
+  // Must be set before Init().
+  void   SetHistogramsOnly( Bool_t b = kTRUE ) { fHistOnly = b; }
+  Bool_t IsHistogramsOnly() const { return fHistOnly; }
+  void   GetHistogramVars( std::set<std::string>& names ) const;
+
+  // Fill entries buffered by the histograms, so that they are up to date
+  void   FlushHistograms();
+
   static void SetVerbosity( Int_t level );
   
 protected:
@@ -104,13 +115,14 @@ protected:
                            fFormnames, fFormdef,
                            fCutnames, fCutdef,
                            fArrayNames, fVNames; 
-  std::vector<THaVar* >  fVariables, fArrays;
+  std::vector<Podd::VarHandle>  fVariables, fArrays;
   std::vector<THaVform* > fFormulas, fCuts;
   std::vector<THaVhist* > fHistos;
   std::vector<THaOdata* > fOdata;
   std::vector<THaEpicsKey*>  fEpicsKey;
   TTree *fTree, *fEpicsTree; 
   bool fInit;
+  bool fHistOnly;   // Fill histograms only, no tree
   
   enum EId {kVar = 1, kForm, kCut, kH1f, kH1d, kH2f, kH2d, kBlock,
             kBegin, kEnd, kRate, kCount };
@@ -11,6 +11,8 @@
 #include "THaRun.h"
 #include "THaEvData.h"
 #include "THaCodaFile.h"
+#include "THaRunParameters.h"
+#include "CodaDecoder.h"
 #include "THaGlobals.h"
 #include "TClass.h"
 #include "TError.h"
@@ -19,6 +21,8 @@
 #include <iostream>
 #include <cstdlib>
 #include <cassert>
+#include <map>
+#include <string>
 
 using namespace std;
 using namespace Decoder;
@@ -26,6 +30,18 @@ using namespace Decoder;
 static const int   fgMaxScan   = 5000;
 static const char* fgThisClass = "THaRun";
 
+// Run parameters found by prescanning segment 0 of a run, by file name.
+// Avoids rescanning segment 0 for each continuation segment of the run.
+struct RunInfo_t {
+  UInt_t   dataread;   // Items found in the data (see EInfoType)
+  Bool_t   hasdate;    // fDate is from the data
+  TDatime  date;
+  Int_t    number;
+  Int_t    type;
+  TArrayI  prescales;
+};
+static map<string,RunInfo_t> fgRunInfo;
+
 //_____________________________________________________________________________
 THaRun::THaRun( const char* fname, const char* description ) :
   THaCodaRun(description), fFilename(fname), fMaxScan(fgMaxScan)
@@ -175,11 +191,54 @@ void THaRun::Print( Option_t* opt ) const
   cout << "Segment number: " << fSegment  << endl;
 }
 
+//_____________________________________________________________________________
+void THaRun::SaveRunInfo( const char* filename ) const
+{
+  // Remember the run parameters found in the data by prescanning 'filename'
+
+  RunInfo_t& info = fgRunInfo[filename];
+  info.dataread  = fDataRead & (kDate|kRunNumber|kRunType|kPrescales);
+  info.hasdate   = !fAssumeDate && (fDataRead & kDate);
+  info.date      = fDate;
+  info.number    = fNumber;
+  info.type      = fType;
+  info.prescales = fParam->GetPrescales();
+}
+
+//_____________________________________________________________________________
+Bool_t THaRun::RestoreRunInfo( const char* filename )
+{
+  // Set the run parameters found previously by prescanning 'filename'.
+  // Returns false if 'filename' has not been scanned.
+
+  map<string,RunInfo_t>::const_iterator it = fgRunInfo.find(filename);
+  if( it == fgRunInfo.end() )
+    return false;
+  const RunInfo_t& info = it->second;
+  if( info.hasdate && !fAssumeDate ) {
+    fDate = info.date;
+    fDataSet |= kDate;
+  }
+  if( info.dataread & kRunNumber )
+    SetNumber( info.number );
+  if( info.dataread & kRunType )
+    SetType( info.type );
+  if( info.dataread & kPrescales ) {
+    fParam->Prescales() = info.prescales;
+    fDataSet |= kPrescales;
+  }
+  fDataRead |= info.dataread;
+  return true;
+}
+
 //_____________________________________________________________________________
 Int_t THaRun::ReadInitInfo()
 {
   // Read initial info from the CODA file. This is done by prescanning
   // the run file in a local mini event loop via a local decoder.
+  // Only control and special events are decoded. For continuation
+  // segments, the info is taken from segment 0 of the run, which is
+  // scanned only once per session.
 
   static const char* const here = "ReadInitInfo";
 
@@ -193,12 +252,19 @@ Int_t THaRun::ReadInitInfo()
       evdata->EnableScalers(kFALSE);
       evdata->EnableHelicity(kFALSE);
       evdata->SetDataVersion(GetCodaVersion());
+      Int_t coda_version = GetCodaVersion();
       UInt_t nev = 0;
       while( nev<fMaxScan && !HasInfo(fDataRequired) &&
 	     (status = ReadEvent()) == READ_OK ) {
 
-	// Decode events. Skip bad events.
+	// Run parameters are only found in control and special events.
+	// Skip physics events based on the event header, without decoding.
 	nev++;
+	Int_t evtype = CodaDecoder::PeekEventType( GetEvBuffer(), coda_version );
+	if( evtype > 0 && evtype <= MAX_PHYS_EVTYPE )
+	  continue;
+
+	// Decode events. Skip bad events.
 	status = evdata->LoadEvent( GetEvBuffer());
 	if( status != THaEvData::HED_OK ) {
 	  if( status == THaEvData::HED_ERR ||
@@ -231,6 +297,7 @@ Int_t THaRun::ReadInitInfo()
 	       "permissions.", status, GetFilename());
 	return status;
       }
+      SaveRunInfo( fFilename.Data() );
 
     } else {
       // If this is a continuation segment, try finding segment 0
@@ -242,6 +309,9 @@ Int_t THaRun::ReadInitInfo()
       assert( dot != kNPOS );  // if fSegment>0, there must be a dot
       TString s = fFilename(0,dot);
       s.Append(".0");
+      // Segment 0 may have been scanned already in this session
+      if( RestoreRunInfo(s.Data()) )
+	return status;
       vector<TString> fnames;
       fnames.push_back(s);
       TString dirn = gSystem->DirName(s);
@@ -271,6 +341,8 @@ Int_t THaRun::ReadInitInfo()
 	  delete fCodaData;
 	  fSegment  = save_seg;
 	  fCodaData = save_coda;
+	  if( status == READ_OK || status == READ_EOF )
+	    SaveRunInfo( fnames[0].Data() );
 	  break;
 	}
       }
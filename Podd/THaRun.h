@@ -37,6 +37,8 @@ protected:
   Int_t         fSegment;      //  Segment number (for split runs)
 
           Int_t FindSegmentNumber();
+          void  SaveRunInfo( const char* filename ) const;
+          Bool_t RestoreRunInfo( const char* filename );
   virtual Int_t ReadInitInfo();
 
   ClassDef(THaRun,6)           // A run based on a CODA data file on disk
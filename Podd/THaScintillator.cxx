@@ -196,6 +196,15 @@ Int_t THaScintillator::ReadDatabase( const TDatime& date )
     fYt     = new Double_t[ nval ];
     fYa     = new Double_t[ nval ];
 
+    // Per-event data are reset sparsely in Clear(), so start from a
+    // fully reset state here
+    for( UInt_t i=0; i<nval; ++i ) {
+      fLT[i] = fLT_c[i] = fRT[i] = fRT_c[i] = kBig;
+      fLA[i] = fLA_p[i] = fLA_c[i] = fRA[i] = fRA_p[i] = fRA_c[i] = kBig;
+      fTime[i] = fdTime[i] = fAmpl[i] = fYt[i] = fYa[i] = kBig;
+    }
+    InitFired( nval );
+
     fIsInit = true;
   }
 
@@ -375,12 +384,18 @@ void THaScintillator::Clear( Option_t* opt )
   THaNonTrackingDetector::Clear(opt);
   fNhit = fLTNhit = fRTNhit = fLANhit = fRANhit = 0;
   assert(fIsInit);
-  for( Int_t i=0; i<fNelem; ++i ) {
+  // Only paddles that had data in the last event need resetting, provided
+  // Decode() kept track of them. Otherwise (e.g. a derived class's own
+  // Decode()) reset all paddles.
+  Bool_t sparse = IsFiredValid();
+  Int_t n = sparse ? GetNfired() : fNelem;
+  for( Int_t j=0; j<n; ++j ) {
+    Int_t i = sparse ? GetFired(j) : j;
     fLT[i] = fLT_c[i] = fRT[i] = fRT_c[i] = kBig;
     fLA[i] = fLA_p[i] = fLA_c[i] = fRA[i] = fRA_p[i] = fRA_c[i] = kBig;
     fTime[i] = fdTime[i] = fAmpl[i] = fYt[i] = fYa[i] = kBig;
   }
-  memset( fHitPad, 0, fNelem*sizeof(fHitPad[0]) );
+  ClearFired();
 }
 
 //_____________________________________________________________________________
@@ -450,6 +465,7 @@ Int_t THaScintillator::Decode( const THaEvData& evdata )
       // Copy the data to the local variables.
       DataDest* dest = fDataDest + k/fNelem;
       k = k % fNelem;
+      MarkFired(k);
       if( adc ) {
 	dest->adc[k]   = static_cast<Double_t>( data );
 	dest->adc_p[k] = data - dest->ped[k];
@@ -474,6 +490,8 @@ Int_t THaScintillator::Decode( const THaEvData& evdata )
   if( has_warning )
     ++fNEventsWithWarnings;
 
+  SetFiredValid();
+
 #ifdef WITH_DEBUG
   if ( fDebug > 3 ) {
     cout << endl << endl;
@@ -581,9 +599,16 @@ Int_t THaScintillator::CoarseProcess( TClonesArray& tracks )
   ApplyCorrections();
 
   // count the number of paddles with complete TDC hits
-  // Fill in information available from timing
+  // Fill in information available from timing. Visit fired paddles in
+  // ascending order so that fHitPad stays sorted, or all paddles if
+  // Decode() did not record the fired ones.
   fNhit = 0;
-  for (int i=0; i<fNelem; i++) {
+  Bool_t sparse = IsFiredValid();
+  if( sparse )
+    SortFired();
+  Int_t n = sparse ? GetNfired() : fNelem;
+  for (int j=0; j<n; j++) {
+    int i = sparse ? GetFired(j) : j;
     if( fLT[i]<0.5*kBig && fRT[i]<0.5*kBig ) {
       fHitPad[fNhit++] = i;
       fTime[i] = .5*(fLT_c[i]+fRT_c[i])-fSize[1]/fCn;
@@ -4,9 +4,10 @@
 //                                                                           //
 // Shower counter class, describing a generic segmented shower detector      //
 // (preshower or shower).                                                    //
-// Currently, only the "main" cluster, i.e. cluster with the largest energy  //
-// deposition is considered. Units of measurements are MeV for energy of     //
-// shower and centimeters for coordinates.                                   //
+// All clusters are reconstructed, up to a configurable maximum. The        //
+// "main" cluster is the one whose center block has the largest energy.      //
+// Units of measurements are MeV for energy of shower and centimeters for    //
+// coordinates.                                                              //
 //                                                                           //
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -20,22 +21,29 @@
 #include "TClonesArray.h"
 #include "TDatime.h"
 #include "TMath.h"
+#include "TString.h"
 
 #include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <cassert>
 #include <sstream>
+#include <algorithm>
 
 using namespace std;
 
+// Value of fBlkClust for fired blocks not (yet) assigned to a cluster
+static const Int_t kUnassigned = -1;
+
 //_____________________________________________________________________________
 THaShower::THaShower( const char* name, const char* description,
 		      THaApparatus* apparatus ) :
   THaPidDetector(name,description,apparatus),
-  fNclublk(0), fNrows(0), fBlockX(0), fBlockY(0), fPed(0), fGain(0), fEmin(0),
+  fNclublk(0), fNrows(0), fMaxNclust(0), fClShape(kSquare3),
+  fBlockX(0), fBlockY(0), fPed(0), fGain(0), fEmin(0),
   fNhits(0), fA(0), fA_p(0), fA_c(0), fAsum_p(kBig), fAsum_c(kBig),
-  fNclust(0), fE(kBig), fX(kBig), fY(kBig), fMult(0), fNblk(0), fEblk(0)
+  fNclust(0), fE(kBig), fX(kBig), fY(kBig), fMult(0), fNblk(0), fEblk(0),
+  fClE(0), fClX(0), fClY(0), fClMult(0)
 {
   // Constructor
 }
@@ -43,9 +51,11 @@ THaShower::THaShower( const char* name, const char* description,
 //_____________________________________________________________________________
 THaShower::THaShower() :
   THaPidDetector(),
-  fNclublk(0), fNrows(0), fBlockX(0), fBlockY(0), fPed(0), fGain(0), fEmin(0),
+  fNclublk(0), fNrows(0), fMaxNclust(0), fClShape(kSquare3),
+  fBlockX(0), fBlockY(0), fPed(0), fGain(0), fEmin(0),
   fNhits(0), fA(0), fA_p(0), fA_c(0), fAsum_p(kBig), fAsum_c(kBig),
-  fNclust(0), fE(kBig), fX(kBig), fY(kBig), fMult(0), fNblk(0), fEblk(0)
+  fNclust(0), fE(kBig), fX(kBig), fY(kBig), fMult(0), fNblk(0), fEblk(0),
+  fClE(0), fClX(0), fClY(0), fClMult(0)
 {
   // Default constructor (for ROOT I/O)
 }
@@ -72,7 +82,8 @@ Int_t THaShower::ReadDatabase( const TDatime& date )
 
   vector<Int_t> detmap, chanmap;
   vector<Double_t> xy, dxy;
-  Int_t ncols, nrows;
+  Int_t ncols, nrows, maxnclust = 16;
+  TString shape = "3x3";
 
   // Read mapping/geometry/configuration parameters
   DBRequest config_request[] = {
@@ -83,10 +94,33 @@ Int_t THaShower::ReadDatabase( const TDatime& date )
     { "xy",           &xy,      kDoubleV, 2 },  // center pos of block 1
     { "dxdy",         &dxy,     kDoubleV, 2 },  // dx and dy block spacings
     { "emin",         &fEmin,   kDouble },
+    { "clust.maxn",   &maxnclust, kInt,   0, 1 },
+    { "clust.shape",  &shape,   kTString, 0, 1 },
     { 0 }
   };
   err = LoadDB( file, date, config_request, fPrefix );
 
+  EClusterShape clshape = kSquare3;
+  if( !err ) {
+    shape.ToLower();
+    if( shape == "3x3" )
+      clshape = kSquare3;
+    else if( shape == "cross" )
+      clshape = kCross;
+    else if( shape == "5x5" )
+      clshape = kSquare5;
+    else {
+      Error( Here(here), "Unknown cluster shape \"%s\". Must be one of "
+	     "\"3x3\", \"cross\", \"5x5\". Fix database.", shape.Data() );
+      err = kInitError;
+    }
+  }
+  if( !err && maxnclust <= 0 ) {
+    Error( Here(here), "Illegal maximum number of clusters: %d. Must be > 0. "
+	   "Fix database.", maxnclust );
+    err = kInitError;
+  }
+
   // Sanity checks
   if( !err && (nrows <= 0 || ncols <= 0) ) {
     Error( Here(here), "Illegal number of rows or columns: %d %d. Must be > 0. "
@@ -94,20 +128,22 @@ Int_t THaShower::ReadDatabase( const TDatime& date )
     err = kInitError;
   }
 
-  Int_t nelem = ncols * nrows; 
-  Int_t nclbl = TMath::Min( 3, nrows ) * TMath::Min( 3, ncols );
+  Int_t nelem = ncols * nrows;
 
   // Reinitialization only possible for same basic configuration
   if( !err ) {
-    if( fIsInit && nelem != fNelem ) {
+    if( fIsInit && (nelem != fNelem || clshape != fClShape ||
+		    maxnclust != fMaxNclust) ) {
       Error( Here(here), "Cannot re-initalize with different number of blocks or "
-	     "blocks per cluster (was: %d, now: %d). Detector not re-initialized.",
-	     fNelem, nelem );
+	     "cluster configuration (was: %d, now: %d blocks). Detector not "
+	     "re-initialized.", fNelem, nelem );
       err = kInitError;
     } else {
       fNelem = nelem;
       fNrows = nrows;
-      fNclublk = nclbl;
+      fClShape = clshape;
+      fMaxNclust = maxnclust;
+      fNclublk = BuildNeighborTable( nrows, ncols );
     }
   }
 
@@ -179,6 +215,17 @@ Int_t THaShower::ReadDatabase( const TDatime& date )
     fA_c  = new Float_t[ nval ];
     fNblk = new Int_t[ fNclublk ];
     fEblk = new Float_t[ fNclublk ];
+    fClE    = new Float_t[ fMaxNclust ];
+    fClX    = new Float_t[ fMaxNclust ];
+    fClY    = new Float_t[ fMaxNclust ];
+    fClMult = new Int_t[ fMaxNclust ];
+
+    for( UInt_t i=0; i<nval; ++i ) {
+      fA[i] = fA_p[i] = fA_c[i] = kBig;
+    }
+    InitFired( nval );
+    fSeeds.reserve( nval );
+    fBlkClust.assign( nval, kUnassigned );
 
     fIsInit = true;
   }
@@ -224,6 +271,8 @@ Int_t THaShower::ReadDatabase( const TDatime& date )
       { "Position of block 1",    &xy,         kDoubleV    },
       { "Block x/y spacings",     &dxy,        kDoubleV    },
       { "Minimum cluster energy", &fEmin,      kFloat,  1  },
+      { "Cluster shape",          &shape,      kTString    },
+      { "Max number of clusters", &fMaxNclust, kInt        },
       { "ADC pedestals",          fPed,        kFloat,  N  },
       { "ADC pedestals",          fPed,        kFloat,  N  },
       { "ADC gains",              fGain,       kFloat,  N  },
@@ -260,6 +309,10 @@ Int_t THaShower::DefineVariables( EMode mode )
     { "mult",   "Multiplicity of largest cluster",    "fMult" },
     { "nblk",   "Numbers of blocks in main cluster",  "fNblk" },
     { "eblk",   "Energies of blocks in main cluster", "fEblk" },
+    { "cl.e",   "Energies (MeV) of all clusters",     "fClE" },
+    { "cl.x",   "x-positions (cm) of all clusters",   "fClX" },
+    { "cl.y",   "y-positions (cm) of all clusters",   "fClY" },
+    { "cl.mult","Multiplicities of all clusters",     "fClMult" },
     { "trx",    "x-position of track in det plane",   "fTrackProj.THaTrackProj.fX" },
     { "try",    "y-position of track in det plane",   "fTrackProj.THaTrackProj.fY" },
     { "trpath", "TRCS pathlen of track to det plane", "fTrackProj.THaTrackProj.fPathl" },
@@ -294,6 +347,45 @@ void THaShower::DeleteArrays()
   delete [] fA_c;     fA_c     = 0;
   delete [] fNblk;    fNblk    = 0;
   delete [] fEblk;    fEblk    = 0;
+  delete [] fClE;     fClE     = 0;
+  delete [] fClX;     fClX     = 0;
+  delete [] fClY;     fClY     = 0;
+  delete [] fClMult;  fClMult  = 0;
+  fNbStart.clear();
+  fNbList.clear();
+  fSeeds.clear();
+  fBlkClust.clear();
+}
+
+//_____________________________________________________________________________
+Int_t THaShower::BuildNeighborTable( Int_t nrows, Int_t ncols )
+{
+  // Build the table of neighbors of each block for the configured cluster
+  // shape. Block k is in row k%nrows and column k/nrows. Neighbors are
+  // stored in ascending order of block number. Returns the maximum number
+  // of blocks in a cluster, including the center.
+
+  Int_t d = (fClShape == kSquare5) ? 2 : 1;
+  fNbStart.assign( nrows*ncols+1, 0 );
+  fNbList.clear();
+  fNbList.reserve( nrows*ncols*(2*d+1)*(2*d+1) );
+  Int_t maxblk = 1;
+  for( Int_t k = 0; k < nrows*ncols; ++k ) {
+    Int_t ir = k%nrows, ic = k/nrows;
+    fNbStart[k] = fNbList.size();
+    for( Int_t jc = TMath::Max(ic-d,0); jc <= TMath::Min(ic+d,ncols-1); ++jc ) {
+      for( Int_t jr = TMath::Max(ir-d,0); jr <= TMath::Min(ir+d,nrows-1); ++jr ) {
+	if( jc == ic && jr == ir )
+	  continue;
+	if( fClShape == kCross && jc != ic && jr != ir )
+	  continue;
+	fNbList.push_back( nrows*jc + jr );
+      }
+    }
+    maxblk = TMath::Max( maxblk, Int_t(fNbList.size()-fNbStart[k]+1) );
+  }
+  fNbStart[nrows*ncols] = fNbList.size();
+  return maxblk;
 }
 
 //_____________________________________________________________________________
@@ -304,9 +396,15 @@ void THaShower::Clear( Option_t* opt )
   THaPidDetector::Clear(opt);
   fNhits = fNclust = fMult = 0;
   assert(fIsInit);
-  for( Int_t i=0; i<fNelem; ++i ) {
-    fA[i] = fA_p[i] = fA_c[i] = kBig;
+  // Only blocks that received data in the last event need resetting,
+  // provided Decode() kept track of them. Otherwise reset all blocks.
+  Bool_t sparse = IsFiredValid();
+  Int_t n = sparse ? GetNfired() : fNelem;
+  for( Int_t j=0; j<n; ++j ) {
+    Int_t k = sparse ? GetFired(j) : j;
+    fA[k] = fA_p[k] = fA_c[k] = kBig;
   }
+  ClearFired();
   fAsum_p = fAsum_c = 0.0;
   fE = fX = fY = kBig;
   memset( fNblk, 0, fNclublk*sizeof(fNblk[0]) );
@@ -382,6 +480,8 @@ Int_t THaShower::Decode( const THaEvData& evdata )
       }
 
       // Copy the data and apply calibrations
+      if( MarkFired(k) )                // Record block for clustering/clearing
+	fBlkClust[k] = kUnassigned;
       fA[k]   = data;                   // ADC value
       fA_p[k] = data - fPed[k];         // ADC minus ped
       fA_c[k] = fA_p[k] * fGain[k];     // ADC corrected
@@ -396,6 +496,8 @@ Int_t THaShower::Decode( const THaEvData& evdata )
   if( has_warning )
     ++fNEventsWithWarnings;
 
+  SetFiredValid();
+
 #ifdef WITH_DEBUG
   if ( fDebug > 3 ) {
     cout << endl << "Shower Detector " << GetPrefix() << ":" << endl;
@@ -426,6 +528,15 @@ Int_t THaShower::Decode( const THaEvData& evdata )
   return fNhits;
 }
 
+//_____________________________________________________________________________
+struct ByDecreasingEnergy {
+  // Order blocks by decreasing energy, lower block number first for ties
+  ByDecreasingEnergy( const Float_t* e ) : fE(e) {}
+  bool operator()( Int_t a, Int_t b ) const
+  { return fE[a] > fE[b] || (fE[a] == fE[b] && a < b); }
+  const Float_t* fE;
+};
+
 //_____________________________________________________________________________
 Int_t THaShower::CoarseProcess( TClonesArray& tracks )
 {
@@ -433,59 +544,81 @@ Int_t THaShower::CoarseProcess( TClonesArray& tracks )
   // into the following local data structure:
   //
   // fNclust        -  Number of clusters in shower;
+  // fClE[]         -  Energies (in MeV) of all clusters;
+  // fClX[], fClY[] -  X/Y-coordinates (in cm) of all clusters;
+  // fClMult[]      -  Number of blocks in each cluster;
   // fE             -  Energy (in MeV) of the "main" cluster;
-  // fX             -  X-coordinate (in cm) of the cluster;
-  // fY             -  Y-coordinate (in cm) of the cluster;
-  // fMult          -  Number of blocks in the cluster;
-  // fNblk[0]...[5] -  Numbers of blocks composing the cluster;
-  // fEblk[0]...[5] -  Energies in blocks composing the cluster;
+  // fX             -  X-coordinate (in cm) of the main cluster;
+  // fY             -  Y-coordinate (in cm) of the main cluster;
+  // fMult          -  Number of blocks in the main cluster;
+  // fNblk[]        -  Numbers of blocks composing the main cluster;
+  // fEblk[]        -  Energies in blocks composing the main cluster;
   //
-  // Only one ("main") cluster, i.e. the cluster with the largest energy
-  // deposition is considered. Units are MeV for energies and cm for
-  // coordinates.
-
-  fNclust = 0;
-  int nmax = -1;
-  double  emax = fEmin;                     // Min threshold of energy in center
-  for ( int  i = 0; i < fNelem; i++) {      // Find the block with max energy:
-    double  ei = fA_c[i];                   // Energy in next block
-    if ( ei > emax) {
-      nmax = i;                             // Number of block with max energy
-      emax = ei;                            // Max energy per a blocks
+  // Blocks with data above fEmin are taken as cluster centers in order of
+  // decreasing energy. Each center collects its not-yet-assigned neighbors
+  // with positive energy (see BuildNeighborTable). The "main" cluster is
+  // the first one found, i.e. the one with the most energetic center.
+  // Only blocks that received data in this event are examined.
+  // Units are MeV for energies and cm for coordinates.
+
+  if( !IsFiredValid() ) {
+    // Decode() did not record the fired blocks (e.g. a derived class's
+    // own Decode()). Find them now.
+    for( Int_t k = 0; k < fNelem; ++k ) {
+      if( fA[k] < 0.5*kBig && MarkFired(k) )
+	fBlkClust[k] = kUnassigned;
     }
   }
-  if ( nmax >= 0 ) {
-    short mult = 0, nr, nc, ir, ic, dr, dc;
-    double  sxe = 0, sye = 0;               // Sums of xi*ei and yi*ei
-    nc = nmax/fNrows;                       // Column of the block with max engy
-    nr = nmax%fNrows;                       // Row of the block with max energy
-                                            // Add the block to cluster (center)
-    fNblk[mult]   = nmax;                   // Add number of the block (center)
-    fEblk[mult++] = emax;                   // Add energy in the block (center)
-    sxe = emax * fBlockX[nmax];             // Sum of xi*ei
-    sye = emax * fBlockY[nmax];             // Sum of yi*ei
-    for ( int  i = 0; i < fNelem; i++) {    // Detach surround blocks:
-      double  ei = fA_c[i];                 // Energy in next block
-      if ( ei>0 && i!=nmax ) {              // Some energy out of cluster center
-	ic = i/fNrows;                      // Column of next block
-	ir = i%fNrows;                      // Row of next block
-	dr = nr - ir;                       // Distance on row up to center
-	dc = nc - ic;                       // Distance on column up to center
-	if ( -2<dr&&dr<2&&-2<dc&&dc<2 ) {   // Surround block:
-	                                    // Add block to cluster (surround)
-	  fNblk[mult]   = i;                // Add number of block (surround)
-	  fEblk[mult++] = ei;               // Add energy of block (surround)
-	  sxe  += ei * fBlockX[i];          // Sum of xi*ei of cluster blocks
-	  sye  += ei * fBlockY[i];          // Sum of yi*ei of cluster blocks
-	  emax += ei;                       // Sum of energies in cluster blocks
-	}
+  fNclust = 0;
+  fSeeds.clear();
+  for( Int_t j = 0; j < GetNfired(); ++j ) {
+    Int_t k = GetFired(j);
+    if( fA_c[k] > fEmin )
+      fSeeds.push_back(k);
+  }
+  sort( fSeeds.begin(), fSeeds.end(), ByDecreasingEnergy(fA_c) );
+
+  for( vector<Int_t>::size_type is = 0;
+       is < fSeeds.size() && fNclust < fMaxNclust; ++is ) {
+    Int_t kc = fSeeds[is];
+    if( fBlkClust[kc] != kUnassigned )      // Already part of a cluster
+      continue;
+    Int_t icl = fNclust++;
+    bool main = (icl == 0);
+    fBlkClust[kc] = icl;
+    Double_t esum = fA_c[kc];               // Energy of cluster center
+    Double_t sxe = esum * fBlockX[kc];      // Sums of xi*ei and yi*ei
+    Double_t sye = esum * fBlockY[kc];
+    Int_t mult = 1;
+    if( main ) {
+      fNblk[0] = kc;
+      fEblk[0] = fA_c[kc];
+    }
+    for( Int_t j = fNbStart[kc]; j < fNbStart[kc+1]; ++j ) {
+      Int_t k = fNbList[j];
+      Double_t ei = fA_c[k];
+      if( !IsFired(k) || fBlkClust[k] != kUnassigned || ei <= 0 )
+	continue;
+      fBlkClust[k] = icl;                   // Add block to cluster (surround)
+      if( main ) {
+	fNblk[mult] = k;
+	fEblk[mult] = ei;
       }
+      ++mult;
+      sxe  += ei * fBlockX[k];
+      sye  += ei * fBlockY[k];
+      esum += ei;
     }
-    fNclust = 1;                            // One ("main") cluster detected
-    fE      = emax;                         // Energy (MeV) in "main" cluster
-    fX      = sxe/emax;                     // X coordinate (cm) of the cluster
-    fY      = sye/emax;                     // Y coordinate (cm) of the cluster
-    fMult   = mult;                         // Number of blocks in "main" clust.
+    fClE[icl]    = esum;
+    fClX[icl]    = sxe/esum;
+    fClY[icl]    = sye/esum;
+    fClMult[icl] = mult;
+  }
+  if( fNclust > 0 ) {
+    fE    = fClE[0];                        // Energy (MeV) in "main" cluster
+    fX    = fClX[0];                        // X coordinate (cm) of the cluster
+    fY    = fClY[0];                        // Y coordinate (cm) of the cluster
+    fMult = fClMult[0];                     // Number of blocks in "main" clust.
   }
 
   // Calculate track projections onto shower plane
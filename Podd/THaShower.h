@@ -30,6 +30,14 @@ public:
           Float_t    GetX() const      { return fX; }
           Float_t    GetY() const      { return fY; }
 
+          Float_t    GetClusterE( Int_t i ) const { return fClE[i]; }
+          Float_t    GetClusterX( Int_t i ) const { return fClX[i]; }
+          Float_t    GetClusterY( Int_t i ) const { return fClY[i]; }
+          Int_t      GetClusterMult( Int_t i ) const { return fClMult[i]; }
+
+  // Shapes of the block neighborhood searched around a cluster center
+  enum EClusterShape { kSquare3, kCross, kSquare5 };
+
 protected:
 
   // Mapping (see also fDetMap)
@@ -39,6 +47,13 @@ protected:
   // Configuration
   Int_t      fNclublk;   // Max. number of blocks composing a cluster
   Int_t      fNrows;     // Number of rows
+  Int_t      fMaxNclust; // Max number of clusters reconstructed per event
+  EClusterShape fClShape; // Neighborhood searched around cluster centers
+
+  // Neighbor table. Neighbors of block k, in ascending order, are
+  // fNbList[fNbStart[k]] ... fNbList[fNbStart[k+1]-1]
+  std::vector<Int_t> fNbStart;   // [fNelem+1] Offsets into fNbList
+  std::vector<Int_t> fNbList;    // Neighbor block numbers
 
   // Geometry
   Float_t*   fBlockX;    // [fNelem] x positions (cm) of block centers
@@ -65,8 +80,17 @@ protected:
   Int_t      fMult;      // Number of blocks in main cluster
   Int_t*     fNblk;      // [fNclublk] Numbers of blocks composing main cluster
   Float_t*   fEblk;      // [fNclublk] Energies of blocks composing main cluster
+  Float_t*   fClE;       // [fNclust] Energies (MeV) of all clusters
+  Float_t*   fClX;       // [fNclust] x positions (cm) of all clusters
+  Float_t*   fClY;       // [fNclust] y positions (cm) of all clusters
+  Int_t*     fClMult;    // [fNclust] Number of blocks in each cluster
+
+  // Working storage, sized at initialization
+  std::vector<Int_t> fSeeds;     //! Cluster center candidates
+  std::vector<Int_t> fBlkClust;  //! Cluster index of each fired block
 
   void           DeleteArrays();
+  Int_t          BuildNeighborTable( Int_t nrows, Int_t ncols );
   virtual Int_t  ReadDatabase( const TDatime& date );
   virtual Int_t  DefineVariables( EMode mode = kDefine );
 
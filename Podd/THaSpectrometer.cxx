@@ -23,6 +23,7 @@
 #include "THaTrack.h"
 #include "TClass.h"
 #include "TList.h"
+#include "Profiler.h"
 #include "TMath.h"
 #include "TList.h"
 #include "VarDef.h"
@@ -280,9 +281,12 @@ Int_t THaSpectrometer::CoarseTrack()
 
   // 1st step: Coarse tracking.  This should be quick and dirty.
   // Any tracks found are put in the fTrack array.
+  Podd::Profiler* prof = Podd::Profiler::GetActive();
+  Int_t idet = 0;
   TIter next( fTrackingDetectors );
   while( THaTrackingDetector* theTrackDetector =
 	 static_cast<THaTrackingDetector*>( next() )) {
+    Podd::ProbeScope scope( prof, idet++, theTrackDetector->GetName() );
 #ifdef WITH_DEBUG
     if( fDebug>1 ) cout << "Call CoarseTrack() for " 
 			<< theTrackDetector->GetName() << "... ";
@@ -308,9 +312,12 @@ Int_t THaSpectrometer::CoarseReconstruct()
   if( !IsDone(kCoarseTrack))
     CoarseTrack();
 
+  Podd::Profiler* prof = Podd::Profiler::GetActive();
+  Int_t idet = 0;
   TIter next( fNonTrackingDetectors );
   while( THaNonTrackingDetector* theNonTrackDetector =
 	 static_cast<THaNonTrackingDetector*>( next() )) {
+    Podd::ProbeScope scope( prof, idet++, theNonTrackDetector->GetName() );
 #ifdef WITH_DEBUG
     if( fDebug>1 ) cout << "Call CoarseProcess() for " 
 			<< theNonTrackDetector->GetName() << "... ";
@@ -335,9 +342,12 @@ Int_t THaSpectrometer::Track()
   if( !IsDone(kCoarseRecon))
     CoarseReconstruct();
 
+  Podd::Profiler* prof = Podd::Profiler::GetActive();
+  Int_t idet = 0;
   TIter next( fTrackingDetectors );
   while( THaTrackingDetector* theTrackDetector =
 	 static_cast<THaTrackingDetector*>( next() )) {
+    Podd::ProbeScope scope( prof, idet++, theTrackDetector->GetName() );
 #ifdef WITH_DEBUG
     if( fDebug>1 ) cout << "Call FineTrack() for " 
 			<< theTrackDetector->GetName() << "... ";
@@ -388,9 +398,12 @@ Int_t THaSpectrometer::Reconstruct()
   // remaining detectors for any precision processing.
   // PID likelihoods should be calculated here.
 
+  Podd::Profiler* prof = Podd::Profiler::GetActive();
+  Int_t idet = 0;
   TIter next( fNonTrackingDetectors );
   while( THaNonTrackingDetector* theNonTrackDetector =
 	 static_cast<THaNonTrackingDetector*>( next() )) {
+    Podd::ProbeScope scope( prof, idet++, theNonTrackDetector->GetName() );
 #ifdef WITH_DEBUG
     if( fDebug>1 ) cout << "Call FineProcess() for " 
 			<< theNonTrackDetector->GetName() << "... ";
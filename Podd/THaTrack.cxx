@@ -11,12 +11,30 @@
 #include "THaTrack.h"
 #include "THaCluster.h"
 #include "THaTrackID.h"
+#include "MethodVar.h"
 #include <iostream>
 
 using namespace std;
 
 const Double_t THaTrack::kBig = 1e38;
 
+//_____________________________________________________________________________
+static const Podd::MethodAccessorDef accessors[] = {
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetLabPx   ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetLabPy   ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetLabPz   ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetVertexX ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetVertexY ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetVertexZ ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetPathLen ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetTime    ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetdTime   ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetBeta    ),
+  PODD_METHOD_ACCESSOR( THaTrack, Double_t, GetdBeta   ),
+  { 0 }
+};
+PODD_REGISTER_ACCESSORS( accessors );
+
 //_____________________________________________________________________________
 THaTrack::~THaTrack()
 {
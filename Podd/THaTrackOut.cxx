@@ -82,6 +82,11 @@ Int_t THaTrackOut::InitOutput( THaOutput* output )
   }
   TTree* tree = output->GetTree();
   if (!tree) {
+    if (output->IsHistogramsOnly()) {
+      // No tree by design. Nothing to set up.
+      fOKOut = true;
+      return 0;
+    }
     Error("InitOutput","Cannot get Tree! Output initialization FAILED!");
     return -3;
   }
@@ -54,6 +54,8 @@ public:
   size_t       GetData( void* buf, Int_t i )    const { return fImpl->GetData(buf,i); }
 
   Bool_t       HasSizeVar()                     const { return fImpl->HasSizeVar(); }
+  Bool_t       GetDirectAccess( const void*& loc, Bool_t& indirect )
+						const { return fImpl->GetDirectAccess(loc,indirect); }
 
   Bool_t       HasSameSize( const THaVar& rhs ) const;
   Bool_t       HasSameSize( const THaVar* rhs ) const;
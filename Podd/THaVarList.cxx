@@ -602,16 +602,133 @@ THaVar* THaVarList::Find( const char* name ) const
   if( !p )
     ptr = FindObject( name );
   else {
+    // Copy the basename to the stack if it fits, to avoid a heap allocation
+    const size_t kBufSize = 128;
     size_t n = p-name;
-    char* basename = new char[ n+1 ];
-    strncpy( basename, name, n );
-    basename[n] = '\0';
-    ptr = FindObject( basename );
-    delete [] basename;
+    if( n < kBufSize ) {
+      char basename[kBufSize];
+      strncpy( basename, name, n );
+      basename[n] = '\0';
+      ptr = FindObject( basename );
+    } else {
+      string basename( name, n );
+      ptr = FindObject( basename.c_str() );
+    }
   }
   return static_cast<THaVar*>(ptr);
 }
 
+//_____________________________________________________________________________
+Podd::VarHandle THaVarList::GetHandle( const char* name ) const
+{
+  // Get a handle to the variable with the given name. Array syntax
+  // ("var[3]") refers to the whole array, as with Find().
+  // Returns a null handle if the variable does not exist.
+
+  THaVar* var = Find( name );
+  if( !var )
+    return Podd::VarHandle();
+  return GetHandle( var );
+}
+
+//_____________________________________________________________________________
+Podd::VarHandle THaVarList::GetHandle( THaVar* var ) const
+{
+  // Get a handle to the given variable, which must be in this list.
+  //
+  // Each variable that has been given a handle occupies a slot, whose
+  // number is kept in the variable's unique ID. Removing the variable
+  // increments the slot's generation, which invalidates all outstanding
+  // handles to it, even if the slot is later reused.
+
+  Podd::VarHandle handle;
+  if( !var )
+    return handle;
+
+  Int_t slot = static_cast<Int_t>(var->GetUniqueID()) - 1;
+  if( slot < 0 || slot >= static_cast<Int_t>(fSlots.size()) ||
+      fSlots[slot] != var ) {
+    if( !FindObject(var) )
+      return handle;
+    if( !fFreeSlots.empty() ) {
+      slot = fFreeSlots.back();
+      fFreeSlots.pop_back();
+      fSlots[slot] = var;
+    } else {
+      slot = fSlots.size();
+      fSlots.push_back( var );
+      fSlotGen.push_back( 0 );
+    }
+    var->SetUniqueID( slot+1 );
+  }
+  handle.fList  = this;
+  handle.fVar   = var;
+  handle.fIndex = slot;
+  handle.fGen   = fSlotGen[slot];
+  handle.SetDirect();
+  return handle;
+}
+
+//_____________________________________________________________________________
+void THaVarList::ReleaseSlot( TObject* obj )
+{
+  // Invalidate handles to the given variable and free its slot
+
+  Int_t slot = static_cast<Int_t>(obj->GetUniqueID()) - 1;
+  if( slot >= 0 && slot < static_cast<Int_t>(fSlots.size()) &&
+      fSlots[slot] == obj ) {
+    fSlots[slot] = 0;
+    ++fSlotGen[slot];
+    fFreeSlots.push_back( slot );
+    obj->SetUniqueID( 0 );
+  }
+}
+
+//_____________________________________________________________________________
+void THaVarList::ReleaseAllSlots()
+{
+  // Invalidate all handles
+
+  for( vector<THaVar*>::size_type i = 0; i < fSlots.size(); ++i ) {
+    if( fSlots[i] ) {
+      fSlots[i]->SetUniqueID( 0 );
+      fSlots[i] = 0;
+      ++fSlotGen[i];
+      fFreeSlots.push_back( i );
+    }
+  }
+}
+
+//_____________________________________________________________________________
+TObject* THaVarList::Remove( TObject* obj )
+{
+  // Remove object from the list and invalidate handles to it
+
+  TObject* ret = THashList::Remove( obj );
+  if( ret )
+    ReleaseSlot( ret );
+  return ret;
+}
+
+//_____________________________________________________________________________
+void THaVarList::Clear( Option_t* option )
+{
+  // Remove all variables (deleting them, since the list owns them) and
+  // invalidate all handles
+
+  ReleaseAllSlots();
+  THashList::Clear( option );
+}
+
+//_____________________________________________________________________________
+void THaVarList::Delete( Option_t* option )
+{
+  // Delete all variables and invalidate all handles
+
+  ReleaseAllSlots();
+  THashList::Delete( option );
+}
+
 //_____________________________________________________________________________
 void THaVarList::PrintFull( Option_t* option ) const
 {
@@ -11,6 +11,7 @@
 #include "THashList.h"
 #include "THaVar.h"
 #include "VarDef.h"
+#include "VarHandle.h"
 #include <vector>
 
 class THaVarList : public THashList {
@@ -189,7 +190,31 @@ public:
   virtual Int_t    RemoveName( const char* name );
   virtual Int_t    RemoveRegexp( const char* expr, Bool_t wildcard = kTRUE );
 
+  // Handles: resolve a variable once, e.g. at Init, then read it per event
+  // without name lookup. Handles become invalid when the variable is removed.
+  // Only the handle bookkeeping changes, so these work on const lists.
+  Podd::VarHandle  GetHandle( const char* name ) const;
+  Podd::VarHandle  GetHandle( THaVar* var ) const;
+  Bool_t           IsValid( const Podd::VarHandle& handle ) const
+  {
+    return( handle.fList == this && handle.fIndex >= 0 &&
+	    handle.fIndex < static_cast<Int_t>(fSlotGen.size()) &&
+	    fSlotGen[handle.fIndex] == handle.fGen );
+  }
+
+  // Overrides of THashList methods that remove variables
+  using THashList::Remove;
+  virtual TObject* Remove( TObject* obj );
+  virtual void     Clear( Option_t* option="" );
+  virtual void     Delete( Option_t* option="" );
+
 protected:
+  mutable std::vector<THaVar*> fSlots;     //! Variables with handles, by slot
+  mutable std::vector<UInt_t>  fSlotGen;   //! Generation of each slot
+  mutable std::vector<Int_t>   fFreeSlots; //! Released slots available for reuse
+
+  void             ReleaseSlot( TObject* obj );
+  void             ReleaseAllSlots();
 
   ClassDef(THaVarList,2)   //List of analyzer global variables
 };
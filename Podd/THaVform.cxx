@@ -32,7 +32,7 @@ using namespace THaString;
 THaVform::THaVform( const char *type, const char* name, const char* formula,
 		    const THaVarList* vlst, const THaCutList* clst )
   : THaFormula(), fNvar(0), fObjSize(0), fEyeOffset(0), fData(0.0),
-    fType(kUnknown), fVarPtr(NULL), fOdata(NULL), fPrefix(kNoPrefix)
+    fType(kUnknown), fOdata(NULL), fPrefix(kNoPrefix)
 {
   SetName(name);
   SetList(vlst);
@@ -66,7 +66,7 @@ THaVform::THaVform( const THaVform& rhs ) :
   fType(rhs.fType), fAndStr(rhs.fAndStr), fOrStr(rhs.fOrStr),
   fSumStr(rhs.fSumStr), fVarName(rhs.fVarName), fVarStat(rhs.fVarStat),
   fSarray(rhs.fSarray), fVectSform(rhs.fVectSform), fStitle(rhs.fStitle),
-  fVarPtr(rhs.fVarPtr), fOdata(0), fPrefix(rhs.fPrefix)
+  fVarHandle(rhs.fVarHandle), fOdata(0), fPrefix(rhs.fPrefix)
 {
   // Copy ctor
 
@@ -169,7 +169,7 @@ void THaVform::Create(const THaVform &rhs)
   fSarray = rhs.fSarray;
   fVectSform = rhs.fVectSform;
   fStitle = rhs.fStitle;
-  fVarPtr = rhs.fVarPtr;
+  fVarHandle = rhs.fVarHandle;
   delete fOdata; fOdata = 0;
   if( rhs.fOdata )
     fOdata = new THaOdata(*rhs.fOdata);
@@ -324,10 +324,10 @@ Int_t THaVform::Init()
     if (fVarStat[i] == kVAType) {  // This obj is a var. sized array.
       if (StripBracket(fStitle) == fVarName[i]) {
  	 status = 0;
-         fVarPtr = fVarList->Find(fVarName[i].c_str());
-         if (fVarPtr) {
+         fVarHandle = fVarList->GetHandle(fVarName[i].c_str());
+         if (!fVarHandle.IsNull()) {
            fType = kVarArray;
-           fObjSize = fVarPtr->GetLen();
+           fObjSize = fVarHandle.GetLen();
            if (fPrefix == kNoPrefix) {
 	      delete fOdata;
 	      fOdata = new THaOdata();
@@ -356,9 +356,10 @@ Int_t THaVform::Init()
     }
     if (fVarStat[i] != kFAType ) continue;
     pvar1 = fVarList->Find(fVarName[i].c_str());
-    fVarPtr = pvar1; // Store one pointer to be able to get the size
-                     // later since it may change. This works since all
-                     // elements were verified to be the same size.
+    // Store one handle to be able to get the size later since it may
+    // change. This works since all elements were verified to be the
+    // same size.
+    fVarHandle = fVarList->GetHandle(pvar1);
     if (i == fNvar) continue;
     for (Int_t j = i+1; j < fNvar; ++j) {
       if (fVarStat[j] != kFAType ) continue;
@@ -382,14 +383,14 @@ Int_t THaVform::Init()
   }
 
   Int_t varsize = 1;
-  if (fVarPtr) varsize = fVarPtr->GetLen();
+  if (!fVarHandle.IsNull()) varsize = fVarHandle.GetLen();
 
   status = MakeFormula(0, varsize);
 
   if (status != 0) return status;
 
-  if (fVarPtr) {
-    fObjSize = fVarPtr->GetLen();
+  if (!fVarHandle.IsNull()) {
+    fObjSize = fVarHandle.GetLen();
     if (fPrefix == kNoPrefix) {
        delete fOdata;
        fOdata = new THaOdata();
@@ -412,7 +413,7 @@ void THaVform::ReAttach( )
 // THaCut's and THaFormula's to reattach to variables.
   for (Int_t i = 0; i < fNvar; ++i) {
     if (fVarStat[i] != kFAType ) continue;
-    fVarPtr = fVarList->Find(fVarName[i].c_str());
+    fVarHandle = fVarList->GetHandle(fVarName[i].c_str());
     break;
   }
   for (vector<THaCut*>::iterator itc = fCut.begin();
@@ -656,18 +657,19 @@ Int_t THaVform::Process()
 
     case kNoPrefix:
       // Standard case first
-      if (fOdata) {
-	fObjSize = fVarPtr->GetLen();
+      // The handle is invalid if the variable was removed since Init()
+      if (fOdata && fVarHandle.IsValid()) {
+	fObjSize = fVarHandle.GetLen();
 	// Fill array in reverse order so that fOdata is resized just once
 	Int_t i = fObjSize;
 	Bool_t first = true;
 	while( i-- > 0 ) {
 	  // FIXME: for better efficiency, should use pointer to data and
 	  // Fill(int n,double* data) method in case of a contiguous array
-	  if (fOdata->Fill(i,fVarPtr->GetValue(i)) != 1 && first ) {
+	  if (fOdata->Fill(i,fVarHandle.GetValue(i)) != 1 && first ) {
 	    cout << "THaVform::ERROR: storing too much";
 	    cout << " variable sized data: ";
-	    cout << fVarPtr->GetName() <<"  "<<fVarPtr->GetLen()<<endl;
+	    cout << fVarHandle.GetName() <<"  "<<fVarHandle.GetLen()<<endl;
 	    first = false;
 	  }
 	}
@@ -680,9 +682,9 @@ Int_t THaVform::Process()
 
     case kSum:
       {
-	Int_t i = fVarPtr->GetLen();
+	Int_t i = fVarHandle.IsValid() ? fVarHandle.GetLen() : 0;
 	while( i-- > 0 )
-	  fData += fVarPtr->GetValue(i);
+	  fData += fVarHandle.GetValue(i);
 	fObjSize = 1;
       }
       break;
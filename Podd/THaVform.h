@@ -25,7 +25,7 @@ class THaVform : public THaFormula {
 public:
 
   THaVform() : THaFormula(), fNvar(0), fObjSize(0), fEyeOffset(0),
-    fData(0), fType(kUnknown), fVarPtr(0), fOdata(0), fPrefix(0) {}
+    fData(0), fType(kUnknown), fOdata(0), fPrefix(0) {}
   THaVform( const char *type, const char* name, const char* formula,
       const THaVarList* vlst=gHaVars, const THaCutList* clst=gHaCuts );
   virtual  ~THaVform();
@@ -59,7 +59,7 @@ public:
 // an "eye" ("[I]" variable)
 
   Bool_t IsFormula() const { return (fType == kForm); }
-  Bool_t IsVarray() const  { return (fVarPtr != NULL && fType == kVarArray); }
+  Bool_t IsVarray() const  { return (!fVarHandle.IsNull() && fType == kVarArray); }
   Bool_t IsCut() const     { return (fType == kCut); }
   Bool_t IsEye() const     { return (fType == kEye); }
 // Get the size (dimension) of this object
@@ -96,7 +96,7 @@ protected:
   std::vector<std::string> fSarray;
   std::vector<std::string> fVectSform;
   std::string   fStitle;
-  THaVar   *fVarPtr;
+  Podd::VarHandle fVarHandle; // Array variable used for the size, or var. sized array
   THaOdata *fOdata;
   Int_t fPrefix;
 
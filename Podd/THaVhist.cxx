@@ -35,6 +35,7 @@
 #include "TError.h"
 #include "TROOT.h"
 #include <algorithm>
+#include <cassert>
 #include <fstream>
 #include <cstring>
 #include <iostream>
@@ -47,7 +48,8 @@ THaVhist::THaVhist( const string& type, const string& name,
 		    const string& title ) :
   fType(type), fName(name), fTitle(title), fNbinX(0), fNbinY(0), fSize(0),
   fInitStat(0), fScalar(0), fEye(0), fEyeOffset(0), fXlo(0.), fXhi(0.), fYlo(0.), fYhi(0.),
-  fFirst(kTRUE), fProc(kTRUE), fFormX(NULL), fFormY(NULL), fCut(NULL),
+  fFirst(kTRUE), fProc(kTRUE), fFillBuf(fgFILLBUF),
+  fFormX(NULL), fFormY(NULL), fCut(NULL),
   fMyFormX(kFALSE), fMyFormY(kFALSE), fMyCut(kFALSE)
 { 
   fH1.clear();
@@ -104,6 +106,8 @@ Int_t THaVhist::Init( )
   for (std::vector<TH1*>::iterator ith = fH1.begin();
        ith != fH1.end(); ++ith) delete *ith;
   fH1.clear();
+  fBufX.clear();
+  fBufY.clear();
   fInitStat = 0;
   Int_t status;
   string sname;
@@ -435,6 +439,8 @@ Int_t THaVhist::BookHisto(Int_t hfirst, Int_t hlast)
       }
     }
   }
+  fBufX.resize(fH1.size());
+  fBufY.resize(fH1.size());
   return 0;
 }
  
@@ -499,23 +505,23 @@ Int_t THaVhist::Process()
       //  (diagonal elements of the XY index matrix)
       Int_t n = (sizex == 0 || sizey == 0) ? max(sizex,sizey) : min(sizex,sizey);
       if(ldebug) cout << "THaVhist :: Process   n  "<<n<<endl;
+      // A cut that does not track the index only needs to be checked once
+      if ( ic == &zero && n > 0 && CheckCut()==0 ) return 0;
       for ( ; i < n; ++i) {
 	//        cout << "THaVhist :: proc loop: data  "<<i<<"  "<<fFormX->GetData(*ix)<<"   "<<fFormY->GetData(*iy)<<"  *ic "<<*ic<<endl<<flush;
-	if ( CheckCut(*ic)==0 ) continue;
+	if ( ic != &zero && CheckCut(*ic)==0 ) continue;
 	//  cout << "THaVhist :: proc loop:     FILLING HISTO "<<i<<endl;
- 	fH1[0]->Fill(fFormX->GetData(*ix), fFormY->GetData(*iy));
+ 	Fill(0, fFormX->GetData(*ix), fFormY->GetData(*iy));
       }
 
     } else {  // 1D histo
       
+      Bool_t cut_each = (sizec == sizex);
+      if ( !cut_each && sizex > 0 && CheckCut()==0 ) return 0;
       for (Int_t i = 0; i < sizex; ++i) {
         if(ldebug) cout << "THaVhist :: 1D histo "<<i<<"  "<<sizec<<endl;
-        if (sizec == sizex) {
-  	   if ( CheckCut(i)==0 ) continue;
-	} else {
- 	   if ( CheckCut()==0 ) continue;
-	}
-	fH1[0]->Fill(fFormX->GetData(i));
+        if ( cut_each && CheckCut(i)==0 ) continue;
+	Fill(0, fFormX->GetData(i));
       }
     }
 
@@ -535,12 +541,12 @@ Int_t THaVhist::Process()
     if( fFormY ) {
       for (i = 0; i < fSize; ++i) {
 	if ( CheckCut(i)==0 ) continue; 
-	fH1[*idx]->Fill(fFormX->GetData(i), fFormY->GetData(i));
+	Fill(*idx, fFormX->GetData(i), fFormY->GetData(i));
       }
     } else {
       for (i = 0; i < fSize; ++i) {
 	if ( CheckCut(i)==0 ) continue; 
-	fH1[*idx]->Fill(fFormX->GetData(i));
+	Fill(*idx, fFormX->GetData(i));
       }
     }
   }
@@ -548,9 +554,70 @@ Int_t THaVhist::Process()
   return 0;
 }
 
+//_____________________________________________________________________________
+void THaVhist::GetVarNames(set<string>& names) const
+{
+  // Names of the global variables used by the X, Y and cut formulas
+
+  THaVform* forms[] = { fFormX, fFormY, fCut };
+  for (size_t k = 0; k < sizeof(forms)/sizeof(forms[0]); ++k) {
+    if (!forms[k]) continue;
+    vector<string> vars = forms[k]->GetVars();
+    names.insert(vars.begin(), vars.end());
+    forms[k]->GetVarNames(names);
+  }
+}
+
+//_____________________________________________________________________________
+void THaVhist::FlushHisto(Int_t ih)
+{
+  // Fill the buffered entries of histogram ih in bulk
+
+  vector<Double_t>& bufx = fBufX[ih];
+  Int_t n = bufx.size();
+  if (n == 0) return;
+  static const vector<Double_t> unit_weights(fgFILLBUF, 1.0);
+  assert( n <= fgFILLBUF );
+  TH1* h = fH1[ih];
+  if (!fFormY) {
+    h->FillN(n, &bufx[0], &unit_weights[0]);
+  } else {
+    vector<Double_t>& bufy = fBufY[ih];
+    assert( static_cast<Int_t>(bufy.size()) == n );
+    if (h->GetDimension() > 1)
+      h->FillN(n, &bufx[0], &bufy[0], &unit_weights[0], 1);
+    else
+      // 1D histogram with a Y variable: TH1::Fill(x,y) takes y as weight
+      h->FillN(n, &bufx[0], &bufy[0]);
+    bufy.clear();
+  }
+  bufx.clear();
+}
+
+//_____________________________________________________________________________
+void THaVhist::Flush()
+{
+  // Fill all buffered entries into the histograms
+
+  for (Int_t ih = 0; ih < static_cast<Int_t>(fBufX.size()); ++ih)
+    FlushHisto(ih);
+}
+
+//_____________________________________________________________________________
+void THaVhist::SetBuffered(Bool_t b)
+{
+  // Enable or disable buffering of entries. Without buffering, each entry
+  // is filled into the histogram immediately, so the histograms are always
+  // up to date.
+
+  Flush();
+  fFillBuf = b ? fgFILLBUF : 1;
+}
+
 //_____________________________________________________________________________
 Int_t THaVhist::End() 
 {
+  Flush();
   for (vector<TH1* >::iterator ith = fH1.begin(); 
       ith != fH1.end(); ++ith ) (*ith)->Write();
   return 0;
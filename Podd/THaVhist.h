@@ -10,6 +10,7 @@
 #include "THaVform.h"
 #include "TTree.h"
 #include <vector>
+#include <set>
 #include <string>
 
 class THaVar;
@@ -48,6 +49,12 @@ public:
    Int_t Process();
 // Must End() to write histogram to output at end of analysis.
    Int_t End();
+// Fill buffered entries into the histograms. Done automatically by End().
+   void  Flush();
+// Buffer entries and fill in bulk (default), or fill every entry at once,
+// e.g. when histograms are viewed while the analysis is running.
+   void  SetBuffered(Bool_t b = kTRUE);
+   Bool_t IsBuffered() const { return fFillBuf > 1; }
 // Self-explanatory printouts.
    void  Print() const;
    void  ErrPrint() const;
@@ -57,6 +64,8 @@ public:
 // IsScalar() is kTRUE if histogram is a scalar.
    Bool_t IsScalar() { return (fScalar==1); };
    Int_t GetSize() { return fSize; };
+// Add names of the global variables this histogram depends on to 'names'
+   void  GetVarNames(std::set<std::string>& names) const;
 
 protected:
 
@@ -66,6 +75,9 @@ protected:
    Bool_t FindEye(const string& var);
    Bool_t FindEyeOffset(const string& var);
    Int_t GetCut(Int_t index=0); 
+   void  Fill(Int_t ih, Double_t x);
+   void  Fill(Int_t ih, Double_t x, Double_t y);
+   void  FlushHisto(Int_t ih);
 
    enum FEr { kOK = 0, kNoBinX, kIllFox, kIllFoy, kIllCut,
               kNoX, kAxiSiz, kCutSix, kCutSiy,
@@ -73,13 +85,17 @@ protected:
 
    static const int fgVERBOSE = 1;
    static const int fgVHIST_HUGE = 10000;
+   static const int fgFILLBUF = 128;  // Entries buffered per histogram
 
    string fType, fName, fTitle, fVarX, fVarY, fScut;
    Int_t fNbinX, fNbinY, fSize, fInitStat, fScalar, fEye, fEyeOffset;
    Double_t fXlo, fXhi, fYlo, fYhi;
    Bool_t fFirst, fProc;
+   Int_t fFillBuf;   // Entries buffered per histogram before filling (1..fgFILLBUF)
 
    std::vector<TH1* > fH1;
+   // Entries not yet filled into fH1, filled in bulk by FlushHisto()
+   std::vector< std::vector<Double_t> > fBufX, fBufY;
    THaVform *fFormX, *fFormY, *fCut;
    Bool_t fMyFormX, fMyFormY, fMyCut;
 
@@ -147,6 +163,21 @@ Int_t THaVhist::CheckCut(Int_t index) {
   return (fCut) ? Int_t(fCut->GetData(index)) : 1;
 }
 
+inline
+void THaVhist::Fill(Int_t ih, Double_t x)
+{
+  std::vector<Double_t>& bufx = fBufX[ih];
+  bufx.push_back(x);
+  if (bufx.size() >= static_cast<size_t>(fFillBuf)) FlushHisto(ih);
+}
+
+inline
+void THaVhist::Fill(Int_t ih, Double_t x, Double_t y)
+{
+  fBufY[ih].push_back(y);
+  Fill(ih, x);
+}
+
 #endif
 
 
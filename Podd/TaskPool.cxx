@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::TaskPool
+//
+// A fixed number of worker threads that run tasks submitted with Submit().
+// Wait() blocks until all tasks submitted so far have finished. The
+// calling thread works on the queue as well while it waits, so a pool
+// with N threads runs up to N+1 tasks at once.
+//
+// Tasks are submitted and waited for in batches, typically one batch per
+// analysis stage, so Wait() acts as the barrier between stages. Tasks
+// must not throw; catch any exceptions in Task::Run().
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "TaskPool.h"
+#include "TThread.h"
+#include "TMutex.h"
+#include "TCondition.h"
+
+namespace Podd {
+
+//_____________________________________________________________________________
+TaskPool::TaskPool( UInt_t nthreads )
+  : fMutex(new TMutex), fWork(0), fDone(0), fNext(0), fPending(0),
+    fStop(kFALSE)
+{
+  // Constructor. Starts 'nthreads' worker threads.
+
+  TThread::Initialize();
+  fWork = new TCondition(fMutex);
+  fDone = new TCondition(fMutex);
+  fThreads.reserve(nthreads);
+  for( UInt_t i = 0; i < nthreads; ++i ) {
+    TThread* th = new TThread( Worker, this );
+    fThreads.push_back(th);
+    th->Run();
+  }
+}
+
+//_____________________________________________________________________________
+TaskPool::~TaskPool()
+{
+  // Destructor. Stops the worker threads after the tasks that are
+  // currently running have finished. Tasks not yet started are dropped.
+
+  fMutex->Lock();
+  fStop = kTRUE;
+  fWork->Broadcast();
+  fMutex->UnLock();
+  for( UInt_t i = 0; i < fThreads.size(); ++i ) {
+    fThreads[i]->Join();
+    delete fThreads[i];
+  }
+  delete fDone;
+  delete fWork;
+  delete fMutex;
+}
+
+//_____________________________________________________________________________
+void TaskPool::Submit( Task* task )
+{
+  // Queue 'task' for execution. The task is not owned by the pool and
+  // must remain valid until Wait() returns.
+
+  fMutex->Lock();
+  fQueue.push_back(task);
+  ++fPending;
+  fWork->Signal();
+  fMutex->UnLock();
+}
+
+//_____________________________________________________________________________
+void TaskPool::Wait()
+{
+  // Run queued tasks in the calling thread until the queue is empty, then
+  // wait for the tasks still running in worker threads to finish.
+
+  fMutex->Lock();
+  while( Task* task = Next() ) {
+    fMutex->UnLock();
+    task->Run();
+    fMutex->Lock();
+    Finish();
+  }
+  while( fPending > 0 )
+    fDone->Wait();
+  fQueue.clear();
+  fNext = 0;
+  fMutex->UnLock();
+}
+
+//_____________________________________________________________________________
+TaskPool::Task* TaskPool::Next()
+{
+  // Next task to start, or null if there is none. Call with fMutex locked.
+
+  if( fNext < fQueue.size() )
+    return fQueue[fNext++];
+  return 0;
+}
+
+//_____________________________________________________________________________
+void TaskPool::Finish()
+{
+  // Count a task as finished. Call with fMutex locked.
+
+  if( --fPending == 0 )
+    fDone->Broadcast();
+}
+
+//_____________________________________________________________________________
+void TaskPool::Loop()
+{
+  // Main loop of the worker threads
+
+  fMutex->Lock();
+  while( true ) {
+    Task* task = 0;
+    while( !fStop && !(task = Next()) )
+      fWork->Wait();
+    if( fStop )
+      break;
+    fMutex->UnLock();
+    task->Run();
+    fMutex->Lock();
+    Finish();
+  }
+  fMutex->UnLock();
+}
+
+//_____________________________________________________________________________
+void* TaskPool::Worker( void* arg )
+{
+  // Thread function
+
+  static_cast<TaskPool*>(arg)->Loop();
+  return 0;
+}
+
+} // namespace Podd
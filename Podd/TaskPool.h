@@ -0,0 +1,58 @@
+#ifndef Podd_TaskPool_h_
+#define Podd_TaskPool_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::TaskPool
+//
+// Fixed set of worker threads running batches of tasks
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "Rtypes.h"
+#include <vector>
+
+class TThread;
+class TMutex;
+class TCondition;
+
+namespace Podd {
+
+  class TaskPool {
+
+  public:
+    class Task {
+    public:
+      virtual ~Task() {}
+      virtual void Run() = 0;
+    };
+
+    explicit TaskPool( UInt_t nthreads );
+    ~TaskPool();
+
+    void      Submit( Task* task );
+    void      Wait();
+    UInt_t    GetNthreads() const { return static_cast<UInt_t>(fThreads.size()); }
+
+  private:
+    TMutex*      fMutex;     // Protects all members below
+    TCondition*  fWork;      // Signaled when tasks are submitted or on stop
+    TCondition*  fDone;      // Signaled when the last pending task finishes
+    std::vector<TThread*> fThreads;
+    std::vector<Task*>    fQueue;   // Tasks of the current batch
+    UInt_t       fNext;      // Index of next task to start in fQueue
+    UInt_t       fPending;   // Tasks submitted, but not yet finished
+    Bool_t       fStop;      // Tell worker threads to exit
+
+    Task*        Next();
+    void         Finish();
+    void         Loop();
+    static void* Worker( void* arg );
+
+    TaskPool( const TaskPool& );
+    TaskPool& operator=( const TaskPool& );
+  };
+
+} // namespace Podd
+
+#endif
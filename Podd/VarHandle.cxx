@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::VarHandle
+//
+// A resolved reference to a global variable, obtained from
+// THaVarList::GetHandle(). Consumers that access the same variables in
+// every event (output, formulas, histograms) look them up once at
+// initialization and keep the handle.
+//
+// For variables holding basic data in plain memory (scalars, fixed and
+// variable-size arrays of basic type), the handle caches the data address
+// and a reader for the data type, so GetValue() reads the memory directly
+// instead of going through THaVar and its implementation class.
+//
+// A handle remembers the generation of its slot in the THaVarList. If the
+// variable is removed from the list, IsValid() returns false and GetVar()
+// returns 0, even if a new variable with the same name has been defined.
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "VarHandle.h"
+#include "THaVarList.h"
+
+namespace Podd {
+
+//_____________________________________________________________________________
+template< typename T >
+static Double_t ReadValue( const void* data, Int_t i )
+{
+  return static_cast<const T*>(data)[i];
+}
+
+//_____________________________________________________________________________
+Bool_t VarHandle::IsValid() const
+{
+  // True if this handle refers to a variable that still exists
+
+  return fList && fList->IsValid(*this);
+}
+
+//_____________________________________________________________________________
+void VarHandle::SetDirect()
+{
+  // Set up direct memory access, if the variable supports it
+
+  fRead = 0;
+  if( !fVar || !fVar->GetDirectAccess(fLoc,fIndirect) )
+    return;
+
+  // Element types as interpreted by Podd::Variable::GetValue
+  VarType type = fVar->GetType();
+  if( type >= kDoubleP && type <= kUCharP )
+    type = static_cast<VarType>( type - kDoubleP + kDouble );
+  switch( type ) {
+  case kDouble: fRead = &ReadValue<Double_t>;  break;
+  case kFloat:  fRead = &ReadValue<Float_t>;   break;
+  case kLong:   fRead = &ReadValue<Long64_t>;  break;
+  case kULong:  fRead = &ReadValue<ULong64_t>; break;
+  case kInt:    fRead = &ReadValue<Int_t>;     break;
+  case kUInt:   fRead = &ReadValue<UInt_t>;    break;
+  case kShort:  fRead = &ReadValue<Short_t>;   break;
+  case kUShort: fRead = &ReadValue<UShort_t>;  break;
+  case kChar:   fRead = &ReadValue<Char_t>;    break;
+  case kUChar:  fRead = &ReadValue<UChar_t>;   break;
+  default:      break;
+  }
+}
+
+} // namespace Podd
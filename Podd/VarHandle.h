@@ -0,0 +1,66 @@
+#ifndef Podd_VarHandle_h_
+#define Podd_VarHandle_h_
+
+//////////////////////////////////////////////////////////////////////////
+//
+// Podd::VarHandle
+//
+// Resolved reference to a global variable in a THaVarList
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "THaVar.h"
+
+class THaVarList;
+
+namespace Podd {
+
+  class VarHandle {
+
+  public:
+    VarHandle() : fList(0), fVar(0), fIndex(-1), fGen(0),
+		  fLoc(0), fIndirect(kFALSE), fRead(0) {}
+
+    Bool_t      IsNull()   const { return fIndex < 0; }
+    Bool_t      IsValid()  const;
+    Bool_t      IsDirect() const { return fRead != 0; }
+    THaVar*     GetVar()   const { return IsValid() ? fVar : 0; }
+    const char* GetName()  const { return fVar ? fVar->GetName() : ""; }
+
+    // Per-event access. The handle must be valid.
+    Int_t       GetLen() const   { return fVar->GetLen(); }
+    Double_t    GetValue( Int_t i = 0 ) const;
+
+  protected:
+    friend class ::THaVarList;
+
+    typedef Double_t (*ReadFunc_t)( const void*, Int_t );
+
+    const THaVarList* fList;     // List that issued this handle
+    THaVar*           fVar;      // The variable
+    Int_t             fIndex;    // Slot number in fList
+    UInt_t            fGen;      // Generation of the slot when resolved
+    const void*       fLoc;      // Data, or pointer to data if fIndirect
+    Bool_t            fIndirect; // fLoc holds the address of a data pointer
+    ReadFunc_t        fRead;     // Typed reader, 0 if not directly readable
+
+    void        SetDirect();
+  };
+
+  //___________________________________________________________________________
+  inline Double_t VarHandle::GetValue( Int_t i ) const
+  {
+    // Return value of element i. Basic-type variables are read directly
+    // from memory; all others go through THaVar::GetValue().
+
+    if( !fRead )
+      return fVar->GetValue(i);
+    const void* data = fIndirect ? *static_cast<const void* const*>(fLoc) : fLoc;
+    if( !data )
+      return THaVar::kInvalid;
+    return fRead( data, i );
+  }
+
+} // namespace Podd
+
+#endif
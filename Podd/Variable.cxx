@@ -295,6 +295,33 @@ const void* Variable::GetDataPointer( Int_t i ) const
   return 0;
 }
 
+//_____________________________________________________________________________
+Bool_t Variable::GetDirectAccess( const void*& loc, Bool_t& indirect ) const
+{
+  // Determine whether this variable's data can be read directly from memory,
+  // bypassing GetValue(). If so, return true and set 'loc' and 'indirect'.
+  // The address of element i for the current event is then
+  //
+  //   (indirect ? *(void**)loc : loc) + i*GetTypeSize()
+  //
+  // Only basic-type scalars and contiguous arrays qualify. Method calls,
+  // collections, vectors and pointer arrays always go through GetValue().
+
+  if( !IsBasic() )
+    return kFALSE;
+  if( fType >= kDouble && fType <= kUChar ) {
+    loc = fValueP;
+    indirect = kFALSE;
+    return kTRUE;
+  }
+  if( fType >= kDoubleP && fType <= kUCharP ) {
+    loc = fValueP;
+    indirect = kTRUE;
+    return kTRUE;
+  }
+  return kFALSE;
+}
+
 //_____________________________________________________________________________
 size_t Variable::GetData( void* buf ) const
 {
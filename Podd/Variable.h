@@ -37,6 +37,8 @@ namespace Podd {
     virtual size_t       GetData( void* buf ) const;
     virtual size_t       GetData( void* buf, Int_t i ) const;
 
+            Bool_t       GetDirectAccess( const void*& loc, Bool_t& indirect ) const;
+
     virtual Bool_t       HasSameSize( const Variable& rhs ) const;
     virtual Bool_t       HasSizeVar() const;
     virtual Int_t        Index( const THaArrayString& ) const;
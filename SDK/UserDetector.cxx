@@ -231,6 +231,12 @@ void UserDetector::Clear( Option_t* opt )
 {
   // Reset per-event data. This function is called before Decode() for
   // every event.
+  //
+  // This detector stores only channels with data, so clearing is cheap.
+  // Detectors that keep fixed-size per-element arrays instead can call
+  // MarkFired(k) and, when done, SetFiredValid() in Decode(), and reset
+  // only the elements listed by GetFired() here, followed by ClearFired().
+  // See THaScintillator.
 
   THaNonTrackingDetector::Clear(opt);
   fEvtData.clear();
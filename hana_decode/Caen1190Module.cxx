@@ -49,20 +49,38 @@ namespace Decoder {
 
   Int_t Caen1190Module::LoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, const UInt_t *pstop) {
     // This is a simple, default method for loading a slot
+#ifdef WITH_DEBUG
+    if (fDebugFile != 0)
+      return DoLoadSlot<true>(sldat, evbuffer, pstop);
+#endif
+    return DoLoadSlot<false>(sldat, evbuffer, pstop);
+  }
+
+  Int_t Caen1190Module::LoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, Int_t pos, Int_t len) {
+    // Fill data structures of this class, utilizing bank structure
+#ifdef WITH_DEBUG
+    if (fDebugFile != 0)
+      return DoLoadSlot<true>(sldat, evbuffer, pos, len);
+#endif
+    return DoLoadSlot<false>(sldat, evbuffer, pos, len);
+  }
+
+  template< bool kDebug >
+  Int_t Caen1190Module::DoLoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, const UInt_t *pstop) {
     const UInt_t *p = evbuffer;
     slot_data = sldat;
     fWordsSeen = 0; 		// Word count including global header  
     Int_t glbl_trl = 0;
     while(p <= pstop && glbl_trl == 0) {
-      glbl_trl = Decode(p);
+      glbl_trl = DoDecode<kDebug>(p);
       fWordsSeen++;
       ++p;
     }
     return fWordsSeen;
   }
 
-  Int_t Caen1190Module::LoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, Int_t pos, Int_t len) {
-    // Fill data structures of this class, utilizing bank structure
+  template< bool kDebug >
+  Int_t Caen1190Module::DoLoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, Int_t pos, Int_t len) {
     // Read until out of data or until decode says that the slot is finished
     // len = ndata in event, pos = word number for block header in event
     slot_data = sldat;
@@ -70,13 +88,23 @@ namespace Decoder {
     Int_t index = 0;
     while(fWordsSeen < len) {
       index = pos + fWordsSeen;
-      Decode(&evbuffer[index]);
+      DoDecode<kDebug>(&evbuffer[index]);
       fWordsSeen++;
     }
     return fWordsSeen;
   }
 
   Int_t Caen1190Module::Decode(const UInt_t *p) {
+#ifdef WITH_DEBUG
+    if (fDebugFile != 0)
+      return DoDecode<true>(p);
+#endif
+    return DoDecode<false>(p);
+  }
+
+  template< bool kDebug >
+  Int_t Caen1190Module::DoDecode(const UInt_t *p) {
+    // Decode one data word. Inlined into the LoadSlot loops.
     Int_t glbl_trl = 0;
     switch( *p & 0xf8000000) {
     case 0xc0000000 : // buffer alignment filler word; skip
@@ -85,13 +113,11 @@ namespace Decoder {
       	tdc_data.glb_hdr_evno = (*p & 0x07ffffe0) >> 5; // bits 26-5
 	tdc_data.glb_hdr_slno =  *p & 0x0000001f;       // bits 4-0
 	if (tdc_data.glb_hdr_slno == static_cast <UInt_t> (fSlot)) {
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 GLOBAL HEADER >> data = " 
 		      << hex << *p << " >> event number = " << dec 
 		      << tdc_data.glb_hdr_evno << " >> slot number = "  
 		      << tdc_data.glb_hdr_slno << endl;
-#endif
       }
       break;
     case 0x08000000 : // tdc header
@@ -99,14 +125,12 @@ namespace Decoder {
 	tdc_data.hdr_chip_id  = (*p & 0x03000000) >> 24; // bits 25-24
 	tdc_data.hdr_event_id = (*p & 0x00fff000) >> 12; // bits 23-12
 	tdc_data.hdr_bunch_id =  *p & 0x00000fff;        // bits 11-0
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 TDC HEADER >> data = " 
 		      << hex << *p << " >> chip id = " << dec 
 		      << tdc_data.hdr_chip_id  << " >> event id = "
 		      << tdc_data.hdr_event_id << " >> bunch_id = "
 		      << tdc_data.hdr_bunch_id << endl;
-#endif
       }
       break;
     case  0x00000000 : // tdc measurement
@@ -114,14 +138,12 @@ namespace Decoder {
 	tdc_data.chan   = (*p & 0x03f80000)>>19; // bits 25-19
 	tdc_data.raw    =  *p & 0x0007ffff;      // bits 18-0
 	tdc_data.status = slot_data->loadData("tdc", tdc_data.chan, tdc_data.raw, tdc_data.raw);
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 MEASURED DATA >> data = " 
 		      << hex << *p << " >> channel = " << dec
 		      << tdc_data.chan << " >> raw time = "
 		      << tdc_data.raw << " >> status = "
 		      << tdc_data.status << endl;
-#endif
 	if(Int_t (tdc_data.chan) < NTDCCHAN) 
 	  if(fNumHits[tdc_data.chan] < MAXHIT)
 	    fTdcData[tdc_data.chan*MAXHIT + fNumHits[tdc_data.chan]++] = tdc_data.raw;
@@ -133,14 +155,12 @@ namespace Decoder {
 	tdc_data.trl_chip_id     = (*p & 0x03000000) >> 24; // bits 25-24
 	tdc_data.trl_event_id    = (*p & 0x00fff000) >> 12; // bits 23-12
 	tdc_data.trl_word_cnt    =  *p & 0x00000fff;        // bits 11-0
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 TDC TRAILER >> data = " 
 		      << hex << *p << " >> chip id = " << dec 
 		      << tdc_data.trl_chip_id  << " >> event id = "
 		      << tdc_data.trl_event_id << " >> word count = "
 		      << tdc_data.trl_word_cnt << endl;
-#endif
       }
       break;
     case 0x20000000 : // tdc error
@@ -149,13 +169,11 @@ namespace Decoder {
 	tdc_data.flags      =  *p & 0x00007fff;	       // bits 14-0
 	cout << "TDC1190 Error: Slot " << tdc_data.glb_hdr_slno << ", Chip " << tdc_data.chip_nr_hd << 
 	  ", Flags " << hex << tdc_data.flags << dec << " " << ", Ev #" << tdc_data.glb_hdr_evno << endl;
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 TDC ERROR >> data = " 
 		      << hex << *p << " >> chip header = " << dec
 		      << tdc_data.chip_nr_hd << " >> error flags = " << hex
 		      << tdc_data.flags << dec << endl;
-#endif
 	break;
       default:	// unknown word
 	cout << "unknown word for TDC1190: " << hex << (*p) << dec << endl;
@@ -165,12 +183,10 @@ namespace Decoder {
     case 0x88000000 :  // extended trigger time tag
       if (tdc_data.glb_hdr_slno == static_cast <UInt_t> (fSlot)) {
 	tdc_data.trig_time = *p & 0x7ffffff; // bits 27-0
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 GLOBAL TRIGGER TIME >> data = " 
 		      << hex << *p << " >> trigger time = " << dec
 		      << tdc_data.trig_time << endl;
-#endif
       }
       break;
     case 0x80000000 : // global trailer
@@ -178,14 +194,12 @@ namespace Decoder {
        tdc_data.glb_trl_status  = (*p & 0x07000000) >> 24; // bits 24-26
        tdc_data.glb_trl_wrd_cnt = (*p & 0x001fffe0) >> 5;  // bits 20-5
        tdc_data.glb_trl_slno    =  *p & 0x0000001f;        // bits 4-0   
-#ifdef WITH_DEBUG
-	if (fDebugFile != 0)
+	if (kDebug)
 	  *fDebugFile << "Caen1190Module:: 1190 GLOBAL TRAILER >> data = " 
 		      << hex << *p << " >> status = "
 		      << tdc_data.glb_trl_status << " >> word count = " << dec 
 		      << tdc_data.glb_trl_wrd_cnt << " >> slot number = "  
 		      << tdc_data.glb_trl_slno << endl;
-#endif
 	glbl_trl = 1;
       }
       break;
@@ -36,6 +36,12 @@ namespace Decoder {
 
   private:
 
+    template< bool kDebug > Int_t DoDecode(const UInt_t *p);
+    template< bool kDebug >
+    Int_t DoLoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, const UInt_t *pstop);
+    template< bool kDebug >
+    Int_t DoLoadSlot(THaSlotData *sldat, const UInt_t *evbuffer, Int_t pos, Int_t len);
+
     Int_t *fNumHits;
     Int_t *fTdcData;  // Raw data
 
@@ -23,7 +23,7 @@ namespace Decoder {
 
 //_____________________________________________________________________________
 CodaDecoder::CodaDecoder() :
-  nroc(0), irn(MAXROC,0), fbfound(MAXROC*MAXSLOT,false), psfact(MAX_PSFACT,-1),
+  nroc(0), irn(MAXROC,0), rocinfo(MAXROC), fbfound(MAXROC*MAXSLOT,false), psfact(MAX_PSFACT,-1),
   fdfirst(kTRUE), chkfbstat(1), evcnt_coda3(0)
 {
   fNeedInit=true;
@@ -136,11 +136,13 @@ Int_t CodaDecoder::LoadEvent(const UInt_t* evbuffer)
   if (event_type <= MAX_PHYS_EVTYPE) {
      if (fDataVersion == 3) {
          event_num = ++evcnt_coda3;
-         FindRocsCoda3(evbuffer);
+         ret = FindRocsCoda3(evbuffer);
      } else {
          event_num = evbuffer[4];
-         FindRocs(evbuffer);
+         ret = FindRocs(evbuffer);
      }
+     if( ret != HED_OK )
+       return ret;
      recent_event = event_num;
 
      if (fdfirst && (fDebugFile!=0)) {
@@ -155,10 +157,11 @@ Int_t CodaDecoder::LoadEvent(const UInt_t* evbuffer)
 
       Int_t iroc = irn[i];
       const RocDat_t* proc = rocdat+iroc;
+      const RocInfo_t& info = rocinfo[iroc];
       Int_t ipt = proc->pos + 1;
       Int_t iptmax = proc->pos + proc->len;
 
-      if (fMap->isFastBus(iroc)) {  // checking that slots found = expected
+      if (info.fastbus) {  // checking that slots found = expected
 	  if (GetEvNum() > 200 && chkfbstat < 3) chkfbstat=2;
 	  if (chkfbstat == 1) ChkFbSlot(iroc, evbuffer, ipt, iptmax);
 	  if (chkfbstat == 2) {
@@ -171,7 +174,7 @@ Int_t CodaDecoder::LoadEvent(const UInt_t* evbuffer)
 
  // If at least one module is in a bank, must split the banks for this roc
 
-      if (fMap->isBankStructure(iroc)) {
+      if (info.bank) {
 	  if (fDebugFile) *fDebugFile << "\nCodaDecode::Calling bank_decode "<<i<<"   "<<iroc<<"  "<<ipt<<"  "<<iptmax<<endl;
 	  /*status =*/ bank_decode(iroc,evbuffer,ipt,iptmax);
       }
@@ -190,6 +193,35 @@ Int_t CodaDecoder::LoadEvent(const UInt_t* evbuffer)
 }
 
 
+//_____________________________________________________________________________
+Int_t CodaDecoder::PeekEventType( const UInt_t* evbuffer, Int_t coda_version )
+{
+  // Return the type of the event in evbuffer, as LoadEvent would determine
+  // it, from the event header alone. Allows selecting events without
+  // decoding them. Returns -1 if the CODA version is not supported.
+
+  assert( evbuffer );
+  UInt_t tag = evbuffer[1]>>16;
+  if( coda_version == 2 )
+    return tag;
+  if( coda_version != 3 )
+    return -1;
+  if( tag < 0xff00 )  // User event type
+    return tag;
+  switch( tag ) {
+  case 0xffd1:
+    return PRESTART_EVTYPE;
+  case 0xffd2:
+    return GO_EVTYPE;
+  case 0xffd4:
+    return END_EVTYPE;
+  case 0xff50:
+  case 0xff70:
+    return 1;         // Physics event
+  }
+  return 0;
+}
+
 //_____________________________________________________________________________
 Int_t CodaDecoder::interpretCoda3(const UInt_t* evbuffer)
 {
@@ -304,8 +336,8 @@ Int_t CodaDecoder::LoadFromMultiBlock()
   for( Int_t i=0; i<nroc; i++ ) {
 
       Int_t roc = irn[i];
-      Int_t minslot = fMap->getMinSlot(roc);
-      Int_t maxslot = fMap->getMaxSlot(roc);
+      Int_t minslot = rocinfo[roc].minslot;
+      Int_t maxslot = rocinfo[roc].maxslot;
       for (Int_t slot = minslot; slot <= maxslot; slot++) {
  // for CODA3, cross-check the block size (found in trigger bank and, separately, in modules)
         if(fDebugFile) *fDebugFile << "cross chk blk size "<<roc<<"  "<<slot<<"  "<<crateslot[idx(roc,slot)]->GetModule()->GetBlockSize()<<"   "<<block_size<<endl;;
@@ -325,13 +357,27 @@ Int_t CodaDecoder::LoadFromMultiBlock()
 Int_t CodaDecoder::roc_decode( Int_t roc, const UInt_t* evbuffer,
 				  Int_t ipt, Int_t istop )
 {
-  // Decode a Readout controller
+  // Decode a Readout controller.
+  // The version of the decoding loop with debug output is used only if a
+  // debug file is set. Unlike the per-word module loops, it is available
+  // in all builds, so SetDebugFile() always enables roc_decode output.
+  if (fDebugFile)
+    return DoRocDecode<true>( roc, evbuffer, ipt, istop );
+  return DoRocDecode<false>( roc, evbuffer, ipt, istop );
+}
+
+//_____________________________________________________________________________
+template< bool kDebug >
+Int_t CodaDecoder::DoRocDecode( Int_t roc, const UInt_t* evbuffer,
+				Int_t ipt, Int_t istop )
+{
   assert( evbuffer && fMap );
   if( fDoBench ) fBench->Begin("roc_decode");
   Int_t slot;
-  Int_t Nslot = fMap->getNslot(roc);
-  Int_t minslot = fMap->getMinSlot(roc);
-  Int_t maxslot = fMap->getMaxSlot(roc);
+  const RocInfo_t& info = rocinfo[roc];
+  Int_t Nslot = info.nslot;
+  Int_t minslot = info.minslot;
+  Int_t maxslot = info.maxslot;
   Int_t retval = HED_OK;
   Int_t nwords;
   synchmiss = false;
@@ -355,7 +401,7 @@ Int_t CodaDecoder::roc_decode( Int_t roc, const UInt_t* evbuffer,
     goto err;
   }
 
-  if (fMap->isFastBus(roc)) {  // higher slot # appears first in multiblock mode
+  if (info.fastbus) {  // higher slot # appears first in multiblock mode
       firstslot=maxslot;       // the decoding order improves efficiency
       incrslot = -1;
   } else {
@@ -363,7 +409,7 @@ Int_t CodaDecoder::roc_decode( Int_t roc, const UInt_t* evbuffer,
       incrslot = 1;
   }
 
-  if (fDebugFile) {
+  if (kDebug) {
     *fDebugFile << "CodaDecode:: roc_decode:: roc#  "<<dec<<roc<<" nslot "<<Nslot<<endl;
     *fDebugFile << "CodaDecode:: roc_decode:: firstslot "<<dec<<firstslot<<"  incrslot "<<incrslot<<endl;
   }
@@ -373,7 +419,7 @@ Int_t CodaDecoder::roc_decode( Int_t roc, const UInt_t* evbuffer,
 
   while ( p++ < pstop && n_slots_done < Nslot ) {
 
-    if (fDebugFile) {
+    if (kDebug) {
 	 *fDebugFile << "CodaDecode::roc_decode:: evbuff "<<(p-evbuffer)<<"  "<<hex<<*p<<dec<<endl;
 	 *fDebugFile << "CodaDecode::roc_decode:: n_slots_done "<<n_slots_done<<"  "<<firstslot<<endl;
     }
@@ -399,7 +445,7 @@ Int_t CodaDecoder::roc_decode( Int_t roc, const UInt_t* evbuffer,
 
       ++n_slots_checked;
 
-     if (fDebugFile) {
+     if (kDebug) {
        *fDebugFile<< "roc_decode:: slot logic "<<roc<<"  "<<slot<<"  "<<firstslot<<"  "<<n_slots_checked<<"  "<<Nslot-n_slots_done<<endl;
      }
 
@@ -409,14 +455,14 @@ Int_t CodaDecoder::roc_decode( Int_t roc, const UInt_t* evbuffer,
 	   p = p + nwords - 1;
 	   fMap->setSlotDone(slot);
 	   n_slots_done++;
-	   if(fDebugFile) *fDebugFile << "CodaDecode::  slot "<<slot<<"  is DONE    "<<nwords<<endl;
+	   if (kDebug) *fDebugFile << "CodaDecode::  slot "<<slot<<"  is DONE    "<<nwords<<endl;
 	   slotdone = kTRUE;
       }
 
       if (crateslot[idx(roc,slot)]->IsMultiBlockMode()) fMultiBlockMode = kTRUE;
       if (crateslot[idx(roc,slot)]->BlockIsDone()) fBlockIsDone = kTRUE;
 
-      if (fDebugFile) {
+      if (kDebug) {
 	  *fDebugFile<< "CodaDecode:: roc_decode:: after LoadIfSlot "<<p << "  "<<pstop<<"  "<<"  "<<hex<<*p<<"  "<<dec<<nwords<<endl;
       }
 
@@ -572,14 +618,13 @@ Int_t CodaDecoder::FindRocs(const UInt_t *evbuffer) {
   // The following line is not meaningful for CODA3
   if( (evbuffer[1]&0xffff) != 0x10cc ) std::cout<<"Warning, header error"<<std::endl;
   if( event_type > MAX_PHYS_EVTYPE ) std::cout<<"Warning, Event type makes no sense"<<std::endl;
-  memset(rocdat,0,MAXROC*sizeof(RocDat_t));
+  ClearRocs();
   // Set pos to start of first ROC data bank
   Int_t pos = evbuffer[2]+3;  // should be 7
-  nroc = 0;
   while( pos+1 < event_length && nroc < MAXROC ) {
     Int_t len  = evbuffer[pos];
     Int_t iroc = (evbuffer[pos+1]&0xff0000)>>16;
-    if( iroc>=MAXROC ) {
+    if( iroc>=MAXROC || pos+len >= event_length ) {
 #ifdef FIXME
       if(fDebug>0) {
 	cout << "ERROR in EvtTypeHandler::FindRocs "<<endl;
@@ -587,6 +632,7 @@ Int_t CodaDecoder::FindRocs(const UInt_t *evbuffer) {
       }
       if( fDoBench ) fBench->Stop("physics_decode");
 #endif
+      ClearRocs();
       return HED_ERR;
     }
     // Save position and length of each found ROC data block
@@ -617,12 +663,20 @@ Int_t CodaDecoder::FindRocsCoda3(const UInt_t *evbuffer) {
 // This determined tbLen and the tbank structure. 
 // For CODA3, the ROCs start after the Trigger Bank.
   
+  ClearRocs();
   Int_t pos = 2 + tbLen;
-  nroc=0;
 
-  while (pos < event_length) {
+  while (pos+1 < event_length) {
     Int_t len = (evbuffer[pos]+1);               /* total Length of ROC Bank */
     Int_t iroc = (evbuffer[pos+1]&0xffff0000)>>16;   /* ID of ROC */
+    if( iroc >= MAXROC || nroc >= MAXROC || len < 2 ||
+	pos+len > event_length ) {
+      cerr << "CodaDecoder::FindRocsCoda3: ERROR: bad ROC bank header "
+	   << "(roc " << iroc << ", len " << len << ") at word " << pos
+	   << " in event " << event_num << endl;
+      ClearRocs();
+      return HED_ERR;
+    }
     rocdat[iroc].len = len;
     rocdat[iroc].pos = pos;
     irn[nroc] = iroc;
@@ -667,8 +721,50 @@ Int_t CodaDecoder::FindRocsCoda3(const UInt_t *evbuffer) {
     }
   }
 
-  return 1;
+  return HED_OK;
+
+}
+
+//_____________________________________________________________________________
+void CodaDecoder::ClearRocs()
+{
+  // Reset the ROC data descriptors of the previous event. Only the ROCs
+  // that were present need to be cleared.
+
+  for( Int_t i=0; i<nroc; i++ ) {
+    RocDat_t& rd = rocdat[irn[i]];
+    rd.pos = rd.len = 0;
+  }
+  nroc = 0;
+}
+
+//_____________________________________________________________________________
+Int_t CodaDecoder::init_cmap()
+{
+  // Initialize the crate map and update the per-ROC crate information
+
+  Int_t ret = THaEvData::init_cmap();
+  FillRocInfo();
+  return ret;
+}
 
+//_____________________________________________________________________________
+void CodaDecoder::FillRocInfo()
+{
+  // Copy the crate map properties needed for decoding each ROC into rocinfo
+
+  for( Int_t iroc = 0; iroc < MAXROC; iroc++ ) {
+    RocInfo_t& info = rocinfo[iroc];
+    if( !fMap ) {
+      info = RocInfo_t();
+      continue;
+    }
+    info.nslot   = fMap->getNslot(iroc);
+    info.minslot = fMap->getMinSlot(iroc);
+    info.maxslot = fMap->getMaxSlot(iroc);
+    info.fastbus = fMap->isFastBus(iroc);
+    info.bank    = fMap->isBankStructure(iroc);
+  }
 }
 
 //_____________________________________________________________________________
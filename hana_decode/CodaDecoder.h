@@ -33,6 +33,8 @@ public:
   virtual Int_t SetDataVersion( Int_t version ) { return SetCodaVersion(version); }
           Int_t SetCodaVersion( Int_t version );
 
+  static  Int_t PeekEventType( const UInt_t* evbuffer, Int_t coda_version );
+
 protected:
   virtual Int_t LoadIfFlagData(const UInt_t* evbuffer);
 
@@ -42,23 +44,40 @@ protected:
   Int_t FindRocsCoda3(const UInt_t *evbuffer); // CODA3 version
   Int_t roc_decode( Int_t roc, const UInt_t* evbuffer, Int_t ipt, Int_t istop );
   Int_t bank_decode( Int_t roc, const UInt_t* evbuffer, Int_t ipt, Int_t istop );
+  template< bool kDebug >
+  Int_t DoRocDecode( Int_t roc, const UInt_t* evbuffer, Int_t ipt, Int_t istop );
 
   void CompareRocs();
   void ChkFbSlot( Int_t roc, const UInt_t* evbuffer, Int_t ipt, Int_t istop );
   void ChkFbSlots();
 
+  virtual Int_t init_cmap();
   virtual Int_t init_slotdata();
   virtual Int_t interpretCoda3(const UInt_t* buffer);
   virtual Int_t trigBankDecode(const UInt_t *tb, int blkSize);
   Int_t prescale_decode(const UInt_t* evbuffer);
   void dump(const UInt_t* evbuffer) const;
+  void FillRocInfo();
+  void ClearRocs();
 
   // Data
   //  Int_t   synchflag; // unused
   //  Bool_t  buffmode,synchmiss,synchextra; // already defined in base class
 
   Int_t nroc;
-  std::vector<Int_t> irn;
+  std::vector<Int_t> irn;     // ROCs present in the current event
+  // Crate map properties of each ROC, copied from fMap on (re)initialization
+  // so that the decoding loop does not need to query the map
+  struct RocInfo_t {
+    RocInfo_t() : nslot(0), minslot(0), maxslot(0), fastbus(kFALSE),
+		  bank(kFALSE) {}
+    Int_t  nslot;
+    Int_t  minslot;
+    Int_t  maxslot;
+    Bool_t fastbus;
+    Bool_t bank;               // ROC has modules in banks
+  };
+  std::vector<RocInfo_t> rocinfo;
   std::vector<bool>  fbfound;
   std::vector<Int_t> psfact;
   Bool_t fdfirst;
@@ -0,0 +1,261 @@
+/////////////////////////////////////////////////////////////////////
+//
+//   DecodedEventFile
+//   File of pre-decoded events
+//
+//   The file starts with a header of kHeaderLen 32-bit words:
+//
+//     kMagic, kFormatVersion, CODA version of the original data, 0
+//
+//   followed by one record per event. Like a CODA event, each record
+//   starts with its length in words, not counting the length word.
+//   The contents of the records are defined by the writer and the
+//   decoder, Podd::DecodedEventWriter and Podd::DecodedEventDecoder.
+//
+//   Records are written in the byte order of the host. Files written
+//   on a host of different endianness are recognized by the header
+//   and byte-swapped while reading. Records of decoded data, marked by
+//   kDecodedTag in the low 16 bits of their second word, consist of
+//   32-bit words only. All other records are CODA events and are
+//   swapped according to their bank structure, so that 8- and 16-bit
+//   data such as EPICS strings come out correctly.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "DecodedEventFile.h"
+#include <iostream>
+#include <cerrno>
+#include <cstring>
+
+using namespace std;
+
+namespace Decoder {
+
+static const size_t kHeaderLen = 4;
+static const size_t kFileBufSize = 1<<20;  // stdio buffer size (bytes)
+
+//_____________________________________________________________________________
+DecodedEventFile::DecodedEventFile()
+  : fFile(0), fWrite(kFALSE), fHeaderDone(kFALSE), fSwap(kFALSE),
+    fCodaVersion(0)
+{
+  // Default constructor. Do nothing (must open file separately).
+}
+
+//_____________________________________________________________________________
+DecodedEventFile::DecodedEventFile( const char* fname, const char* rw )
+  : fFile(0), fWrite(kFALSE), fHeaderDone(kFALSE), fSwap(kFALSE),
+    fCodaVersion(0)
+{
+  // Standard constructor. Pass read or write flag
+  if( codaOpen(fname,rw) != CODA_OK )
+    fIsGood = false;
+}
+
+//_____________________________________________________________________________
+DecodedEventFile::~DecodedEventFile()
+{
+  // Destructor
+  codaClose();
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::codaOpen( const char* fname, Int_t mode )
+{
+  // Open file 'fname' in read-only mode
+  return codaOpen( fname, "r", mode );
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::codaOpen( const char* fname, const char* rw,
+				  Int_t /* mode */ )
+{
+  // Open file 'fname' for reading (rw = "r") or writing (rw = "w")
+
+  codaClose();
+  filename = fname;
+  fWrite = (rw && (*rw == 'w' || *rw == 'W'));
+  fHeaderDone = fSwap = kFALSE;
+  fFile = fopen( fname, fWrite ? "wb" : "rb" );
+  if( !fFile ) {
+    cerr << "DecodedEventFile: ERROR opening " << fname << ": "
+	 << strerror(errno) << endl;
+    fIsGood = false;
+    return CODA_ERROR;
+  }
+  setvbuf( fFile, 0, _IOFBF, kFileBufSize );
+  fIsGood = true;
+  if( !fWrite )
+    return ReadHeader();
+  return CODA_OK;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::codaClose()
+{
+  // Close the file. Do nothing if file not opened.
+
+  if( !fFile )
+    return CODA_OK;
+  Int_t ret = CODA_OK;
+  if( fWrite && !fHeaderDone )
+    ret = WriteHeader();
+  if( fclose(fFile) != 0 ) {
+    cerr << "DecodedEventFile: ERROR closing " << filename << ": "
+	 << strerror(errno) << endl;
+    ret = CODA_ERROR;
+  }
+  fFile = 0;
+  fIsGood = (ret == CODA_OK);
+  return ret;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::ReadHeader()
+{
+  // Read and check the file header
+
+  UInt_t header[kHeaderLen];
+  if( fread(header,sizeof(UInt_t),kHeaderLen,fFile) != kHeaderLen ) {
+    cerr << "DecodedEventFile: ERROR: " << filename << " is empty or "
+	 << "truncated" << endl;
+    codaClose();
+    return CODA_ERROR;
+  }
+  if( header[0] != kMagic ) {
+    SwapWords(header,kHeaderLen);
+    if( header[0] != kMagic ) {
+      cerr << "DecodedEventFile: ERROR: " << filename << " is not a file "
+	   << "of decoded events" << endl;
+      codaClose();
+      return CODA_ERROR;
+    }
+    fSwap = kTRUE;
+  }
+  if( header[1] > kFormatVersion ) {
+    cerr << "DecodedEventFile: ERROR: unsupported format version "
+	 << header[1] << " of " << filename << endl;
+    codaClose();
+    return CODA_ERROR;
+  }
+  fCodaVersion = header[2];
+  return CODA_OK;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::WriteHeader()
+{
+  // Write the file header
+
+  UInt_t header[kHeaderLen] = { kMagic, kFormatVersion,
+				static_cast<UInt_t>(fCodaVersion), 0 };
+  fHeaderDone = kTRUE;
+  if( fwrite(header,sizeof(UInt_t),kHeaderLen,fFile) != kHeaderLen ) {
+    cerr << "DecodedEventFile: ERROR writing " << filename << ": "
+	 << strerror(errno) << endl;
+    fIsGood = false;
+    return CODA_FATAL;
+  }
+  return CODA_OK;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::codaRead()
+{
+  // Read the next record into evbuffer. Must be called once per event.
+
+  if( !fFile || fWrite ) {
+    cout << "codaRead ERROR: file " << filename << " not open for reading"
+	 << endl;
+    return CODA_ERROR;
+  }
+  if( fread(evbuffer,sizeof(UInt_t),1,fFile) != 1 ) {
+    if( feof(fFile) ) {
+      if(CODA_VERBOSE) {
+	cout << endl << "Normal end of file " << filename << " encountered"
+	     << endl;
+      }
+      return CODA_EOF;
+    }
+    fIsGood = false;
+    return CODA_ERROR;
+  }
+  UInt_t lenword = evbuffer[0];
+  if( fSwap )
+    SwapWords(&lenword,1);
+  size_t len = lenword;
+  if( len >= MAXEVLEN ) {
+    cerr << "DecodedEventFile: ERROR: record length " << len+1 << " in "
+	 << filename << " exceeds buffer size. File corrupt?" << endl;
+    fIsGood = false;
+    return CODA_FATAL;
+  }
+  if( fread(evbuffer+1,sizeof(UInt_t),len,fFile) != len ) {
+    cerr << "DecodedEventFile: ERROR: unexpected end of file while reading "
+	 << "record from " << filename << endl;
+    fIsGood = false;
+    return CODA_ERROR;
+  }
+  if( fSwap && SwapRecord(len+1) != 0 ) {
+    cerr << "DecodedEventFile: ERROR: inconsistent bank structure in "
+	 << "record from " << filename << ". File corrupt?" << endl;
+    fIsGood = false;
+    return CODA_ERROR;
+  }
+  return CODA_OK;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::SwapRecord( size_t nwords )
+{
+  // Convert the record of 'nwords' words in evbuffer, read from a file
+  // written on a host of different endianness, to native byte order.
+  // Returns 0 on success, -1 if a CODA event is inconsistent.
+
+  if( nwords < 2 ) {
+    SwapWords(evbuffer,nwords);
+    return 0;
+  }
+  UInt_t tagword = evbuffer[1];
+  SwapWords(&tagword,1);
+  if( (tagword & 0xffff) == kDecodedTag ) {
+    SwapWords(evbuffer,nwords);
+    return 0;
+  }
+  return SwapEvent(evbuffer,nwords);
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventFile::codaWrite( const UInt_t* evbuf )
+{
+  // Write the record in 'evbuf' (evbuf[0]+1 words) to the file
+
+  if( !fFile || !fWrite ) {
+    cout << "codaWrite ERROR: file " << filename << " not open for writing"
+	 << endl;
+    return CODA_ERROR;
+  }
+  if( !fHeaderDone ) {
+    Int_t ret = WriteHeader();
+    if( ret != CODA_OK )
+      return ret;
+  }
+  size_t len = static_cast<size_t>(evbuf[0]) + 1;
+  if( fwrite(evbuf,sizeof(UInt_t),len,fFile) != len ) {
+    cerr << "DecodedEventFile: ERROR writing " << filename << ": "
+	 << strerror(errno) << endl;
+    fIsGood = false;
+    return CODA_FATAL;
+  }
+  return CODA_OK;
+}
+
+//_____________________________________________________________________________
+Bool_t DecodedEventFile::isOpen() const
+{
+  return (fFile != 0);
+}
+
+}
+
+ClassImp(Decoder::DecodedEventFile)
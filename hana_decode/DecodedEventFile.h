@@ -0,0 +1,67 @@
+#ifndef Podd_DecodedEventFile_h_
+#define Podd_DecodedEventFile_h_
+
+/////////////////////////////////////////////////////////////////////
+//
+//   DecodedEventFile
+//   File of pre-decoded events
+//
+//   Disk file holding events in the format written by
+//   Podd::DecodedEventWriter. Physics events are stored as the
+//   decoded contents of their crates and slots, all other events
+//   as the original CODA event buffer.
+//
+/////////////////////////////////////////////////////////////////////
+
+#include "THaCodaData.h"
+#include <cstdio>
+
+namespace Decoder {
+
+class DecodedEventFile : public THaCodaData {
+
+public:
+
+  DecodedEventFile();
+  DecodedEventFile(const char* filename, const char* rw="r");
+  virtual ~DecodedEventFile();
+
+  virtual Int_t codaOpen(const char* filename, Int_t mode=1);
+  virtual Int_t codaOpen(const char* filename, const char* rw, Int_t mode=1);
+  virtual Int_t codaClose();
+  virtual Int_t codaRead();
+          Int_t codaWrite(const UInt_t* evbuffer);
+  virtual Bool_t isOpen() const;
+
+  // CODA version of the original data. Must be set before the first
+  // codaWrite() when writing a file.
+  virtual Int_t getCodaVersion() { return fCodaVersion; }
+          void  setCodaVersion(Int_t version) { fCodaVersion = version; }
+
+  static const UInt_t kMagic = 0xdec0da7a;  // First word of the file
+  static const UInt_t kFormatVersion = 1;
+  // Low 16 bits of the second word of records with decoded data
+  static const UInt_t kDecodedTag = 0xdecd;
+
+private:
+
+  DecodedEventFile(const DecodedEventFile &fn);
+  DecodedEventFile& operator=(const DecodedEventFile &fn);
+
+  Int_t  ReadHeader();
+  Int_t  WriteHeader();
+  Int_t  SwapRecord(size_t nwords);
+
+  FILE*   fFile;
+  Bool_t  fWrite;        // File opened for writing
+  Bool_t  fHeaderDone;   // File header written
+  Bool_t  fSwap;         // File written on host of different endianness
+  Int_t   fCodaVersion;  // CODA version of the original data
+
+  ClassDef(DecodedEventFile,0)   //  File of pre-decoded events
+
+};
+
+}
+
+#endif
@@ -150,6 +150,7 @@ namespace Decoder {
 #endif
     Clear();
     IsInit = kTRUE;
+    fNumChan = NADCCHAN;
     fName = "FADC250 JLab Flash ADC Module";
   }
 
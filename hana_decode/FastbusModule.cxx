@@ -31,13 +31,26 @@ void FastbusModule::Init() {
 }
 
 Int_t FastbusModule::Decode(const UInt_t *evbuffer) {
-  fChan = Chan(*evbuffer);
-  fData = Data(*evbuffer);
-  fRawData = *evbuffer;
+  DecodeWord(*evbuffer);
   return 1;
 }
 
 Int_t FastbusModule::LoadSlot(THaSlotData *sldat, const UInt_t* evbuffer, const UInt_t *pstop) {
+  // Load the data words of this slot, starting at evbuffer.
+  // The word loop is compiled with and without debug output. The version
+  // with debug output is used only if a debug file is set, and is not
+  // compiled at all without WITH_DEBUG.
+#ifdef WITH_DEBUG
+  if (fDebugFile)
+    return DoLoadSlot<true>(sldat, evbuffer, pstop);
+#endif
+  return DoLoadSlot<false>(sldat, evbuffer, pstop);
+}
+
+template< bool kDebug >
+Int_t FastbusModule::DoLoadSlot(THaSlotData *sldat, const UInt_t* evbuffer, const UInt_t *pstop) {
+  // Per-word decoding is done inline with DecodeWord(). Modules with a
+  // different data format must override LoadSlot.
   static int first_load=kTRUE;
   if (first_load) {
     if (fCrate < 0 || fCrate > MAXROC) {
@@ -53,7 +66,7 @@ Int_t FastbusModule::LoadSlot(THaSlotData *sldat, const UInt_t* evbuffer, const
   fWordsSeen = 0;
   fHeader=0;
   const UInt_t *p = evbuffer;
-  if (fDebugFile) {
+  if (kDebug) {
      *fDebugFile << "FastbusModule:: loadslot "<<endl;
      if (fHasHeader) {
          *fDebugFile << "TFB:: Has header "<<endl;
@@ -62,13 +75,13 @@ Int_t FastbusModule::LoadSlot(THaSlotData *sldat, const UInt_t* evbuffer, const
      }
      *fDebugFile << "FBModule::  Model number  "<<dec<<fModelNum<<endl;
   }
-  while (IsSlot( *p )) {
+  while (Slot( *p ) == fSlot) {
     if (fHasHeader && fWordsSeen==0) {
       fHeader = *p;
-      if (fDebugFile) *fDebugFile << "FastbusModule:: header "<<hex<<fHeader<<dec<<endl;
+      if (kDebug) *fDebugFile << "FastbusModule:: header "<<hex<<fHeader<<dec<<endl;
     } else {
-      Decode(p);
-      if (fDebugFile) *fDebugFile << "FastbusModule:: chan "<<dec<<fChan<<"  data "<<fData<<"   raw "<<hex<<*p<<dec<<endl;
+      DecodeWord(*p);
+      if (kDebug) *fDebugFile << "FastbusModule:: chan "<<dec<<fChan<<"  data "<<fData<<"   raw "<<hex<<*p<<dec<<endl;
       sldat->loadData(fChan, fData, fRawData);
     }
     fWordsSeen++;
@@ -77,9 +90,9 @@ Int_t FastbusModule::LoadSlot(THaSlotData *sldat, const UInt_t* evbuffer, const
   }
   if (fHeader) {
     Int_t fWordsExpect = (fHeader&fWdcntMask);
-    if (fDebugFile) *fDebugFile << "FastbusModule:: words expected  "<<dec<<fWordsExpect<<endl;
+    if (kDebug) *fDebugFile << "FastbusModule:: words expected  "<<dec<<fWordsExpect<<endl;
     if (fWordsExpect != fWordsSeen) {
-      if (fDebugFile) *fDebugFile << "ERROR:  FastbusModule:  crate "<<fCrate<<"   slot "<<fSlot<<" number of words expected "<<fWordsExpect<<"  not equal num words seen "<<fWordsSeen<<endl;
+      if (kDebug) *fDebugFile << "ERROR:  FastbusModule:  crate "<<fCrate<<"   slot "<<fSlot<<" number of words expected "<<fWordsExpect<<"  not equal num words seen "<<fWordsSeen<<endl;
 // This happens a lot for some modules, and appears to be harmless, so I suppress it.
 //      cerr << "ERROR:  FastbusModule:   number of words expected "<<fWordsExpect<<"  not equal num words seen "<<fWordsSeen<<endl;
     }
@@ -38,6 +38,8 @@ public:
    Int_t Chan(UInt_t rdata) { return (rdata&fChanMask)>>fChanShift; };
    Int_t Data(UInt_t rdata) { return (rdata&fDataMask); };
    Int_t Opt(UInt_t rdata) { return (rdata&fOptMask)>>fOptShift; };
+   void  DecodeWord(UInt_t rdata)
+   { fChan = Chan(rdata); fData = Data(rdata); fRawData = rdata; };
 
 protected:
 
@@ -49,6 +51,8 @@ protected:
    Int_t fChan, fData, fRawData;
    virtual void Init();
 
+   template< bool kDebug >
+   Int_t DoLoadSlot(THaSlotData *sldat, const UInt_t* evbuffer, const UInt_t *pstop);
 
 private:
 
@@ -15,6 +15,7 @@ Caen1190Module.cxx
 Caen775Module.cxx
 Caen792Module.cxx
 CodaDecoder.cxx
+DecodedEventFile.cxx
 F1TDCModule.cxx
 Fadc250Module.cxx
 FastbusModule.cxx
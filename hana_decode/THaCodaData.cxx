@@ -19,6 +19,9 @@
 #include <cstring>  // for strdup
 #include <cstdlib>  // for free
 #include <errno.h>
+#ifdef __SSSE3__
+#include <tmmintrin.h>
+#endif
 
 using namespace std;
 
@@ -101,6 +104,126 @@ void THaCodaData::staterr(const char* tried_to, Int_t status) const
   }
 }
 
+//_____________________________________________________________________________
+void THaCodaData::SwapWords( UInt_t* buf, size_t nwords )
+{
+  // Reverse the byte order of each of the 'nwords' 32-bit words in 'buf'.
+  // Uses SSSE3 byte shuffles, four words at a time, if the compiler
+  // targets SSSE3. The remaining loop is simple enough for the compiler
+  // to vectorize as well.
+
+  size_t i = 0;
+#ifdef __SSSE3__
+  const __m128i order = _mm_set_epi8( 12,13,14,15, 8,9,10,11,
+				      4,5,6,7, 0,1,2,3 );
+  for( ; i+4 <= nwords; i += 4 ) {
+    __m128i* p = reinterpret_cast<__m128i*>(buf+i);
+    _mm_storeu_si128( p, _mm_shuffle_epi8(_mm_loadu_si128(p), order) );
+  }
+#endif
+  for( ; i < nwords; ++i ) {
+    UInt_t w = buf[i];
+    buf[i] = (w >> 24) | ((w >> 8) & 0xff00) | ((w << 8) & 0xff0000) | (w << 24);
+  }
+}
+
+//_____________________________________________________________________________
+static void SwapHalfWords( UInt_t* buf, size_t nwords )
+{
+  // Reverse the byte order of each 16-bit value in 'buf'
+
+  for( size_t i = 0; i < nwords; ++i ) {
+    UInt_t w = buf[i];
+    buf[i] = ((w >> 8) & 0x00ff00ff) | ((w << 8) & 0xff00ff00);
+  }
+}
+
+//_____________________________________________________________________________
+static void SwapLongWords( UInt_t* buf, size_t nwords )
+{
+  // Reverse the byte order of each 64-bit value in 'buf'
+
+  THaCodaData::SwapWords( buf, nwords );
+  for( size_t i = 0; i+1 < nwords; i += 2 ) {
+    UInt_t w = buf[i];
+    buf[i] = buf[i+1];
+    buf[i+1] = w;
+  }
+}
+
+//_____________________________________________________________________________
+static Int_t SwapData( UInt_t type, UInt_t* buf, size_t nwords )
+{
+  // Swap the 'nwords' words of data of the given EVIO content type.
+  // Containers are descended into; their headers are swapped before
+  // they are interpreted. Returns 0 on success, -1 if a structure
+  // extends beyond 'nwords'.
+
+  switch( type ) {
+  case 0x3: case 0x6: case 0x7:  // 8-bit data
+    return 0;
+  case 0x4: case 0x5:            // 16-bit data
+    SwapHalfWords( buf, nwords );
+    return 0;
+  case 0x8: case 0x9: case 0xa:  // 64-bit data
+    SwapLongWords( buf, nwords );
+    return 0;
+  case 0xe: case 0x10: {         // Banks
+    size_t pos = 0;
+    while( pos+2 <= nwords ) {
+      THaCodaData::SwapWords( buf+pos, 2 );
+      size_t len = static_cast<size_t>(buf[pos]) + 1;
+      if( len < 2 || pos+len > nwords )
+	return -1;
+      if( SwapData( (buf[pos+1] >> 8) & 0x3f, buf+pos+2, len-2 ) )
+	return -1;
+      pos += len;
+    }
+    return (pos == nwords) ? 0 : -1;
+  }
+  case 0xc: case 0xd: case 0x20: { // Tagsegments, segments
+    size_t pos = 0;
+    while( pos < nwords ) {
+      THaCodaData::SwapWords( buf+pos, 1 );
+      size_t len = (buf[pos] & 0xffff) + 1;
+      if( pos+len > nwords )
+	return -1;
+      UInt_t subtype = (type == 0xc) ? (buf[pos] >> 16) & 0xf
+	: (buf[pos] >> 16) & 0x3f;
+      if( SwapData( subtype, buf+pos+1, len-1 ) )
+	return -1;
+      pos += len;
+    }
+    return 0;
+  }
+  default:                       // 32-bit data (composite data treated as such)
+    THaCodaData::SwapWords( buf, nwords );
+    return 0;
+  }
+}
+
+//_____________________________________________________________________________
+Int_t THaCodaData::SwapEvent( UInt_t* buf, size_t maxwords )
+{
+  // Convert the EVIO event (a bank) in 'buf', which was written on a host
+  // with different endianness, to native byte order. As in EVIO, each
+  // data item is swapped according to the content type of its bank,
+  // so 16- and 64-bit data, such as the time stamps and event types in
+  // the CODA 3 trigger bank, come out correctly. Most data are 32-bit
+  // words, which are swapped in bulk.
+  //
+  // Returns 0 on success, -1 if the event is longer than 'maxwords'
+  // or its structure is inconsistent.
+
+  if( maxwords < 2 )
+    return -1;
+  SwapWords( buf, 2 );
+  size_t len = static_cast<size_t>(buf[0]) + 1;
+  if( len < 2 || len > maxwords )
+    return -1;
+  return SwapData( (buf[1] >> 8) & 0x3f, buf+2, len-2 );
+}
+
 //_____________________________________________________________________________
 Int_t THaCodaData::ReturnCode( Int_t evio_retcode )
 {
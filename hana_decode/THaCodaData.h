@@ -49,6 +49,10 @@ public:
    virtual Int_t getCodaVersion();
    Bool_t isGood() const { return fIsGood; }
 
+   // Byte swapping of data from a host with different endianness
+   static void  SwapWords( UInt_t* buf, size_t nwords );
+   static Int_t SwapEvent( UInt_t* buf, size_t maxwords );
+
 protected:
    static Int_t ReturnCode( Int_t evio_retcode );
    void staterr(const char* tried_to, Int_t status) const;
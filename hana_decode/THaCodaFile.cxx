@@ -112,6 +112,24 @@ namespace Decoder {
      return ReturnCode(status);
    };
 
+  Int_t THaCodaFile::codaSetBufferSize(UInt_t nwords) {
+// Set the size of the internal output buffer of a file opened for writing
+// to 'nwords' 32-bit words. Events are written to disk only when this
+// buffer is full, so large buffers reduce the number of write calls when
+// writing many small events. Must be called before the first codaWrite.
+     Int_t status;
+     if ( handle ) {
+       char *d_b = strdup("B");
+       status = evIoctl(handle, d_b, &nwords);
+       free(d_b);
+       staterr("ioctl",status);
+     } else {
+       cout << "codaSetBufferSize ERROR: tried to access file with handle = 0" << endl;
+       status = S_EVFILE_BADHANDLE;
+     }
+     return ReturnCode(status);
+   };
+
   bool THaCodaFile::isOpen() const {
     return (handle!=0);
   }
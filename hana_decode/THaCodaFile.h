@@ -35,6 +35,7 @@ public:
   Int_t codaClose();
   Int_t codaRead();
   Int_t codaWrite(const UInt_t* evbuffer);
+  Int_t codaSetBufferSize(UInt_t nwords);      // output buffer size (words)
   Int_t filterToFile(const char* output_file); // filter to an output file
   void  addEvTypeFilt(Int_t evtype_to_filt);   // add an event type to list
   void  addEvListFilt(Int_t event_to_filt);    // add an event num to list
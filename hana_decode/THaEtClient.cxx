@@ -221,7 +221,13 @@ Int_t THaEtClient::codaRead()
 	et_event_CODAswap(evs[j]);
       }
 #else
-// TODO: how to do CODAsawp with CODA >= 3.05?
+      if (swapflg == ET_SWAP) {
+	et_event_getlength(evs[j], &nbytes);
+	if (SwapEvent(reinterpret_cast<UInt_t*>(data), nbytes/bpi) != 0) {
+	  printf("\nET:codaRead:ERROR:  Cannot swap malformed event\n");
+	  return CODA_ERROR;
+	}
+      }
 #endif
       Int_t* pdata = data;
       Int_t event_size = *pdata + 1;
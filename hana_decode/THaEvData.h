@@ -174,6 +174,11 @@ public:
   { return false; }
 
   Int_t GetNslots() const { return fNSlotUsed; };
+  // Slot data of the i-th used slot, 0 <= i < GetNslots()
+  Decoder::THaSlotData* GetSlotData(Int_t i) const {
+    assert( i >= 0 && i < fNSlotUsed );
+    return crateslot[fSlotUsed[i]];
+  }
   virtual void PrintSlotData(Int_t crate, Int_t slot) const;
   virtual void PrintOut() const;
   virtual void SetRunTime( ULong64_t tloc );
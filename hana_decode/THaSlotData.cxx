@@ -308,6 +308,24 @@ int THaSlotData::loadData(int chan, int dat, int raw) {
   return loadData(NULL, chan, dat, raw);
 }
 
+void THaSlotData::getHits(std::vector<UInt_t>& buf) const {
+  // Append three words per hit to 'buf': channel, data, raw data.
+  // Hits are in the order they were loaded, so passing them to
+  // loadData() in sequence recreates the contents of this slot.
+  size_t n0 = buf.size();
+  buf.resize(n0 + 3*numraw);
+  for (UShort_t i = 0; i < numchanhit; i++) {
+    UShort_t chan = chanlist[i];
+    for (UShort_t ihit = 0; ihit < numHits[chan]; ihit++) {
+      UShort_t index = dataindex[idxlist[chan]+ihit];
+      UInt_t* p = &buf[n0 + 3*index];
+      p[0] = chan;
+      p[1] = data[index];
+      p[2] = rawData[index];
+    }
+  }
+}
+
 
 void THaSlotData::print() const
 {
@@ -25,6 +25,7 @@
 #include <cassert>
 #include <iostream>
 #include <fstream>
+#include <vector>
 
 const int SD_WARN = -2;
 const int SD_ERR = -1;
@@ -57,6 +58,8 @@ public:
        void clearEvent();                   // clear event counters
        int loadData(const char* type, int chan, int dat, int raw);
        int loadData(int chan, int dat, int raw);
+       // Append channel, data and raw data of each hit, in load order
+       void getHits(std::vector<UInt_t>& buf) const;
 
        // new
        Int_t LoadIfSlot(const UInt_t* evbuffer, const UInt_t *pstop);
@@ -31,9 +31,21 @@ Bool_t VmeModule::IsSlot(UInt_t rdata) {
 Int_t VmeModule::LoadSlot(THaSlotData *sldat, const UInt_t* evbuffer,
 			  const UInt_t *pstop)
 {
-  // This is a simple, default method for loading a slot
+  // This is a simple, default method for loading a slot.
+  // The debug version of the loop is compiled only with WITH_DEBUG.
+#ifdef WITH_DEBUG
+  if (fDebugFile)
+    return DoLoadSlot<true>(sldat, evbuffer, pstop);
+#endif
+  return DoLoadSlot<false>(sldat, evbuffer, pstop);
+}
+
+template< bool kDebug >
+Int_t VmeModule::DoLoadSlot(THaSlotData *sldat, const UInt_t* evbuffer,
+			    const UInt_t *pstop)
+{
   const UInt_t *p = evbuffer;
-  if (fDebugFile) {
+  if (kDebug) {
        *fDebugFile << "Module:: Loadslot "<<endl;
        *fDebugFile << "header  0x"<<hex<<fHeader<<dec<<endl;
        *fDebugFile << "masks  "<<hex<<fHeaderMask<<endl;
@@ -42,7 +54,7 @@ Int_t VmeModule::LoadSlot(THaSlotData *sldat, const UInt_t* evbuffer,
   fWordsSeen=0;
   while (IsSlot( *p )) {
     if (p >= pstop) break;
-    if (fDebugFile) *fDebugFile << "IsSlot ... data = "<<*p<<endl;
+    if (kDebug) *fDebugFile << "IsSlot ... data = "<<*p<<endl;
     p++;
     Decode(p);
     for (size_t ichan = 0, nchan = GetNumChan(); ichan < nchan; ichan++) {
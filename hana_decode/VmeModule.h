@@ -31,6 +31,10 @@ public:
 
 protected:
 
+   template< bool kDebug >
+   Int_t DoLoadSlot(THaSlotData *sldat, const UInt_t *evbuffer,
+		    const UInt_t *pstop );
+
 private:
 
    ClassDef(Decoder::VmeModule,0)  // A VME module (abstract)
@@ -0,0 +1,439 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// codaskim
+//
+// Fast skim/filter of CODA files. Copies the events of one or more input
+// files that pass a set of selection criteria to output files, without
+// decoding them. Each input file (e.g. each segment of a run) is
+// processed by its own thread and written to its own output file.
+//
+// Selection criteria (all given criteria must be met):
+//   - event type is in the list given with -t
+//   - for physics events: event number is in one of the ranges given
+//     with -e. For CODA 3 multi-event blocks, this is the number of the
+//     first event in the block.
+//   - for physics events: for at least one of the -b options, any of the
+//     bits in 'mask' are set in the word at 'offset' of the event buffer
+//     (e.g. trigger bits in the trigger latch word)
+//   - for physics events: for every -w option, the word at 'offset' of
+//     the event buffer, masked with 'mask', equals 'value'
+// Offsets are counted in 32-bit words from the start of the event,
+// i.e. the event length word has offset 0.
+//
+// Control, prescale and configuration file events are always kept,
+// unless -a is given, so that the output can be replayed like the
+// original data.
+//
+// Usage: codaskim [options] -o <output> <input> [<input> ...]
+//   -o <file>   output file. With several inputs, the output for the
+//               i-th input (counting from 0) is written to <file>.i
+//   -t <list>   event types to keep, e.g. "1-8,131" (default all)
+//   -e <list>   physics event numbers to keep, e.g. "1000-1999,5000"
+//   -b <off:mask>        trigger bit selection (may be repeated)
+//   -w <off:mask:value>  raw data word selection (may be repeated)
+//   -n <nev>    write at most nev events per output file
+//   -a          do not automatically keep run information events
+//   -j <n>      number of threads (default number of CPUs)
+//   -B <MB>     output buffer size in MB (default 16)
+//   -f          overwrite existing output files
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "THaCodaFile.h"
+#include "CodaDecoder.h"
+#include "Decoder.h"
+#include "TROOT.h"
+#include "TString.h"
+#include "TStopwatch.h"
+#include "TThread.h"
+#include "TMutex.h"
+#include <iostream>
+#include <vector>
+#include <string>
+#include <utility>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+using namespace std;
+using namespace Decoder;
+
+typedef pair<UInt_t,UInt_t> Range_t;
+
+struct WordCut_t {
+  WordCut_t( UInt_t o, UInt_t m, UInt_t v ) : offset(o), mask(m), value(v) {}
+  UInt_t offset, mask, value;
+};
+
+struct Filter_t {
+  // Selection criteria
+  Filter_t() : keep_runinfo(true), maxev(0) {}
+  vector<bool>      types;     // Types to keep, indexed by type. Empty: all
+  vector<Range_t>   evranges;  // Sorted, non-overlapping event number ranges
+  vector<WordCut_t> trigbits;  // Any one must match
+  vector<WordCut_t> words;     // All must match
+  bool              keep_runinfo;
+  Long64_t          maxev;     // Max events per output file (0 = no limit)
+};
+
+struct Job_t {
+  // Work unit: one input file
+  Job_t() : status(0), nread(0), nwritten(0), nbytes(0) {}
+  string   input, output;
+  string   errmsg;
+  Int_t    status;
+  Long64_t nread, nwritten;
+  Long64_t nbytes;    // Bytes read
+};
+
+struct Context_t {
+  // Shared by all threads
+  Context_t() : filter(0), bufsize(0), overwrite(false), next(0) {}
+  const Filter_t* filter;
+  UInt_t          bufsize;    // Output buffer size (words)
+  bool            overwrite;
+  vector<Job_t>   jobs;
+  TMutex          mutex;      // Protects 'next'
+  size_t          next;       // Index of next job to start
+};
+
+//______________________________________________________________________________
+static bool ParseRanges( const char* str, vector<Range_t>& ranges )
+{
+  // Parse a comma-separated list of numbers and ranges "lo-hi" and add
+  // them to 'ranges'. Returns false on syntax error.
+
+  const char* p = str;
+  while( *p ) {
+    char* end;
+    UInt_t lo = strtoul(p, &end, 0), hi = lo;
+    if( end == p )
+      return false;
+    p = end;
+    if( *p == '-' ) {
+      ++p;
+      hi = strtoul(p, &end, 0);
+      if( end == p || hi < lo )
+	return false;
+      p = end;
+    }
+    ranges.push_back( make_pair(lo,hi) );
+    if( *p == ',' )
+      ++p;
+    else if( *p )
+      return false;
+  }
+  return !ranges.empty();
+}
+
+//______________________________________________________________________________
+static void MergeRanges( vector<Range_t>& ranges )
+{
+  // Sort 'ranges' and merge overlapping and adjacent ones, so that an event
+  // number can be looked up with a binary search
+
+  if( ranges.empty() )
+    return;
+  sort( ranges.begin(), ranges.end() );
+  vector<Range_t>::iterator out = ranges.begin();
+  for( vector<Range_t>::iterator it = ranges.begin()+1; it != ranges.end();
+       ++it ) {
+    if( out->second == kMaxUInt || it->first <= out->second+1 ) {
+      if( it->second > out->second )
+	out->second = it->second;
+    } else
+      *(++out) = *it;
+  }
+  ranges.erase( ++out, ranges.end() );
+}
+
+//______________________________________________________________________________
+static bool InRanges( const vector<Range_t>& ranges, UInt_t n )
+{
+  // True if 'n' is in one of the (merged) ranges
+
+  vector<Range_t>::const_iterator it =
+    upper_bound( ranges.begin(), ranges.end(), make_pair(n,kMaxUInt) );
+  if( it == ranges.begin() )
+    return false;
+  --it;
+  return n <= it->second;
+}
+
+//______________________________________________________________________________
+static bool ParseWordCut( const char* str, Int_t nfields,
+			  vector<WordCut_t>& cuts )
+{
+  // Parse "offset:mask" (nfields = 2) or "offset:mask:value" (nfields = 3)
+
+  UInt_t val[3] = { 0, 0, 0 };
+  const char* p = str;
+  for( Int_t i = 0; i < nfields; i++ ) {
+    char* end;
+    val[i] = strtoul(p, &end, 0);
+    if( end == p || (i < nfields-1 && *end != ':') )
+      return false;
+    p = end + (i < nfields-1);
+  }
+  if( *p )
+    return false;
+  if( nfields == 2 )
+    val[2] = val[1];
+  cuts.push_back( WordCut_t(val[0],val[1],val[2]) );
+  return true;
+}
+
+//______________________________________________________________________________
+static inline bool IsRunInfo( Int_t type )
+{
+  // Events needed to replay the output like the original data
+
+  return ( (type >= SYNC_EVTYPE && type <= END_EVTYPE) ||
+	   type == TS_PRESCALE_EVTYPE || type == PRESCALE_EVTYPE ||
+	   type == DETMAP_FILE || type == TRIGGER_FILE );
+}
+
+//______________________________________________________________________________
+static bool Select( const Filter_t& f, const UInt_t* buf, Int_t coda_version )
+{
+  // Apply the selection criteria to the event in 'buf'
+
+  Int_t type = CodaDecoder::PeekEventType( buf, coda_version );
+  if( f.keep_runinfo && IsRunInfo(type) )
+    return true;
+  if( !f.types.empty() &&
+      (type < 0 || type >= static_cast<Int_t>(f.types.size()) || !f.types[type]) )
+    return false;
+  if( type <= 0 || type > MAX_PHYS_EVTYPE )
+    return true;
+
+  // Physics event cuts
+  UInt_t len = buf[0]+1;
+  if( !f.evranges.empty() ) {
+    UInt_t ievnum = (coda_version == 2) ? 4 : 5;
+    if( ievnum >= len || !InRanges(f.evranges, buf[ievnum]) )
+      return false;
+  }
+  if( !f.trigbits.empty() ) {
+    bool found = false;
+    for( size_t i = 0; i < f.trigbits.size() && !found; i++ ) {
+      const WordCut_t& c = f.trigbits[i];
+      found = (c.offset < len && (buf[c.offset] & c.mask) != 0);
+    }
+    if( !found )
+      return false;
+  }
+  for( size_t i = 0; i < f.words.size(); i++ ) {
+    const WordCut_t& c = f.words[i];
+    if( c.offset >= len || (buf[c.offset] & c.mask) != c.value )
+      return false;
+  }
+  return true;
+}
+
+//______________________________________________________________________________
+static void SkimFile( Job_t& job, const Context_t& ctx )
+{
+  // Copy the selected events of one input file to its output file
+
+  if( job.input == job.output ) {
+    job.errmsg = "input and output file are the same";
+    job.status = -1;
+    return;
+  }
+  if( !ctx.overwrite && access(job.output.c_str(), F_OK) == 0 ) {
+    job.errmsg = "output file " + job.output + " exists (use -f to overwrite)";
+    job.status = -1;
+    return;
+  }
+  THaCodaFile in;
+  Int_t coda_version = -1;
+  if( in.codaOpen(job.input.c_str()) == CODA_OK )
+    coda_version = in.getCodaVersion();
+  if( coda_version < 0 ) {
+    job.errmsg = "cannot open input file";
+    job.status = -1;
+    return;
+  }
+  THaCodaFile out;
+  if( out.codaOpen(job.output.c_str(), "w") != CODA_OK ) {
+    job.errmsg = "cannot open output file " + job.output;
+    job.status = -1;
+    return;
+  }
+  if( ctx.bufsize > 0 )
+    out.codaSetBufferSize(ctx.bufsize);  // Not fatal if unsupported
+
+  const Filter_t& filter = *ctx.filter;
+  Int_t status;
+  while( (status = in.codaRead()) == CODA_OK ) {
+    const UInt_t* buf = in.getEvBuffer();
+    job.nread++;
+    job.nbytes += sizeof(UInt_t)*(buf[0]+1);
+    if( !Select(filter, buf, coda_version) )
+      continue;
+    if( (status = out.codaWrite(buf)) != CODA_OK ) {
+      job.errmsg = "error writing output file " + job.output;
+      break;
+    }
+    if( ++job.nwritten == filter.maxev && filter.maxev > 0 )
+      break;
+  }
+  if( status == CODA_EOF )
+    status = CODA_OK;
+  else if( status != CODA_OK && job.errmsg.empty() )
+    job.errmsg = "error reading input file";
+  Int_t close_status = out.codaClose();
+  if( status == CODA_OK && close_status != CODA_OK ) {
+    job.errmsg = "error closing output file " + job.output;
+    status = close_status;
+  }
+  job.status = status;
+}
+
+//______________________________________________________________________________
+static void* Worker( void* arg )
+{
+  // Thread function: process input files until none are left
+
+  Context_t* ctx = static_cast<Context_t*>(arg);
+  while( true ) {
+    ctx->mutex.Lock();
+    size_t i = ctx->next++;
+    ctx->mutex.UnLock();
+    if( i >= ctx->jobs.size() )
+      break;
+    SkimFile( ctx->jobs[i], *ctx );
+  }
+  return 0;
+}
+
+//______________________________________________________________________________
+static void usage()
+{
+  puts("Usage: codaskim [options] -o <output> <input> [<input> ...]");
+  puts(" -o <file> Output file. With several inputs, the output for the i-th input");
+  puts("    (counting from 0) is written to <file>.i");
+  puts(" -t <list> Event types to keep, e.g. \"1-8,131\". Default is all");
+  puts(" -e <list> Physics event numbers to keep, e.g. \"1000-1999,5000\"");
+  puts(" -b <offset:mask> Keep physics events with any bit of mask set in the");
+  puts("    word at offset. May be repeated (any must match)");
+  puts(" -w <offset:mask:value> Keep physics events where the word at offset,");
+  puts("    masked with mask, equals value. May be repeated (all must match)");
+  puts(" -n <nev> Write at most nev events per output file");
+  puts(" -a Do not automatically keep control, prescale and file events");
+  puts(" -j <threads> Number of threads. Default is the number of CPUs");
+  puts(" -B <MB> Output buffer size in MB. Default is 16");
+  puts(" -f Overwrite existing output files");
+  exit(1);
+}
+
+//______________________________________________________________________________
+int main( int argc, char* argv[] )
+{
+  Filter_t filter;
+  Context_t ctx;
+  string output;
+  Int_t nthreads = static_cast<Int_t>(sysconf(_SC_NPROCESSORS_ONLN));
+  Double_t bufmb = 16.0;
+
+  int opt;
+  while( (opt = getopt(argc, argv, "o:t:e:b:w:n:aj:B:fh")) != -1 ) {
+    switch( opt ) {
+    case 'o': output = optarg; break;
+    case 't': {
+      vector<Range_t> types;
+      if( !ParseRanges(optarg, types) )
+	usage();
+      for( size_t i = 0; i < types.size(); i++ ) {
+	if( types[i].second > 0xffff )
+	  usage();
+	if( filter.types.empty() )
+	  filter.types.resize(0x10000, false);
+	for( UInt_t k = types[i].first; k <= types[i].second; k++ )
+	  filter.types[k] = true;
+      }
+      break;
+    }
+    case 'e':
+      if( !ParseRanges(optarg, filter.evranges) )
+	usage();
+      break;
+    case 'b':
+      if( !ParseWordCut(optarg, 2, filter.trigbits) )
+	usage();
+      break;
+    case 'w':
+      if( !ParseWordCut(optarg, 3, filter.words) )
+	usage();
+      break;
+    case 'n': filter.maxev = atoll(optarg); break;
+    case 'a': filter.keep_runinfo = false; break;
+    case 'j': nthreads = atoi(optarg); break;
+    case 'B': bufmb = atof(optarg); break;
+    case 'f': ctx.overwrite = true; break;
+    default:  usage();
+    }
+  }
+  if( output.empty() || optind >= argc || bufmb < 0 || filter.maxev < 0 )
+    usage();
+  MergeRanges( filter.evranges );
+
+  Int_t ninput = argc-optind;
+  ctx.filter  = &filter;
+  ctx.bufsize = static_cast<UInt_t>( bufmb*1024*1024/sizeof(UInt_t) );
+  ctx.jobs.resize(ninput);
+  for( Int_t i = 0; i < ninput; i++ ) {
+    Job_t& job = ctx.jobs[i];
+    job.input  = argv[optind+i];
+    job.output = (ninput == 1) ? output : Form("%s.%d", output.c_str(), i);
+  }
+  if( nthreads > ninput )
+    nthreads = ninput;
+  if( nthreads < 1 )
+    nthreads = 1;
+
+  TROOT codaskim("codaskim", "CODA skim");
+  TThread::Initialize();
+
+  TStopwatch timer;
+  timer.Start();
+  vector<TThread*> threads(nthreads-1);
+  for( Int_t i = 0; i < nthreads-1; i++ ) {
+    threads[i] = new TThread( Worker, &ctx );
+    threads[i]->Run();
+  }
+  Worker( &ctx );
+  for( Int_t i = 0; i < nthreads-1; i++ ) {
+    threads[i]->Join();
+    delete threads[i];
+  }
+  timer.Stop();
+
+  Long64_t nread = 0, nwritten = 0, nbytes = 0;
+  Int_t nerr = 0;
+  for( Int_t i = 0; i < ninput; i++ ) {
+    const Job_t& job = ctx.jobs[i];
+    cout << job.input << " -> " << job.output << ": ";
+    if( job.status != 0 ) {
+      cout << "ERROR: " << job.errmsg << endl;
+      nerr++;
+    }
+    else
+      cout << job.nwritten << " of " << job.nread << " events" << endl;
+    nread += job.nread;
+    nwritten += job.nwritten;
+    nbytes += job.nbytes;
+  }
+  Double_t t = timer.RealTime();
+  cout << "Wrote " << nwritten << " of " << nread << " events with "
+       << nthreads << " threads in " << t << " s";
+  if( t > 0 )
+    cout << " (" << nread/t << " events/s, " << nbytes/t/1024/1024
+	 << " MB/s)";
+  cout << endl;
+
+  return (nerr > 0) ? 2 : 0;
+}
@@ -0,0 +1,599 @@
+//////////////////////////////////////////////////////////////////////////
+//
+// decbench
+//
+// Decoder throughput benchmark. Synthesizes CODA 2 or CODA 3 physics
+// events for the common module types, decodes them with
+// CodaDecoder::LoadEvent and reports events/s and MB/s per module type.
+// No data files are needed; a crate map for the synthetic crates is
+// written to a temporary file.
+//
+// Before timing, every event is decoded once and the number of channels
+// found in each slot is compared with the number generated, so that a
+// decoder change that breaks a module format is caught as well.
+//
+// Results can be saved with -w and compared with a reference file with -r.
+// The exit status is nonzero if the decoded data do not match or if any
+// module type is slower than the reference by more than the tolerance,
+// so the program can be used as a regression check.
+//
+// Usage: decbench [options]
+//   -c <vers>   CODA version, 2 or 3 (default 2)
+//   -n <nev>    number of events to decode per test (default 200000)
+//   -o <occ>    fraction of channels hit, 0-1 (default 0.1)
+//   -s <nslot>  number of modules of each type (default 4)
+//   -b <nblk>   block level for the multiblock FADC test (default 8)
+//   -m <list>   comma-separated list of tests to run (default all)
+//   -S <seed>   random seed (default 4357)
+//   -w <file>   write results to file
+//   -r <file>   compare with reference results from file
+//   -t <pct>    tolerance for -r in percent (default 10)
+//
+//////////////////////////////////////////////////////////////////////////
+
+#include "CodaDecoder.h"
+#include "Decoder.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TString.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include <iostream>
+#include <iomanip>
+#include <fstream>
+#include <sstream>
+#include <vector>
+#include <map>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+using namespace std;
+using namespace Decoder;
+
+static const Int_t NPOOL = 64;       // Distinct events generated per test
+static const Int_t FIRSTSLOT_VME = 3;
+
+// Per-slot channel lists for each event of a block
+typedef vector< vector<Int_t> > HitList_t;
+
+// Generates the data of one module, for 'hits.size()' events
+typedef void (*GenFunc_t)( vector<UInt_t>& out, Int_t slot,
+			   const HitList_t& hits, UInt_t evnum, TRandom& rnd );
+
+struct ModType_t {
+  const char* name;     // Test name
+  Int_t       crate;    // ROC number
+  Int_t       model;    // Model number in crate map
+  Bool_t      fastbus;  // FASTBUS crate (else VME)
+  Bool_t      bank;     // Each slot is read out in its own bank
+  UInt_t      nchan;    // Channels per module
+  Bool_t      allchan;  // All channels always read out (scalers)
+  Bool_t      blocked;  // Use the multiblock block level
+  GenFunc_t   gen;      // Data generator
+};
+
+//_____________________________________________________________________________
+static void GenLecroy1877( vector<UInt_t>& out, Int_t slot,
+			   const HitList_t& hits, UInt_t, TRandom& rnd )
+{
+  // FASTBUS TDC: header with word count, then slot|chan|edge|data
+  const vector<Int_t>& ch = hits[0];
+  UInt_t s = static_cast<UInt_t>(slot)<<27;
+  out.push_back( s | (ch.size()+1) );
+  for( size_t i = 0; i < ch.size(); ++i )
+    out.push_back( s | (ch[i]<<17) | (rnd.Integer(2)<<16) |
+		   rnd.Integer(0x10000) );
+}
+
+//_____________________________________________________________________________
+static void GenLecroy1881( vector<UInt_t>& out, Int_t slot,
+			   const HitList_t& hits, UInt_t, TRandom& rnd )
+{
+  // FASTBUS ADC: header with word count, then slot|chan|data
+  const vector<Int_t>& ch = hits[0];
+  UInt_t s = static_cast<UInt_t>(slot)<<27;
+  out.push_back( s | (ch.size()+1) );
+  for( size_t i = 0; i < ch.size(); ++i )
+    out.push_back( s | (ch[i]<<17) | rnd.Integer(0x4000) );
+}
+
+//_____________________________________________________________________________
+static void GenCaen1190( vector<UInt_t>& out, Int_t slot,
+			 const HitList_t& hits, UInt_t evnum, TRandom& rnd )
+{
+  // Global header, one TDC header/trailer pair, global trailer
+  const vector<Int_t>& ch = hits[0];
+  out.push_back( 0x40000000 | ((evnum&0x3fffff)<<5) | slot );
+  out.push_back( 0x08000000 | ((evnum&0xfff)<<12) );
+  for( size_t i = 0; i < ch.size(); ++i )
+    out.push_back( (ch[i]<<19) | rnd.Integer(0x80000) );
+  out.push_back( 0x18000000 | ((evnum&0xfff)<<12) | (ch.size()+2) );
+  out.push_back( 0x80000000 | ((ch.size()+4)<<5) | slot );
+}
+
+//_____________________________________________________________________________
+static void GenCaen7xx( vector<UInt_t>& out, Int_t slot,
+			const HitList_t& hits, UInt_t evnum, TRandom& rnd )
+{
+  // CAEN V775/V792: header with channel count, data, end of block
+  const vector<Int_t>& ch = hits[0];
+  UInt_t s = static_cast<UInt_t>(slot)<<27;
+  out.push_back( s | (2<<24) | (ch.size()<<8) );
+  for( size_t i = 0; i < ch.size(); ++i )
+    out.push_back( s | (ch[i]<<16) | rnd.Integer(0x1000) );
+  out.push_back( s | (4<<24) | (evnum&0xffffff) );
+}
+
+//_____________________________________________________________________________
+static void GenF1TDC( vector<UInt_t>& out, Int_t slot,
+		      const HitList_t& hits, UInt_t, TRandom& rnd )
+{
+  // F1TDC high resolution: data words with resolution lock set.
+  // Only the even internal channels are read out in this mode.
+  const vector<Int_t>& ch = hits[0];
+  UInt_t s = static_cast<UInt_t>(slot)<<27;
+  for( size_t i = 0; i < ch.size(); ++i )
+    out.push_back( s | (1<<26) | (1<<23) | ((2*ch[i])<<16) |
+		   rnd.Integer(0x10000) );
+}
+
+//_____________________________________________________________________________
+static void GenFadc250( vector<UInt_t>& out, Int_t slot,
+			const HitList_t& hits, UInt_t evnum, TRandom& rnd )
+{
+  // JLab FADC250 pulse integral mode: block header, then per event
+  // an event header, trigger time and integral, time and pedestal/peak
+  // per channel, and a block trailer
+  size_t start = out.size();
+  UInt_t s = static_cast<UInt_t>(slot)<<22;
+  out.push_back( 0x80000000 | s | (1<<18) | ((evnum&0x3ff)<<8) |
+		 hits.size() );
+  for( size_t iev = 0; iev < hits.size(); ++iev ) {
+    UInt_t trig = evnum + iev;
+    out.push_back( 0x90000000 | s | (trig&0xfff) );
+    UInt_t t = rnd.Integer(0x1000000);
+    out.push_back( 0x98000000 | t );
+    out.push_back( rnd.Integer(0x1000000) );
+    const vector<Int_t>& ch = hits[iev];
+    for( size_t i = 0; i < ch.size(); ++i ) {
+      UInt_t c = static_cast<UInt_t>(ch[i])<<23;
+      out.push_back( 0xb8000000 | c | rnd.Integer(0x80000) );
+      out.push_back( 0xc0000000 | c | rnd.Integer(0x8000) );
+      out.push_back( 0xd0000000 | c | (rnd.Integer(0x800)<<12) |
+		     rnd.Integer(0x1000) );
+    }
+  }
+  out.push_back( 0x88000000 | s | (out.size()-start+1) );
+}
+
+//_____________________________________________________________________________
+static void GenScaler3800( vector<UInt_t>& out, Int_t slot,
+			   const HitList_t&, UInt_t evnum, TRandom& rnd )
+{
+  // Header with channel count, then one count per channel. Counts are
+  // kept small so that they can never look like a header.
+  out.push_back( 0xabc00000 | (slot<<16) | 32 );
+  for( UInt_t i = 0; i < 32; ++i )
+    out.push_back( (evnum<<4) + rnd.Integer(16) );
+}
+
+static const ModType_t gModTypes[] = {
+  // name         crate model  fb     bank   nchan all   blocked  generator
+  { "lecroy1877", 1,  1877,  true,  false,  96, false, false, GenLecroy1877 },
+  { "lecroy1881", 2,  1881,  true,  false,  64, false, false, GenLecroy1881 },
+  { "caen1190",   3,  1190,  false, false, 128, false, false, GenCaen1190 },
+  { "caen775",    4,   775,  false, true,   32, false, false, GenCaen7xx },
+  { "caen792",    5,   792,  false, true,   32, false, false, GenCaen7xx },
+  { "f1tdc",      6,  3201,  false, false,  32, false, false, GenF1TDC },
+  { "fadc250",    7,   250,  false, true,   16, false, false, GenFadc250 },
+  { "scaler3800", 8,  3800,  false, false,  32, true,  false, GenScaler3800 },
+  { "fadc250mb",  7,   250,  false, true,   16, false, true,  GenFadc250 },
+  { 0, 0, 0, false, false, 0, false, false, 0 }
+};
+
+//_____________________________________________________________________________
+struct Options_t {
+  Options_t() : coda(2), nev(200000), occ(0.1), nslot(4), nblock(8),
+		seed(4357), tolerance(10.) {}
+  Int_t    coda;
+  Long64_t nev;
+  Double_t occ;
+  Int_t    nslot;
+  Int_t    nblock;
+  UInt_t   seed;
+  Double_t tolerance;
+  string   tests, outfile, reffile;
+};
+
+struct Event_t {
+  vector<UInt_t> buf;       // Complete event, padded by one word
+  vector<Int_t>  nchan;     // Expected channels per event in block
+};
+
+struct Result_t {
+  Result_t() : nev(0), nbytes(0), time(0) {}
+  Long64_t nev;
+  Double_t nbytes;
+  Double_t time;
+  Double_t EvRate()   const { return time > 0 ? nev/time : 0; }
+  Double_t ByteRate() const { return time > 0 ? nbytes/time : 0; }
+};
+
+struct RefResult_t {
+  RefResult_t() : evrate(0), byterate(0) {}
+  Double_t evrate;
+  Double_t byterate;
+};
+
+//_____________________________________________________________________________
+static void Usage()
+{
+  cout << "Usage: decbench [-c vers] [-n nev] [-o occ] [-s nslot] [-b nblk]"
+       << endl
+       << "                [-m tests] [-S seed] [-w outfile] [-r reffile]"
+       << " [-t pct]" << endl
+       << "Tests: ";
+  for( const ModType_t* m = gModTypes; m->name; ++m )
+    cout << m->name << " ";
+  cout << "mixed" << endl;
+  exit(2);
+}
+
+//_____________________________________________________________________________
+static Int_t NumSlots( const ModType_t& m, const Options_t& opt )
+{
+  // FASTBUS allows up to 25 slots, VME up to 20
+  Int_t maxslot = m.fastbus ? 25 : 21-FIRSTSLOT_VME;
+  return (opt.nslot < maxslot) ? opt.nslot : maxslot;
+}
+
+//_____________________________________________________________________________
+static Int_t FirstSlot( const ModType_t& m )
+{
+  return m.fastbus ? 1 : FIRSTSLOT_VME;
+}
+
+//_____________________________________________________________________________
+static Int_t WriteCrateMap( const TString& fname, const Options_t& opt )
+{
+  // Write a crate map with one crate per module type
+
+  ofstream ofs(fname.Data());
+  if( !ofs )
+    return -1;
+  ofs << "# Crate map for decoder benchmark" << endl;
+  for( const ModType_t* m = gModTypes; m->name; ++m ) {
+    if( m->blocked )   // shares the crate of the unblocked test
+      continue;
+    ofs << "==== Crate " << m->crate << " type "
+	<< (m->fastbus ? "fastbus" : "vme") << endl;
+    Int_t first = FirstSlot(*m);
+    for( Int_t slot = first; slot < first+NumSlots(*m,opt); ++slot ) {
+      ofs << slot << " " << m->model;
+      if( m->bank )
+	ofs << " " << 10+slot;
+      else if( m->gen == GenCaen1190 )
+	ofs << " 1 " << hex << (0x40000000|slot) << " f800001f" << dec;
+      else if( m->gen == GenF1TDC )
+	ofs << " 1 " << hex << (slot<<27) << " f8000000" << dec;
+      else if( m->gen == GenScaler3800 )
+	ofs << " 1 " << hex << (0xabc00000|(slot<<16)) << " ffff0000" << dec;
+      ofs << endl;
+    }
+  }
+  return ofs.good() ? 0 : -1;
+}
+
+//_____________________________________________________________________________
+static void AddRoc( vector<UInt_t>& buf, const ModType_t& m, Int_t nslot,
+		    Int_t coda, const HitList_t* slothits, UInt_t evnum,
+		    TRandom& rnd )
+{
+  // Append the ROC bank for module type 'm' to the event buffer
+
+  size_t rocpos = buf.size();
+  Int_t nblock = static_cast<Int_t>(slothits[0].size());
+  buf.push_back(0);
+  if( coda == 2 )
+    buf.push_back( (m.crate<<16) | (m.bank ? 0x1000 : 0x0100) );
+  else
+    buf.push_back( (m.crate<<16) | (0x10<<8) | nblock );
+  Int_t first = FirstSlot(m);
+  // FASTBUS slots are read out highest first
+  for( Int_t i = 0; i < nslot; ++i ) {
+    Int_t k = m.fastbus ? nslot-1-i : i;
+    Int_t slot = first + k;
+    size_t bankpos = buf.size();
+    if( m.bank ) {
+      buf.push_back(0);
+      buf.push_back( ((10+slot)<<16) | (0x01<<8) );
+    }
+    m.gen( buf, slot, slothits[k], evnum, rnd );
+    if( m.bank )
+      buf[bankpos] = buf.size()-bankpos-1;
+  }
+  buf[rocpos] = buf.size()-rocpos-1;
+}
+
+//_____________________________________________________________________________
+static void MakeEvent( Event_t& ev, const vector<const ModType_t*>& types,
+		       const Options_t& opt, Int_t nblock, UInt_t evnum,
+		       TRandom& rnd )
+{
+  // Build a physics event with data from all module types in 'types'
+
+  vector<UInt_t>& buf = ev.buf;
+  buf.clear();
+  ev.nchan.assign( nblock, 0 );
+  buf.push_back(0);
+  if( opt.coda == 2 ) {
+    buf.push_back( (1<<16) | 0x10cc );
+    // Event ID bank
+    buf.push_back(4);
+    buf.push_back(0xc0000100);
+    buf.push_back(evnum);
+    buf.push_back(0);
+    buf.push_back(0);
+  } else {
+    buf.push_back( (0xff50<<16) | (0x10<<8) | nblock );
+    // Trigger bank without time stamps or run info
+    buf.push_back(6);
+    buf.push_back( (0xff20<<16) | (0x20<<8) | types.size() );
+    buf.push_back( (0x0a<<24) | (0x0a<<16) | 2 );
+    buf.push_back(evnum);
+    buf.push_back(0);
+    buf.push_back( (0x05<<24) | (0x05<<16) | 1 );
+    buf.push_back(1);
+  }
+  for( size_t it = 0; it < types.size(); ++it ) {
+    const ModType_t& m = *types[it];
+    Int_t nslot = NumSlots(m,opt);
+    vector<HitList_t> hits( nslot, HitList_t(nblock) );
+    for( Int_t k = 0; k < nslot; ++k ) {
+      for( Int_t iev = 0; iev < nblock; ++iev ) {
+	vector<Int_t>& ch = hits[k][iev];
+	for( UInt_t chan = 0; chan < m.nchan; ++chan ) {
+	  if( m.allchan || rnd.Rndm() < opt.occ )
+	    ch.push_back(chan);
+	}
+	ev.nchan[iev] += ch.size();
+      }
+    }
+    AddRoc( buf, m, nslot, opt.coda, &hits[0], evnum, rnd );
+  }
+  buf[0] = buf.size()-1;
+  // The decoder may look at the word following the last ROC
+  buf.push_back(0);
+}
+
+//_____________________________________________________________________________
+static Int_t CountChannels( const THaEvData& evdata,
+			    const vector<const ModType_t*>& types,
+			    const Options_t& opt )
+{
+  Int_t n = 0;
+  for( size_t it = 0; it < types.size(); ++it ) {
+    const ModType_t& m = *types[it];
+    Int_t first = FirstSlot(m);
+    for( Int_t slot = first; slot < first+NumSlots(m,opt); ++slot )
+      n += evdata.GetNumChan(m.crate,slot);
+  }
+  return n;
+}
+
+//_____________________________________________________________________________
+static Int_t RunTest( const string& name,
+		      const vector<const ModType_t*>& types,
+		      const Options_t& opt, const TString& cratemap,
+		      Result_t& res )
+{
+  // Generate the events for one test, check that they decode correctly,
+  // then time the decoding of opt.nev events. Returns the number of
+  // mismatched events.
+
+  Int_t nblock = types[0]->blocked ? opt.nblock : 1;
+  TRandom3 rnd(opt.seed);
+  vector<Event_t> pool(NPOOL);
+  for( Int_t i = 0; i < NPOOL; ++i )
+    MakeEvent( pool[i], types, opt, nblock, 1+i*nblock, rnd );
+
+  CodaDecoder evdata;
+  evdata.SetCodaVersion(opt.coda);
+  evdata.SetCrateMapName(cratemap.Data());
+
+  // Validation pass. Also does all one-time initializations.
+  Int_t nbad = 0;
+  for( Int_t i = 0; i < NPOOL; ++i ) {
+    const Event_t& ev = pool[i];
+    Int_t iev = 0, ngood = 0;
+    if( evdata.LoadEvent(&ev.buf[0]) != THaEvData::HED_OK ) {
+      ++nbad;
+      continue;
+    }
+    do {
+      if( iev > 0 )
+	evdata.LoadFromMultiBlock();
+      if( iev < nblock &&
+	  CountChannels(evdata,types,opt) == ev.nchan[iev] )
+	++ngood;
+      ++iev;
+    } while( evdata.IsMultiBlockMode() && !evdata.BlockIsDone() );
+    if( iev != nblock || ngood != nblock ) {
+      if( nbad == 0 )
+	cerr << name << ": event " << i << ": decoded " << iev << "/"
+	     << nblock << " events, " << ngood << " with the expected "
+	     << "number of channels" << endl;
+      ++nbad;
+    }
+  }
+
+  // Timed pass
+  TStopwatch timer;
+  Long64_t nev = 0;
+  Double_t nbytes = 0;
+  Int_t i = 0;
+  timer.Start();
+  while( nev < opt.nev ) {
+    const Event_t& ev = pool[i];
+    evdata.LoadEvent(&ev.buf[0]);
+    ++nev;
+    while( evdata.IsMultiBlockMode() && !evdata.BlockIsDone() ) {
+      evdata.LoadFromMultiBlock();
+      ++nev;
+    }
+    nbytes += sizeof(UInt_t)*(ev.buf[0]+1);
+    if( ++i == NPOOL )
+      i = 0;
+  }
+  timer.Stop();
+
+  res.nev    = nev;
+  res.nbytes = nbytes;
+  res.time   = timer.RealTime();
+  return nbad;
+}
+
+//_____________________________________________________________________________
+static Int_t ReadResults( const string& fname, map<string,RefResult_t>& ref )
+{
+  // Read results saved with -w. Each line: name events evt/s bytes/s
+
+  ifstream ifs(fname.c_str());
+  if( !ifs ) {
+    cerr << "Cannot open reference file " << fname << endl;
+    return -1;
+  }
+  string line;
+  while( getline(ifs,line) ) {
+    if( line.empty() || line[0] == '#' )
+      continue;
+    istringstream is(line);
+    string name;
+    Long64_t nev = 0;
+    RefResult_t r;
+    if( is >> name >> nev >> r.evrate >> r.byterate )
+      ref[name] = r;
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+int main( int argc, char* argv[] )
+{
+  Options_t opt;
+  int c;
+  while( (c = getopt(argc, argv, "c:n:o:s:b:m:S:w:r:t:h")) != -1 ) {
+    switch( c ) {
+    case 'c': opt.coda      = atoi(optarg); break;
+    case 'n': opt.nev       = atoll(optarg); break;
+    case 'o': opt.occ       = atof(optarg); break;
+    case 's': opt.nslot     = atoi(optarg); break;
+    case 'b': opt.nblock    = atoi(optarg); break;
+    case 'm': opt.tests     = optarg; break;
+    case 'S': opt.seed      = strtoul(optarg,0,0); break;
+    case 'w': opt.outfile   = optarg; break;
+    case 'r': opt.reffile   = optarg; break;
+    case 't': opt.tolerance = atof(optarg); break;
+    default:  Usage();
+    }
+  }
+  if( (opt.coda != 2 && opt.coda != 3) || opt.nev <= 0 || opt.occ < 0 ||
+      opt.occ > 1 || opt.nslot <= 0 || opt.nblock < 1 || opt.nblock > 255 )
+    Usage();
+
+  TROOT decbench("decbench","Decoder throughput benchmark");
+
+  // Select tests
+  vector<string> tests;
+  if( opt.tests.empty() ) {
+    for( const ModType_t* m = gModTypes; m->name; ++m )
+      tests.push_back(m->name);
+    tests.push_back("mixed");
+  } else {
+    istringstream is(opt.tests);
+    string t;
+    while( getline(is,t,',') )
+      if( !t.empty() )
+	tests.push_back(t);
+  }
+
+  TString cratemap = "decbench_cratemap";
+  FILE* fi = gSystem->TempFileName(cratemap);
+  if( !fi ) {
+    cerr << "Cannot create temporary crate map file" << endl;
+    return 2;
+  }
+  fclose(fi);
+  if( WriteCrateMap(cratemap,opt) != 0 ) {
+    cerr << "Cannot write crate map " << cratemap << endl;
+    gSystem->Unlink(cratemap);
+    return 2;
+  }
+
+  map<string,RefResult_t> ref;
+  if( !opt.reffile.empty() && ReadResults(opt.reffile,ref) != 0 ) {
+    gSystem->Unlink(cratemap);
+    return 2;
+  }
+
+  cout << "CODA " << opt.coda << ", " << opt.nslot << " modules per type, "
+       << "occupancy " << opt.occ << ", block level " << opt.nblock << endl;
+  cout << left << setw(12) << "Test" << right
+       << setw(12) << "Events"
+       << setw(12) << "Time (s)"
+       << setw(14) << "Events/s"
+       << setw(10) << "MB/s"
+       << setw(10) << "Ref" << endl;
+
+  ofstream ofs;
+  if( !opt.outfile.empty() ) {
+    ofs.open(opt.outfile.c_str());
+    ofs << "# decbench -c " << opt.coda << " -o " << opt.occ
+	<< " -s " << opt.nslot << " -b " << opt.nblock << endl
+	<< "# test events events/s bytes/s" << endl;
+  }
+
+  Int_t nfail = 0;
+  for( size_t k = 0; k < tests.size(); ++k ) {
+    const string& name = tests[k];
+    vector<const ModType_t*> types;
+    for( const ModType_t* m = gModTypes; m->name; ++m ) {
+      if( name == m->name || (name == "mixed" && !m->blocked) )
+	types.push_back(m);
+    }
+    if( types.empty() ) {
+      cerr << "Unknown test " << name << endl;
+      ++nfail;
+      continue;
+    }
+    Result_t res;
+    Int_t nbad = RunTest( name, types, opt, cratemap, res );
+    cout << left << setw(12) << name << right
+	 << setw(12) << res.nev
+	 << setw(12) << fixed << setprecision(3) << res.time
+	 << setw(14) << setprecision(0) << res.EvRate()
+	 << setw(10) << setprecision(1) << 1e-6*res.ByteRate();
+    map<string,RefResult_t>::const_iterator ir = ref.find(name);
+    if( ir != ref.end() && ir->second.evrate > 0 ) {
+      Double_t rel = 100.*(res.EvRate()/ir->second.evrate - 1.);
+      cout << setw(9) << showpos << rel << noshowpos << "%";
+      if( rel < -opt.tolerance ) {
+	cout << "  SLOWER";
+	++nfail;
+      }
+    }
+    if( nbad > 0 ) {
+      cout << "  " << nbad << " BAD EVENTS";
+      ++nfail;
+    }
+    cout << endl;
+    if( ofs.is_open() )
+      ofs << name << " " << res.nev << " " << setprecision(0)
+	  << res.EvRate() << " " << res.ByteRate() << endl;
+  }
+
+  gSystem->Unlink(cratemap);
+  return nfail > 0 ? 1 : 0;
+}
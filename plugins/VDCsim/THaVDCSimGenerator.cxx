@@ -0,0 +1,315 @@
+// THaVDCSimGenerator.cxx
+//
+// Reentrant generator for simulated VDC events.
+//
+// The geometry, drift time and TDC digitization follow vdcsimgen. All state
+// needed for generating an event is set up in Init(); Generate() is const
+// and takes the random number generator as an argument, so one generator
+// object can be used by several threads, each with its own TRandom.
+//
+// Events are generated into lightweight Event structures. Export() converts
+// an Event into a THaVDCSimEvent for writing to the tree read by
+// THaVDCSimRun.
+//
+// Differences to vdcsimgen:
+//  - the number of tracks in addition to the trigger track is drawn from
+//    a Poisson distribution (or fixed), instead of chaining coincidence
+//    probabilities
+//  - noise hits are generated once per plane and event (not per track) and
+//    are not attached to any track
+//
+
+#include "THaVDCSimGenerator.h"
+#include "THaVDCSim.h"
+#include "TRandom.h"
+#include "TMath.h"
+#include <cmath>
+
+using namespace std;
+
+// Wire coordinate offsets (m), i.e. the u (v) position of wire #0.
+// The Hall A VDC wires count backwards, so the wire spacing is negative.
+static const Double_t kWireOffset[4] = { 0.77852, 0.77852, 1.02718, 1.02718 };
+
+// Polynomial coefficients used in time-to-distance conversion
+static const Double_t kA1tdcCor[4] = { 2.12e-3, 0.0, 0.0, 0.0 };
+static const Double_t kA2tdcCor[4] = { -4.20e-4, 1.3e-3, 1.06e-4, 0.0 };
+
+//______________________________________________________________________________
+THaVDCSimGenerator::THaVDCSimGenerator()
+  : fIsInit(kFALSE), fMeanExtra(-1.0), fFixedExtra(kFALSE), fNumWires(0),
+    fNoiseSigma(0), fNoiseMean(0), fWireEff(1), fTdcTimeLimit(0),
+    fEmissionRate(0), fProbWireNoise(0), fX1(0), fX2(0), fYmean(0),
+    fYsigma(0), fZ0(0), fPthetaMean(0), fPthetaSigma(0), fPphiMean(0),
+    fPphiSigma(0), fPmag0(0), fTdcConvertFactor(0), fCellWidth(0),
+    fCellHeight(0)
+{
+  // Constructor
+
+  for( Int_t j = 0; j < 4; j++ )
+    fWireHeight[j] = fDriftVel[j] = 0;
+}
+
+//______________________________________________________________________________
+Int_t THaVDCSimGenerator::Init( THaVDCSimConditions& s )
+{
+  // Set up the generator for the given conditions. Reads the drift
+  // velocities and TDC offsets from s.databaseFile. Returns 0 on success.
+
+  fIsInit = kFALSE;
+
+  // Define the z-positions of the wire planes
+  s.set(s.wireHeight, 0.0, 0.026, 0.3348, 0.3609);
+
+  s.Prefixes[0] = "L.vdc.u1";
+  s.Prefixes[1] = "L.vdc.v1";
+  s.Prefixes[2] = "L.vdc.u2";
+  s.Prefixes[3] = "L.vdc.v2";
+
+  if( s.numWires <= 0 )
+    return 1;
+  fTimeOffsets.assign( 4*s.numWires, 0.0 );
+  if( s.ReadDatabase(&fTimeOffsets[0]) != 0 )
+    return 1;
+
+  fNumWires         = s.numWires;
+  for( Int_t j = 0; j < 4; j++ ) {
+    fWireHeight[j]  = s.wireHeight[j];
+    fDriftVel[j]    = s.driftVelocities[j];
+  }
+  fNoiseSigma       = s.noiseSigma;
+  fNoiseMean        = s.noiseMean;
+  fWireEff          = s.wireEff;
+  fTdcTimeLimit     = s.tdcTimeLimit;
+  fEmissionRate     = s.emissionRate;
+  fProbWireNoise    = s.probWireNoise;
+  fX1               = s.x1;
+  fX2               = s.x2;
+  fYmean            = s.ymean;
+  fYsigma           = s.ysigma;
+  fZ0               = s.z0;
+  fPthetaMean       = s.pthetamean;
+  fPthetaSigma      = s.pthetasigma;
+  fPphiMean         = s.pphimean;
+  fPphiSigma        = s.pphisigma;
+  fPmag0            = s.pmag0;
+  fTdcConvertFactor = s.tdcConvertFactor;
+  fCellWidth        = s.cellWidth;
+  fCellHeight       = s.cellHeight;
+
+  fIsInit = kTRUE;
+  return 0;
+}
+
+//______________________________________________________________________________
+void THaVDCSimGenerator::MakeTrack( Event& ev, Int_t type, TRandom& rnd ) const
+{
+  // Generate a track of the given type and its wire hits, and append
+  // them to 'ev'. The VDC is assumed horizontal in the lab, with the wire
+  // planes rotated by +/- 45 degrees.
+
+  ev.tracks.push_back( Track() );
+  Track& tr = ev.tracks.back();
+  Int_t itrk = static_cast<Int_t>(ev.tracks.size()) - 1;
+  tr.type = type;
+  tr.num  = itrk;
+  for( Int_t j = 0; j < 4; j++ )
+    tr.slope[j] = tr.xover[j] = 0.0;
+  for( Int_t j = 0; j < 5; j++ )
+    tr.ray[j] = 0.0;
+
+  tr.origin[0] = rnd.Rndm()*(fX2-fX1) + fX1;
+  tr.origin[1] = rnd.Gaus(fYmean, fYsigma);
+  tr.origin[2] = fZ0;
+  Double_t theta = rnd.Gaus(fPthetaMean, fPthetaSigma);
+  Double_t phi   = rnd.Gaus(fPphiMean, fPphiSigma);
+  tr.momentum[0] = fPmag0 * TMath::Sin(theta) * TMath::Cos(phi);
+  tr.momentum[1] = fPmag0 * TMath::Sin(theta) * TMath::Sin(phi);
+  tr.momentum[2] = fPmag0 * TMath::Cos(theta);
+  tr.timeOffset = (type == 0) ? 0.0 : rnd.Rndm()*fTdcTimeLimit;
+
+  // Track parallel to the wire planes
+  if( TMath::Abs(tr.momentum[2]) < 1e-5 )
+    return;
+
+  const Double_t sqrt2 = TMath::Sqrt(2.0);
+  tr.ray[2] = tr.momentum[0]/tr.momentum[2];
+  tr.ray[3] = tr.momentum[1]/tr.momentum[2];
+
+  for( Int_t j = 0; j < 4; j++ ) {
+    // Intersection with wire plane j
+    Double_t len = (fWireHeight[j]-tr.origin[2])/tr.momentum[2];
+    Double_t px  = tr.origin[0] + len*tr.momentum[0];
+    Double_t py  = tr.origin[1] + len*tr.momentum[1];
+    if( j == 0 ) {
+      tr.ray[0] = px;
+      tr.ray[1] = py;
+    }
+
+    // Angle between the u(v)-axis and the projection of the track into
+    // the u(v)-z plane, and position along u(v)
+    Double_t tanThetaPrime, u;
+    if( j%2 == 0 ) {
+      tanThetaPrime = sqrt2/(tr.ray[2] - tr.ray[3]);
+      u = (px - py)/sqrt2;
+    } else {
+      tanThetaPrime = sqrt2/(tr.ray[2] + tr.ray[3]);
+      u = (px + py)/sqrt2;
+    }
+    tr.slope[j] = 1.0/tanThetaPrime;
+    tr.xover[j] = u;
+
+    // Range of wires hit, rounded to the nearest wire
+    Double_t spacing = -fCellWidth;
+    Double_t x = (u - kWireOffset[j])/spacing;
+    Double_t halfw = fCellHeight/2.0/tanThetaPrime/TMath::Abs(spacing);
+    Int_t wirehitFirst = static_cast<Int_t>(x - halfw + 0.5);
+    Int_t wirehitLast  = static_cast<Int_t>(x + halfw + 0.5);
+
+    // Parameters for time-to-distance conversion
+    Double_t a1 = 0.0, a2 = 0.0;
+    for( Int_t i = 3; i >= 1; i-- ) {
+      a1 = tanThetaPrime * (a1 + kA1tdcCor[i]);
+      a2 = tanThetaPrime * (a2 + kA2tdcCor[i]);
+    }
+    a1 += kA1tdcCor[0];
+    a2 += kA2tdcCor[0];
+
+    for( Int_t k = wirehitFirst; k <= wirehitLast; k++ ) {
+      if( k < 0 || k >= fNumWires )
+	continue;
+      Hit hit;
+      hit.plane   = j;
+      hit.wirenum = k;
+      hit.type    = 0;
+      hit.track   = itrk;
+      hit.pos     = kWireOffset[j] + k*spacing;
+
+      // Perpendicular distance from the wire to the track
+      Double_t d0 = TMath::Abs((x - k)*spacing)*tanThetaPrime;
+      hit.distance = d0;
+
+      // Inversion of THaVDCAnalyticTTDConv::ConvertTimeToDist
+      if( d0 > a1 + a2 )
+	d0 -= a2;
+      else
+	d0 /= (1+a2/a1);
+      hit.rawTime = d0/fDriftVel[j];
+
+      hit.rawTDCtime =
+	static_cast<Int_t>( fTimeOffsets[k+j*fNumWires] -
+			    fTdcConvertFactor*(hit.rawTime + tr.timeOffset) );
+      hit.time =
+	static_cast<Int_t>( hit.rawTDCtime +
+			    fTdcConvertFactor*rnd.Gaus(fNoiseMean, fNoiseSigma) );
+      if( hit.time < 0 )
+	continue;
+      if( rnd.Rndm() > fWireEff )
+	continue;
+
+      ev.hits.push_back(hit);
+    }
+  }
+}
+
+//______________________________________________________________________________
+void THaVDCSimGenerator::MakeNoise( Event& ev, Int_t plane, TRandom& rnd ) const
+{
+  // Fire random wires in the given plane with probability fProbWireNoise
+  // each. The gaps between fired wires are drawn from the geometric
+  // distribution, so the cost is proportional to the number of noise hits.
+
+  if( fProbWireNoise <= 0.0 )
+    return;
+  Double_t lq = (fProbWireNoise < 1.0) ? TMath::Log(1.0-fProbWireNoise) : 0;
+  Int_t n = -1;
+  while( true ) {
+    if( lq < 0 )
+      n += 1 + static_cast<Int_t>( TMath::Log(rnd.Rndm())/lq );
+    else
+      ++n;
+    if( n >= fNumWires )
+      break;
+    Hit hit;
+    hit.plane      = plane;
+    hit.wirenum    = n;
+    hit.type       = 1;
+    hit.track      = -1;
+    hit.rawTDCtime = 0;
+    hit.time       = static_cast<Int_t>(rnd.Rndm()*fTdcTimeLimit);
+    hit.rawTime    = 0.0;
+    hit.distance   = 0.0;
+    hit.pos        = kWireOffset[plane] - n*fCellWidth;
+    ev.hits.push_back(hit);
+  }
+}
+
+//______________________________________________________________________________
+void THaVDCSimGenerator::Generate( Event& ev, TRandom& rnd ) const
+{
+  // Generate one event: the trigger track, any extra tracks and noise.
+  // ev.event_num is left unchanged.
+
+  ev.Clear();
+  if( !fIsInit )
+    return;
+
+  MakeTrack( ev, 0, rnd );
+
+  Int_t nextra;
+  if( fFixedExtra )
+    nextra = TMath::Nint(fMeanExtra);
+  else {
+    Double_t mean = (fMeanExtra >= 0) ? fMeanExtra
+      : fEmissionRate*fTdcTimeLimit;
+    nextra = (mean > 0) ? rnd.Poisson(mean) : 0;
+  }
+  for( Int_t i = 0; i < nextra; i++ )
+    MakeTrack( ev, (i == 0) ? 1 : 2, rnd );
+
+  for( Int_t j = 0; j < 4; j++ )
+    MakeNoise( ev, j, rnd );
+}
+
+//______________________________________________________________________________
+void THaVDCSimGenerator::Export( const Event& ev, THaVDCSimEvent& out ) const
+{
+  // Fill 'out' with the tracks and hits of 'ev'. 'out' should have been
+  // cleared. The hits are owned by out.wirehits.
+
+  out.event_num = ev.event_num;
+
+  vector<THaVDCSimTrack*> tracks;
+  tracks.reserve( ev.tracks.size() );
+  for( vector<Track>::const_iterator it = ev.tracks.begin();
+       it != ev.tracks.end(); ++it ) {
+    THaVDCSimTrack* track = new THaVDCSimTrack(it->type, it->num);
+    track->origin.SetXYZ( it->origin[0], it->origin[1], it->origin[2] );
+    track->momentum.SetXYZ( it->momentum[0], it->momentum[1],
+			    it->momentum[2] );
+    for( Int_t j = 0; j < 5; j++ )
+      track->ray[j] = it->ray[j];
+    for( Int_t j = 0; j < 4; j++ ) {
+      track->slope[j] = it->slope[j];
+      track->xover[j] = it->xover[j];
+    }
+    track->timeOffset = it->timeOffset;
+    out.tracks.Add(track);
+    tracks.push_back(track);
+  }
+
+  for( vector<Hit>::const_iterator it = ev.hits.begin();
+       it != ev.hits.end(); ++it ) {
+    THaVDCSimWireHit* hit = new THaVDCSimWireHit;
+    hit->wirenum    = it->wirenum;
+    hit->type       = it->type;
+    hit->rawTime    = it->rawTime;
+    hit->rawTDCtime = it->rawTDCtime;
+    hit->time       = it->time;
+    hit->distance   = it->distance;
+    hit->pos        = it->pos;
+    out.wirehits[it->plane].Add(hit);
+    if( it->track >= 0 )
+      tracks[it->track]->hits[it->plane].Add(hit);
+  }
+}
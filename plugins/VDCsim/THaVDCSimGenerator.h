@@ -0,0 +1,82 @@
+// THaVDCSimGenerator.h
+//
+// Reentrant generator for simulated VDC events. Uses the same track and
+// digitization model as vdcsimgen, but works on plain data structures and
+// an explicit random number generator, so that several threads can
+// generate events with a shared (const) generator.
+//
+
+#ifndef Podd_THaVDCSimGenerator_h_
+#define Podd_THaVDCSimGenerator_h_
+
+#include "Rtypes.h"
+#include <vector>
+
+class TRandom;
+class THaVDCSimConditions;
+class THaVDCSimEvent;
+
+class THaVDCSimGenerator {
+ public:
+  THaVDCSimGenerator();
+
+  struct Hit {
+    Int_t    plane;      // Wire plane (u1,v1,u2,v2)
+    Int_t    wirenum;    // Wire number
+    Int_t    type;       // 0 = track hit, 1 = noise
+    Int_t    track;      // Index of track in event, -1 for noise
+    Int_t    rawTDCtime; // TDC time without noise
+    Int_t    time;       // TDC time with noise
+    Double_t rawTime;    // Drift time (ns)
+    Double_t distance;   // Drift distance (m)
+    Double_t pos;        // Wire position (m) along u(v)
+  };
+
+  struct Track {
+    Int_t    type;       // 0 = trigger, 1 = coincident, 2 = further tracks
+    Int_t    num;        // Track index
+    Double_t origin[3];
+    Double_t momentum[3];
+    Double_t ray[5];     // TRANSPORT coordinates on U1 plane
+    Double_t slope[4];   // Slope in each plane
+    Double_t xover[4];   // Cross-over coordinate in each plane
+    Double_t timeOffset; // Time offset wrt. trigger track (ns)
+  };
+
+  struct Event {
+    Int_t              event_num;
+    std::vector<Track> tracks;
+    std::vector<Hit>   hits;
+    void Clear() { tracks.clear(); hits.clear(); }
+  };
+
+  Int_t  Init( THaVDCSimConditions& s );
+  void   Generate( Event& ev, TRandom& rnd ) const;
+  void   Export( const Event& ev, THaVDCSimEvent& out ) const;
+
+  // Mean number of tracks in addition to the trigger track. If negative
+  // (default), the mean is given by the emission rate and TDC window.
+  void   SetExtraTracks( Double_t mean, Bool_t fixed = kFALSE )
+  { fMeanExtra = mean; fFixedExtra = fixed; }
+  Double_t GetExtraTracks() const { return fMeanExtra; }
+
+ protected:
+  Bool_t   fIsInit;
+  Double_t fMeanExtra;   // Mean number of extra tracks per event
+  Bool_t   fFixedExtra;  // Always generate round(fMeanExtra) extra tracks
+
+  // Copy of the simulation conditions
+  Int_t    fNumWires;
+  Double_t fWireHeight[4], fDriftVel[4];
+  Double_t fNoiseSigma, fNoiseMean, fWireEff, fTdcTimeLimit, fEmissionRate;
+  Double_t fProbWireNoise;
+  Double_t fX1, fX2, fYmean, fYsigma, fZ0;
+  Double_t fPthetaMean, fPthetaSigma, fPphiMean, fPphiSigma, fPmag0;
+  Double_t fTdcConvertFactor, fCellWidth, fCellHeight;
+  std::vector<Double_t> fTimeOffsets; // Per wire, all planes
+
+  void   MakeTrack( Event& ev, Int_t type, TRandom& rnd ) const;
+  void   MakeNoise( Event& ev, Int_t plane, TRandom& rnd ) const;
+};
+
+#endif
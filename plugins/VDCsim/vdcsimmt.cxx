@@ -0,0 +1,246 @@
+// Multi-threaded VDC event generator
+//
+// Generates simulated VDC events with THaVDCSimGenerator in several threads
+// and writes them in the format of vdcsimgen (tree "tree" with branch
+// "event" of THaVDCSimEvent, and the conditions as "s"), so that they
+// can be replayed with THaVDCSimRun and THaVDCSimDecoder.
+//
+// Events are generated in chunks. Each thread owns a random number
+// generator that is re-seeded from the global seed and the chunk number
+// at the start of each chunk, so the output does not depend on the number
+// of threads. While the threads generate the next set of chunks, the main
+// thread writes the previous set to the output file, in event order.
+//
+// UNITS: distances: m, times: ns, angles: tan angle
+
+#include "THaVDCSim.h"
+#include "THaVDCSimGenerator.h"
+
+#include "TROOT.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TThread.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+#include <unistd.h>
+
+using namespace std;
+
+typedef THaVDCSimGenerator::Event SimEvent_t;
+
+struct Chunk_t {
+  // Work unit for one thread
+  Chunk_t() : gen(0), rnd(0), first(0), nev(0), seed(0), chunk(0) {}
+  const THaVDCSimGenerator* gen;
+  TRandom*           rnd;     // Random generator owned by this thread slot
+  Long64_t           first;   // Event number of first event
+  Int_t              nev;     // Number of events to generate
+  UInt_t             seed;    // Global seed
+  Long64_t           chunk;   // Chunk number
+  vector<SimEvent_t> events;  // Output
+};
+
+//______________________________________________________________________________
+static UInt_t ChunkSeed( UInt_t seed, Long64_t chunk )
+{
+  // Seed for the given chunk. Mixes the global seed and the chunk number
+  // (splitmix64 finalizer) so that neighboring chunks get unrelated seeds.
+
+  ULong64_t z = (static_cast<ULong64_t>(seed) << 32) + chunk
+    + 0x9e3779b97f4a7c15ULL;
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  z ^= (z >> 31);
+  UInt_t s = static_cast<UInt_t>(z);
+  return s ? s : 1;   // 0 would ask TRandom3 for a time-based seed
+}
+
+//______________________________________________________________________________
+static void* GenerateChunk( void* arg )
+{
+  // Thread function: generate the events of one chunk
+
+  Chunk_t* c = static_cast<Chunk_t*>(arg);
+  c->rnd->SetSeed( ChunkSeed(c->seed, c->chunk) );
+  c->events.resize( c->nev );
+  for( Int_t i = 0; i < c->nev; i++ ) {
+    SimEvent_t& ev = c->events[i];
+    ev.event_num = static_cast<Int_t>(c->first + i);
+    c->gen->Generate( ev, *c->rnd );
+  }
+  return 0;
+}
+
+//______________________________________________________________________________
+static void usage()
+{
+  puts("Usage: vdcsimmt [options]");
+  puts(" -s <Output File Name> Default is 'vdctracks.root'");
+  puts(" -x Do not write any output (generation speed test)");
+  puts(" -a <Number of events> Default is 10,000");
+  puts(" -d <Database file name> Default is $DB_DIR/20030415/db_L.vdc.dat");
+  puts(" -n <Noise> Chamber drift time resolution (ns) (sigma). Default is 4.5");
+  puts(" -e <Wire Efficiency> (In decimal form). Default is 1.0");
+  puts(" -r <emission rate> Target's Emission Rate (IN kHz). Default is 2 kHz");
+  puts(" -m <tracks> Mean number of tracks in addition to the trigger track.");
+  puts("    Default is given by the emission rate and TDC window");
+  puts(" -f Generate exactly -m extra tracks in every event");
+  puts(" -c <Chamber Noise> Probability of random wires firing within the chamber. Default is 0.0");
+  puts(" -t <tdc time window> Length of time the TDCs can collect data (in ns). Default is 900");
+  puts(" -j <threads> Number of generator threads. Default is the number of CPUs");
+  puts(" -k <events> Events per chunk. Default is 1000");
+  puts(" -S <seed> Random seed. Default is 4357");
+  exit(1);
+}
+
+//______________________________________________________________________________
+int main( int argc, char* argv[] )
+{
+  THaVDCSimConditions* s = new THaVDCSimConditions;
+  THaVDCSimGenerator gen;
+  Bool_t do_write = kTRUE;
+  Int_t nthreads = static_cast<Int_t>(sysconf(_SC_NPROCESSORS_ONLN));
+  Int_t chunksize = 1000;
+  UInt_t seed = 4357;
+  Double_t mean_extra = -1.0;
+  Bool_t fixed_extra = kFALSE;
+
+  int opt;
+  while( (opt = getopt(argc, argv, "s:xa:d:n:e:r:m:fc:t:j:k:S:h")) != -1 ) {
+    switch( opt ) {
+    case 's': s->filename = optarg; break;
+    case 'x': do_write = kFALSE; break;
+    case 'a': s->numTrials = atoi(optarg); break;
+    case 'd': s->databaseFile = optarg; break;
+    case 'n': s->noiseSigma = atof(optarg); break;
+    case 'e': s->wireEff = atof(optarg); break;
+    case 'r': s->emissionRate = atof(optarg)/1000000.0; break;  // kHz -> 1/ns
+    case 'm': mean_extra = atof(optarg); break;
+    case 'f': fixed_extra = kTRUE; break;
+    case 'c': s->probWireNoise = atof(optarg); break;
+    case 't': s->tdcTimeLimit = atof(optarg); break;
+    case 'j': nthreads = atoi(optarg); break;
+    case 'k': chunksize = atoi(optarg); break;
+    case 'S': seed = strtoul(optarg, 0, 0); break;
+    default:  usage();
+    }
+  }
+  if( s->numTrials < 0 || s->noiseSigma < 0 || s->wireEff > 1.0 ||
+      s->emissionRate < 0 || s->probWireNoise < 0 || s->probWireNoise > 1.0 ||
+      s->tdcTimeLimit < 0 || (fixed_extra && mean_extra < 0) ||
+      chunksize <= 0 )
+    usage();
+  if( nthreads < 1 )
+    nthreads = 1;
+
+  TROOT vdcsimmt("vdcsimmt", "Multi-threaded VDC simulation");
+  TThread::Initialize();
+
+  if( gen.Init(*s) != 0 ) {
+    cout << "Error Reading Database file: " << s->databaseFile << endl;
+    return 1;
+  }
+  gen.SetExtraTracks( mean_extra, fixed_extra );
+
+  TFile* hfile = 0;
+  TTree* tree = 0;
+  THaVDCSimEvent* event = new THaVDCSimEvent;
+  if( do_write ) {
+    hfile = new TFile(s->filename, "RECREATE", "ROOT file for VDC simulation");
+    if( !hfile || hfile->IsZombie() ) {
+      cout << "Error opening output file: " << s->filename << endl;
+      return 1;
+    }
+    tree = new TTree("tree", "VDC Track info");
+    tree->Branch("event", "THaVDCSimEvent", &event);
+  }
+
+  // Two sets of chunks: one being generated, one being written
+  vector<TRandom3> rnd(nthreads);
+  vector<Chunk_t> chunks[2];
+  for( Int_t k = 0; k < 2; k++ ) {
+    chunks[k].resize(nthreads);
+    for( Int_t i = 0; i < nthreads; i++ ) {
+      chunks[k][i].gen  = &gen;
+      chunks[k][i].rnd  = &rnd[i];
+      chunks[k][i].seed = seed;
+    }
+  }
+  vector<TThread*> threads(nthreads, static_cast<TThread*>(0));
+
+  Long64_t ntotal = s->numTrials, nstarted = 0, nwritten = 0;
+  Long64_t nchunk = 0, ntracks = 0, nhits = 0;
+  TStopwatch timer;
+  timer.Start();
+  Int_t cur = 0;
+  Bool_t have_prev = kFALSE;
+  while( nstarted < ntotal || have_prev ) {
+    // Start generating the next set of chunks
+    Int_t nrun = 0;
+    for( Int_t i = 0; i < nthreads && nstarted < ntotal; i++ ) {
+      Chunk_t& c = chunks[cur][i];
+      c.chunk = nchunk++;
+      c.first = nstarted + 1;
+      c.nev   = static_cast<Int_t>( (ntotal-nstarted < chunksize) ?
+				     ntotal-nstarted : chunksize );
+      nstarted += c.nev;
+      threads[i] = new TThread( GenerateChunk, &c );
+      threads[i]->Run();
+      nrun++;
+    }
+    // Meanwhile, write out the previous set
+    if( have_prev ) {
+      vector<Chunk_t>& prev = chunks[1-cur];
+      for( Int_t i = 0; i < nthreads; i++ ) {
+	Chunk_t& c = prev[i];
+	for( Int_t j = 0; j < c.nev; j++ ) {
+	  const SimEvent_t& ev = c.events[j];
+	  ntracks += ev.tracks.size();
+	  nhits   += ev.hits.size();
+	  if( do_write ) {
+	    gen.Export( ev, *event );
+	    tree->Fill();
+	    event->Clear();
+	  }
+	}
+	nwritten += c.nev;
+	c.nev = 0;
+      }
+    }
+    for( Int_t i = 0; i < nrun; i++ ) {
+      threads[i]->Join();
+      delete threads[i];
+      threads[i] = 0;
+    }
+    have_prev = (nrun > 0);
+    cur = 1-cur;
+  }
+  timer.Stop();
+
+  if( do_write ) {
+    tree->Write();
+    s->Write("s");
+    hfile->Close();
+    delete hfile;
+  }
+  delete event;
+
+  Double_t t = timer.RealTime();
+  cout << "Generated " << nwritten << " events with " << nthreads
+       << " threads in " << t << " s";
+  if( t > 0 )
+    cout << " (" << nwritten/t << " events/s)";
+  cout << endl;
+  if( nwritten > 0 )
+    cout << "Mean tracks/event = " << static_cast<Double_t>(ntracks)/nwritten
+	 << ", mean hits/event = " << static_cast<Double_t>(nhits)/nwritten
+	 << endl;
+
+  delete s;
+  return 0;
+}
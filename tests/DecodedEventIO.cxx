@@ -0,0 +1,344 @@
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DecodedEventIO - Test writing and reading back files of decoded events,   //
+// including files written on a host of different endianness, and encoding   //
+// and replaying the decoded data of an event                                //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "DecodedEventIO.h"
+#include "DecodedEventFile.h"
+#include "DecodedEventDecoder.h"
+#include "THaSlotData.h"
+#include "Module.h"
+#include "TSystem.h"
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+
+using namespace std;
+using namespace Decoder;
+
+static const char kEpicsText[] = "hac_bcm_average 2.5\nIPM1H04A.XPOS -0.3\n";
+
+namespace Podd {
+namespace Tests {
+
+//_____________________________________________________________________________
+static UInt_t Swapped( UInt_t w )
+{
+  return (w>>24) | ((w>>8)&0xff00) | ((w<<8)&0xff0000) | (w<<24);
+}
+
+//_____________________________________________________________________________
+DecodedEventIO::DecodedEventIO( const char* name, const char* description ) :
+  UnitTest(name,description), fFileName("decoded_event_io_test.dat"),
+  fCrateMapName("./decoded_event_io_cratemap.dat")
+{
+  // Constructor
+}
+
+//_____________________________________________________________________________
+DecodedEventIO::~DecodedEventIO()
+{
+  // Destructor. Remove scratch files.
+
+  gSystem->Unlink( fFileName );
+  gSystem->Unlink( fCrateMapName );
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventIO::ReadDatabase( const TDatime& date )
+{
+  // No parameters
+
+  return kOK;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventIO::WriteFile( const vector< vector<UInt_t> >& records,
+				 Bool_t reverse )
+{
+  // Write 'records' to the scratch file. If 'reverse' is set, write the
+  // file as a host of opposite endianness would have written it: all
+  // words of the header and of decoded records are byte-reversed, as are
+  // the bank headers of the (EPICS) CODA event, but not its string data.
+
+  const char* const here = "WriteFile";
+
+  if( !reverse ) {
+    DecodedEventFile f;
+    if( f.codaOpen(fFileName,"w") != CODA_OK )
+      return 1;
+    f.setCodaVersion(2);
+    for( vector< vector<UInt_t> >::size_type i = 0; i < records.size(); ++i ) {
+      if( f.codaWrite(&records[i][0]) != CODA_OK )
+	return 2;
+    }
+    return f.codaClose();
+  }
+
+  FILE* fi = fopen( fFileName.Data(), "wb" );
+  if( !fi ) {
+    Error( Here(here), "Cannot open %s", fFileName.Data() );
+    return 1;
+  }
+  UInt_t header[4] = { DecodedEventFile::kMagic,
+		       DecodedEventFile::kFormatVersion, 2, 0 };
+  for( Int_t i = 0; i < 4; ++i )
+    header[i] = Swapped(header[i]);
+  fwrite( header, sizeof(UInt_t), 4, fi );
+  for( vector< vector<UInt_t> >::size_type i = 0; i < records.size(); ++i ) {
+    vector<UInt_t> r = records[i];
+    // Decoded records: swap everything. EPICS event: swap the outer and
+    // inner bank headers (words 0-3), leave the characters alone.
+    bool decoded = (r[1] & 0xffff) == DecodedEventFile::kDecodedTag;
+    size_t nswap = decoded ? r.size() : 4;
+    for( size_t j = 0; j < nswap; ++j )
+      r[j] = Swapped(r[j]);
+    fwrite( &r[0], sizeof(UInt_t), r.size(), fi );
+  }
+  fclose(fi);
+  return 0;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventIO::CheckFile( const vector< vector<UInt_t> >& records,
+				 const char* label )
+{
+  // Read back the scratch file and compare with 'records'
+
+  const char* const here = "CheckFile";
+
+  DecodedEventFile f;
+  if( f.codaOpen(fFileName) != CODA_OK ) {
+    Error( Here(here), "%s: cannot open file", label );
+    return 1;
+  }
+  if( f.getCodaVersion() != 2 ) {
+    Error( Here(here), "%s: wrong CODA version %d", label,
+	   f.getCodaVersion() );
+    return 2;
+  }
+  for( vector< vector<UInt_t> >::size_type i = 0; i < records.size(); ++i ) {
+    if( f.codaRead() != CODA_OK ) {
+      Error( Here(here), "%s: error reading record %u", label,
+	     static_cast<UInt_t>(i) );
+      return 3;
+    }
+    const UInt_t* buf = f.getEvBuffer();
+    if( memcmp(buf, &records[i][0], records[i].size()*sizeof(UInt_t)) ) {
+      Error( Here(here), "%s: record %u differs from original", label,
+	     static_cast<UInt_t>(i) );
+      return 4;
+    }
+  }
+  if( f.codaRead() != CODA_EOF ) {
+    Error( Here(here), "%s: no end of file after last record", label );
+    return 5;
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventIO::CheckRoundTrip()
+{
+  // Fill the slot data of a decoder with hits and the data of an FADC250,
+  // encode them with DecodedEventDecoder::EncodeEvent, replay the record
+  // with a second decoder's LoadEvent and compare the results.
+
+  const char* const here = "CheckRoundTrip";
+
+  const Int_t kCrate = 1, kAdcSlot = 5, kFadcSlot = 10;
+  {
+    ofstream ofs( fCrateMapName.Data() );
+    ofs << "==== Crate " << kCrate << " type vme" << endl
+	<< kAdcSlot  << " 792" << endl
+	<< kFadcSlot << " 250" << endl;
+    if( !ofs ) {
+      Error( Here(here), "Cannot write crate map %s", fCrateMapName.Data() );
+      return 1;
+    }
+  }
+
+  // A record without slots sets up the crate map and slot data
+  UInt_t hdr[] = { 6, (1<<16)|DecodedEventFile::kDecodedTag, 7, 100,
+		   0x89abcdef, 0x01234567, 0 };
+
+  Podd::DecodedEventDecoder src, dst;
+  src.SetCrateMapName( fCrateMapName );
+  dst.SetCrateMapName( fCrateMapName );
+  if( src.LoadEvent(hdr) != THaEvData::HED_OK || src.GetNslots() != 2 ) {
+    Error( Here(here), "Cannot initialize decoder" );
+    return 2;
+  }
+
+  // Hits in the ADC slot, including several hits in one channel
+  THaSlotData* adc = src.GetSlotData(0);
+  if( adc->getSlot() != kAdcSlot )
+    adc = src.GetSlotData(1);
+  adc->loadData( 0, 1000, 0x1003e8 );
+  adc->loadData( 7, 12, 0x70000c );
+  adc->loadData( 7, 4095, 0x700fff );
+  adc->loadData( 31, 0, 0x1f00000 );
+
+  // FADC250 block with window raw data in channel 0 and pulse integral,
+  // time, pedestal and peak in channel 3
+  Module* fadc = src.GetModule( kCrate, kFadcSlot );
+  if( !fadc || !fadc->IsMultiFunction() ) {
+    Error( Here(here), "No FADC250 in crate %d slot %d", kCrate, kFadcSlot );
+    return 3;
+  }
+  const UInt_t kS = kFadcSlot<<22;
+  UInt_t fadcbuf[] = {
+    (1U<<31) | (0<<27)  | kS | (1<<18) | 1,        // Block header
+    (1U<<31) | (2<<27)  | kS | 1,                  // Event header
+    (1U<<31) | (3<<27)  | 0x123456,                // Trigger time
+    (1U<<31) | (4<<27)  | (0<<23) | 2,             // Window raw data
+    (0x100<<16) | 0x101,                           //  two samples
+    (1U<<31) | (7<<27)  | (3<<23) | 1234,          // Pulse integral
+    (1U<<31) | (8<<27)  | (3<<23) | (5<<6) | 7,    // Pulse time
+    (1U<<31) | (10<<27) | (3<<23) | (100<<12) | 800, // Pedestal and peak
+    (1U<<31) | (1<<27)  | kS | 9                   // Block trailer
+  };
+  THaSlotData* fadcdat = src.GetSlotData(0);
+  if( fadcdat == adc )
+    fadcdat = src.GetSlotData(1);
+  fadc->LoadSlot( fadcdat, fadcbuf, fadcbuf+sizeof(fadcbuf)/sizeof(fadcbuf[0]) );
+  if( fadc->GetNumEvents(kPulseIntegral,3) != 1 ||
+      fadc->GetNumEvents(kSampleADC,0) != 2 ) {
+    Error( Here(here), "FADC250 test data not decoded" );
+    return 4;
+  }
+
+  vector<UInt_t> record;
+  UInt_t len = Podd::DecodedEventDecoder::EncodeEvent( src, record );
+  if( len != record.size() || record[0]+1 != len ) {
+    Error( Here(here), "Bad record length %u", len );
+    return 5;
+  }
+  if( dst.LoadEvent(&record[0]) != THaEvData::HED_OK ) {
+    Error( Here(here), "Cannot replay record" );
+    return 6;
+  }
+  if( dst.GetEvNum() != src.GetEvNum() || dst.GetEvType() != src.GetEvType() ||
+      dst.GetEvLength() != src.GetEvLength() ||
+      dst.GetEvTime() != src.GetEvTime() ) {
+    Error( Here(here), "Event header differs after replay" );
+    return 7;
+  }
+
+  // Slot data: the same hits in the same order
+  if( dst.GetNslots() != src.GetNslots() ) {
+    Error( Here(here), "Number of slots differs after replay" );
+    return 8;
+  }
+  for( Int_t i = 0; i < src.GetNslots(); ++i ) {
+    const THaSlotData* a = src.GetSlotData(i);
+    const THaSlotData* b = dst.GetSlotData(i);
+    if( a->getCrate() != b->getCrate() || a->getSlot() != b->getSlot() ||
+	a->getNumChan() != b->getNumChan() ) {
+      Error( Here(here), "Slot %d/%d differs after replay",
+	     a->getCrate(), a->getSlot() );
+      return 9;
+    }
+    for( Int_t k = 0; k < a->getNumChan(); ++k ) {
+      Int_t chan = a->getNextChan(k);
+      Int_t nhits = a->getNumHits(chan);
+      bool ok = ( b->getNextChan(k) == chan && b->getNumHits(chan) == nhits );
+      for( Int_t hit = 0; ok && hit < nhits; ++hit ) {
+	ok = ( b->getData(chan,hit) == a->getData(chan,hit) &&
+	       b->getRawData(chan,hit) == a->getRawData(chan,hit) );
+      }
+      if( !ok ) {
+	Error( Here(here), "Hits in slot %d/%d channel %d differ after replay",
+	       a->getCrate(), a->getSlot(), chan );
+	return 10;
+      }
+    }
+  }
+
+  // FADC module data: every type and channel
+  Module* replayed = dst.GetModule( kCrate, kFadcSlot );
+  if( !replayed || replayed == fadc ||
+      replayed->GetNumChan() != fadc->GetNumChan() ) {
+    Error( Here(here), "No replayed FADC250 data" );
+    return 11;
+  }
+  for( Int_t type = 0; type <= kFineTime; ++type ) {
+    EModuleType mtype = static_cast<EModuleType>(type);
+    if( replayed->HasCapability(mtype) != fadc->HasCapability(mtype) ) {
+      Error( Here(here), "FADC250 capability %d differs after replay", type );
+      return 12;
+    }
+    for( Int_t chan = 0; chan < fadc->GetNumChan(); ++chan ) {
+      Int_t n = fadc->GetNumEvents(mtype,chan);
+      bool ok = ( replayed->GetNumEvents(mtype,chan) == n );
+      for( Int_t hit = 0; ok && hit < n; ++hit )
+	ok = ( replayed->GetData(mtype,chan,hit) == fadc->GetData(mtype,chan,hit) );
+      if( !ok ) {
+	Error( Here(here), "FADC250 data of type %d in channel %d differ "
+	       "after replay", type, chan );
+	return 13;
+      }
+    }
+  }
+  return 0;
+}
+
+//_____________________________________________________________________________
+Int_t DecodedEventIO::Test()
+{
+  // Run test. Write a decoded record and a CODA 2 EPICS event to a file,
+  // both in native and reversed byte order, and check that reading
+  // the file gives back the original records. Then check that decoded
+  // slot and module data survive encoding and replaying.
+
+  const char* const here = "Test";
+
+  if( !fIsInit ) {
+    Error( Here(here), "Not initialized. Call Init() first." );
+    return -1;
+  }
+
+  vector< vector<UInt_t> > records;
+
+  // Decoded record: all 32-bit words
+  UInt_t dec[] = { 0, (1<<16)|DecodedEventFile::kDecodedTag, 42, 100,
+		   0x89abcdef, 0x01234567, 1, (1<<16)|5, 0 };
+  dec[0] = sizeof(dec)/sizeof(dec[0]) - 1;
+  records.push_back( vector<UInt_t>(dec, dec+sizeof(dec)/sizeof(dec[0])) );
+
+  // EPICS event: bank of banks holding one bank of 8-bit characters
+  size_t nchar = sizeof(kEpicsText);
+  size_t ntext = (nchar+3)/4;
+  vector<UInt_t> epics( 4+ntext, 0 );
+  epics[0] = epics.size()-1;
+  epics[1] = (131<<16) | (0x10<<8) | 0xcc;
+  epics[2] = ntext+1;
+  epics[3] = (0<<16) | (0x03<<8) | 0;
+  memcpy( &epics[4], kEpicsText, nchar );
+  records.push_back( epics );
+
+  if( WriteFile(records,kFALSE) != 0 )
+    return 1;
+  if( Int_t ret = CheckFile(records,"native") )
+    return 10+ret;
+
+  if( WriteFile(records,kTRUE) != 0 )
+    return 2;
+  if( Int_t ret = CheckFile(records,"reversed") )
+    return 20+ret;
+
+  if( Int_t ret = CheckRoundTrip() )
+    return 30+ret;
+
+  return 0;
+}
+
+} // namespace Tests
+} // namespace Podd
+
+////////////////////////////////////////////////////////////////////////////////
+
+ClassImp(Podd::Tests::DecodedEventIO)
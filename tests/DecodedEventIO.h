@@ -0,0 +1,47 @@
+#ifndef Podd_Tests_DecodedEventIO_h_
+#define Podd_Tests_DecodedEventIO_h_
+
+///////////////////////////////////////////////////////////////////////////////
+//                                                                           //
+// DecodedEventIO unit test                                                  //
+//                                                                           //
+///////////////////////////////////////////////////////////////////////////////
+
+#include "UnitTest.h"
+#include "TString.h"
+#include <vector>
+
+namespace Podd {
+namespace Tests {
+
+class DecodedEventIO : public UnitTest {
+
+public:
+  DecodedEventIO( const char* name = "decoded_event_io",
+		  const char* description = "Decoded event file unit test" );
+  virtual ~DecodedEventIO();
+
+  virtual Int_t Test();
+
+protected:
+
+  TString fFileName;      // Scratch file
+  TString fCrateMapName;  // Scratch crate map for the decoder round trip
+
+  Int_t  WriteFile( const std::vector< std::vector<UInt_t> >& records,
+		    Bool_t reverse );
+  Int_t  CheckFile( const std::vector< std::vector<UInt_t> >& records,
+		    const char* label );
+  Int_t  CheckRoundTrip();
+
+  virtual Int_t  ReadDatabase( const TDatime& date );
+
+  ClassDef(DecodedEventIO,0)   // Decoded event file unit test
+};
+
+} // namespace Tests
+} // namespace Podd
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif